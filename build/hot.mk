@@ -11,12 +11,15 @@ HOT_SOURCES = \
 	$(SRC)/Terrain/RasterBuffer.cpp \
 	$(SRC)/Terrain/RasterMap.cpp \
 	$(SRC)/Terrain/HeightMatrix.cpp \
+	$(SRC)/Terrain/SlopeShading.cpp \
+	$(SRC)/FLARM/CollisionPredictor.cpp \
 	$(SRC)/Terrain/RasterRenderer.cpp \
 	$(SRC)/Terrain/RasterTile.cpp \
 	$(SRC)/Terrain/ScanLine.cpp \
 	$(SRC)/Terrain/Intersection.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Screen/Memory/Canvas.cpp \
+	$(SRC)/Screen/Memory/TileRasterizer.cpp \
 	$(ENGINE_SRC_DIR)/Waypoints/Waypoints.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/Airspaces.cpp \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleArea.cpp \
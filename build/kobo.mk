@@ -54,6 +54,7 @@ KOBO_POWER_OFF_SOURCES = \
 	$(SRC)/Hardware/DisplaySize.cpp \
 	$(SRC)/Screen/Layout.cpp \
 	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightDatabase.cpp \
 	$(SRC)/Renderer/FlightListRenderer.cpp \
 	$(SRC)/FlightInfo.cpp \
 	$(SRC)/Kobo/Model.cpp \
@@ -14,7 +14,7 @@ ICF ?= n
 # enable gcc/clang sanitizers?
 SANITIZE ?= n
 
-# show map renderer times?
+# enable the map frame profiler (FrameProfiler) at startup?
 STOP_WATCH ?= n
 ifeq ($(STOP_WATCH),y)
 TARGET_CPPFLAGS += -DSTOP_WATCH
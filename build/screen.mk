@@ -222,7 +222,8 @@ SCREEN_SOURCES += \
 	$(SCREEN_SRC_DIR)/Memory/RawBitmap.cpp \
 	$(SCREEN_SRC_DIR)/Memory/VirtualCanvas.cpp \
 	$(SCREEN_SRC_DIR)/Memory/SubCanvas.cpp \
-	$(SCREEN_SRC_DIR)/Memory/Canvas.cpp
+	$(SCREEN_SRC_DIR)/Memory/Canvas.cpp \
+	$(SCREEN_SRC_DIR)/Memory/TileRasterizer.cpp
 MEMORY_CANVAS_CPPFLAGS = -DUSE_MEMORY_CANVAS
 endif
 
@@ -87,7 +87,13 @@ TEST_NAMES = \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
-	TestDateTime TestRoughTime TestWrapClock \
+	TestDateTime TestRoughTime TestWrapClock TestLatencyHistogram \
+	TestFrameProfiler \
+	TestFrameScheduler \
+	TestBlackboardSection \
+	TestTrafficList \
+	TestCollisionPredictor \
+	TestLabelBlock \
 	TestMath \
 	TestMathTables \
 	TestAngle TestARange \
@@ -95,9 +101,11 @@ TEST_NAMES = \
 	TestValidity TestUTM TestProfile \
 	TestAllocatedGrid \
 	TestRadixTree TestGeoBounds TestGeoClip \
+	TestArrivalRaster \
 	TestLogger TestGRecord TestDriver TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
 	TestFlarmNet \
+	TestFlightDatabase \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
@@ -106,6 +114,7 @@ TEST_NAMES = \
 	TestTaskPoint \
 	TestTaskWaypoint \
 	TestTeamCode \
+	TestTrace \
 	TestZeroFinder \
 	TestAirspaceParser \
 	TestMETARParser \
@@ -122,8 +131,12 @@ TEST_NAMES = \
 	TestIGCFilenameFormatter \
 	TestLXNToIGC \
 	TestLeastSquares \
+	TestSlopeShading \
 	TestThermalBand
 
+ifeq ($(USE_MEMORY_CANVAS),y)
+TEST_NAMES += TestTileRasterizer
+endif
 
 TESTS = $(call name-to-bin,$(TEST_NAMES))
 
@@ -157,9 +170,10 @@ $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFE
 
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCFileReader.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestIGCParser.cpp
-TEST_IGC_PARSER_DEPENDS = MATH UTIL
+TEST_IGC_PARSER_DEPENDS = OS MATH UTIL
 $(eval $(call link-program,TestIGCParser,TEST_IGC_PARSER))
 
 TEST_BYTE_ORDER_SOURCES = \
@@ -183,6 +197,7 @@ TEST_METAR_PARSER_DEPENDS = MATH UTIL
 $(eval $(call link-program,TestMETARParser,TEST_METAR_PARSER))
 
 TEST_AIRSPACE_PARSER_SOURCES = \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
@@ -215,6 +230,62 @@ TEST_WRAP_CLOCK_SOURCES = \
 TEST_WRAP_CLOCK_DEPENDS = MATH TIME
 $(eval $(call link-program,TestWrapClock,TEST_WRAP_CLOCK))
 
+TEST_LATENCY_HISTOGRAM_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLatencyHistogram.cpp
+TEST_LATENCY_HISTOGRAM_DEPENDS = TIME
+$(eval $(call link-program,TestLatencyHistogram,TEST_LATENCY_HISTOGRAM))
+
+TEST_FRAME_PROFILER_SOURCES = \
+	$(SRC)/FrameProfiler.cpp \
+	$(SRC)/JSON/Writer.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFrameProfiler.cpp
+TEST_FRAME_PROFILER_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestFrameProfiler,TEST_FRAME_PROFILER))
+
+TEST_FRAME_SCHEDULER_SOURCES = \
+	$(SRC)/FrameScheduler.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFrameScheduler.cpp
+$(eval $(call link-program,TestFrameScheduler,TEST_FRAME_SCHEDULER))
+
+TEST_BLACKBOARD_SECTION_SOURCES = \
+	$(SRC)/Blackboard/BlackboardSection.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestBlackboardSection.cpp
+$(eval $(call link-program,TestBlackboardSection,TEST_BLACKBOARD_SECTION))
+
+TEST_TRAFFIC_LIST_SOURCES = \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficList.cpp
+TEST_TRAFFIC_LIST_DEPENDS = UTIL
+$(eval $(call link-program,TestTrafficList,TEST_TRAFFIC_LIST))
+
+TEST_COLLISION_PREDICTOR_SOURCES = \
+	$(SRC)/FLARM/CollisionPredictor.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestCollisionPredictor.cpp
+TEST_COLLISION_PREDICTOR_DEPENDS = MATH
+$(eval $(call link-program,TestCollisionPredictor,TEST_COLLISION_PREDICTOR))
+
+TEST_LABEL_BLOCK_SOURCES = \
+	$(SRC)/Renderer/LabelBlock.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLabelBlock.cpp
+TEST_LABEL_BLOCK_DEPENDS =
+$(eval $(call link-program,TestLabelBlock,TEST_LABEL_BLOCK))
+
+TEST_TILE_RASTERIZER_SOURCES = \
+	$(SRC)/Screen/Memory/TileRasterizer.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTileRasterizer.cpp
+TEST_TILE_RASTERIZER_CPPFLAGS = $(SCREEN_CPPFLAGS)
+TEST_TILE_RASTERIZER_DEPENDS = THREAD
+$(eval $(call link-program,TestTileRasterizer,TEST_TILE_RASTERIZER))
+
 TEST_PROFILE_SOURCES = \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/Profile/Profile.cpp \
@@ -394,6 +465,12 @@ TEST_GEO_BOUNDS_SOURCES = \
 TEST_GEO_BOUNDS_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoBounds,TEST_GEO_BOUNDS))
 
+TEST_ARRIVAL_RASTER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestArrivalRaster.cpp
+TEST_ARRIVAL_RASTER_DEPENDS = GEO MATH
+$(eval $(call link-program,TestArrivalRaster,TEST_ARRIVAL_RASTER))
+
 TEST_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
@@ -404,6 +481,15 @@ TEST_FLARM_NET_SOURCES = \
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_FLIGHT_DATABASE_SOURCES = \
+	$(SRC)/Logger/FlightDatabase.cpp \
+	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/FlightInfo.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlightDatabase.cpp
+TEST_FLIGHT_DATABASE_DEPENDS = IO OS TIME UTIL
+$(eval $(call link-program,TestFlightDatabase,TEST_FLIGHT_DATABASE))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
@@ -613,6 +699,7 @@ $(eval $(call link-program,TestRadixTree,TEST_RADIX_TREE))
 TEST_LOGGER_SOURCES = \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
+	$(SRC)/IGC/AsyncIGCWriter.cpp \
 	$(SRC)/IGC/IGCString.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -623,9 +710,10 @@ TEST_LOGGER_SOURCES = \
 	$(SRC)/Logger/MD5.cpp \
 	$(SRC)/Version.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLogger.cpp
-TEST_LOGGER_DEPENDS = IO OS GEO MATH UTIL
+TEST_LOGGER_DEPENDS = IO OS GEO MATH THREAD UTIL
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
 TEST_GRECORD_SOURCES = \
@@ -700,11 +788,12 @@ TEST_TRACE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(SRC)/Engine/Trace/Point.cpp \
 	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Computer/TraceComputer.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(TEST_SRC_DIR)/FakeTerrain.cpp \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/TestTrace.cpp 
-TEST_TRACE_DEPENDS = IO OS GEO MATH UTIL
+TEST_TRACE_DEPENDS = IO OS GEO MATH UTIL THREAD
 $(eval $(call link-program,TestTrace,TEST_TRACE))
 
 FLIGHT_TABLE_SOURCES = \
@@ -719,11 +808,22 @@ check: $(TESTS) | $(OUT)/test/dirstamp
 	@$(NQ)echo "  TEST    $(notdir $(patsubst %$(TARGET_EXEEXT),%,$^))"
 	$(Q)$(PERL) $(TEST_SRC_DIR)/testall.pl $(TESTS)
 
+# replay a flight with a task and airspace through the calculation
+# pipeline and fail if the throughput is far below what even a slow
+# debug build achieves
+BENCHMARK_REPLAY_MIN_RATE = 500
+
+benchmark-replay: $(call name-to-bin,BenchmarkReplay)
+	@$(NQ)echo "  BENCH   $(notdir $<)"
+	$(Q)$< --task=$(topdir)/test/data/apf-bug554.tsk \
+		--airspace=$(topdir)/test/data/airspace/openair.txt \
+		--min-rate=$(BENCHMARK_REPLAY_MIN_RATE) \
+		$(topdir)/test/data/apf-bug554.igc
+
 DEBUG_PROGRAM_NAMES = \
 	test_reach \
 	test_route \
 	test_troute \
-	TestTrace \
 	FlightTable \
 	RunTrace \
 	RunOLCAnalysis \
@@ -731,6 +831,9 @@ DEBUG_PROGRAM_NAMES = \
 	FlightPath \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkReplay \
+	BenchmarkSlopeShading \
+	BenchmarkCollisionPredictor \
 	DumpTextFile DumpTextZip DumpTextInflate WriteTextFile RunTextWriter \
 	DumpHexColor \
 	RunXMLParser \
@@ -792,6 +895,7 @@ DEBUG_PROGRAM_NAMES = \
 ifeq ($(TARGET),UNIX)
 DEBUG_PROGRAM_NAMES += \
 	AnalyseFlight \
+	BatchAnalyseFlights \
 	FeedFlyNetData
 endif
 
@@ -835,6 +939,7 @@ DEBUG_REPLAY_SOURCES = \
 	$(SRC)/Device/Util/NMEAReader.cpp \
 	$(SRC)/Device/Config.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCFileReader.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
@@ -897,6 +1002,24 @@ BENCHMARK_PROJECTION_DEPENDS = MATH
 BENCHMARK_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,BenchmarkProjection,BENCHMARK_PROJECTION))
 
+TEST_SLOPE_SHADING_SOURCES = \
+	$(SRC)/Terrain/SlopeShading.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSlopeShading.cpp
+$(eval $(call link-program,TestSlopeShading,TEST_SLOPE_SHADING))
+
+BENCHMARK_SLOPE_SHADING_SOURCES = \
+	$(SRC)/Terrain/SlopeShading.cpp \
+	$(TEST_SRC_DIR)/BenchmarkSlopeShading.cpp
+BENCHMARK_SLOPE_SHADING_DEPENDS = OS
+$(eval $(call link-program,BenchmarkSlopeShading,BENCHMARK_SLOPE_SHADING))
+
+BENCHMARK_COLLISION_PREDICTOR_SOURCES = \
+	$(SRC)/FLARM/CollisionPredictor.cpp \
+	$(TEST_SRC_DIR)/BenchmarkCollisionPredictor.cpp
+BENCHMARK_COLLISION_PREDICTOR_DEPENDS = MATH OS
+$(eval $(call link-program,BenchmarkCollisionPredictor,BENCHMARK_COLLISION_PREDICTOR))
+
 BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleSettings.cpp \
 	$(ENGINE_SRC_DIR)/Task/Shapes/FAITriangleArea.cpp \
@@ -1554,6 +1677,9 @@ RUN_FLIGHT_LOGGER_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Computer/CirclingComputer.cpp \
 	$(SRC)/Logger/FlightLogger.cpp \
+	$(SRC)/Logger/FlightDatabase.cpp \
+	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/FlightInfo.cpp \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/RunFlightLogger.cpp
 RUN_FLIGHT_LOGGER_LDADD = $(DEBUG_REPLAY_LDADD)
@@ -1696,11 +1822,95 @@ ANALYSE_FLIGHT_SOURCES = \
 	$(TEST_SRC_DIR)/ContestPrinting.cpp \
 	$(TEST_SRC_DIR)/FlightPhaseJSON.cpp \
 	$(TEST_SRC_DIR)/FlightPhaseDetector.cpp \
+	$(TEST_SRC_DIR)/FlightAnalysis.cpp \
 	$(TEST_SRC_DIR)/AnalyseFlight.cpp
 ANALYSE_FLIGHT_LDADD = $(DEBUG_REPLAY_LDADD)
 ANALYSE_FLIGHT_DEPENDS = CONTEST UTIL GEO MATH TIME
 $(eval $(call link-program,AnalyseFlight,ANALYSE_FLIGHT))
 
+BATCH_ANALYSE_FLIGHTS_SOURCES = \
+	$(filter-out $(TEST_SRC_DIR)/AnalyseFlight.cpp,$(ANALYSE_FLIGHT_SOURCES)) \
+	$(TEST_SRC_DIR)/BatchAnalyseFlights.cpp
+BATCH_ANALYSE_FLIGHTS_LDADD = $(DEBUG_REPLAY_LDADD)
+BATCH_ANALYSE_FLIGHTS_DEPENDS = CONTEST UTIL GEO MATH TIME OS THREAD
+$(eval $(call link-program,BatchAnalyseFlights,BATCH_ANALYSE_FLIGHTS))
+
+BENCHMARK_REPLAY_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Computer/Wind/CirclingWind.cpp \
+	$(SRC)/Computer/Wind/Store.cpp \
+	$(SRC)/Computer/Wind/MeasurementList.cpp \
+	$(SRC)/Computer/Wind/WindEKF.cpp \
+	$(SRC)/Computer/Wind/WindEKFGlue.cpp \
+	$(SRC)/Computer/ThermalLocator.cpp \
+	$(SRC)/Computer/ThermalBase.cpp \
+	$(SRC)/Computer/ThermalBandComputer.cpp \
+	$(SRC)/Computer/GlideRatioCalculator.cpp \
+	$(SRC)/Computer/AutoQNH.cpp \
+	$(SRC)/Computer/CirclingComputer.cpp \
+	$(SRC)/Computer/Wind/Computer.cpp \
+	$(SRC)/Computer/Wind/Settings.cpp \
+	$(SRC)/Computer/ContestComputer.cpp \
+	$(SRC)/Computer/TraceComputer.cpp \
+	$(SRC)/Computer/WarningComputer.cpp \
+	$(SRC)/Computer/LiftDatabaseComputer.cpp \
+	$(SRC)/Computer/AverageVarioComputer.cpp \
+	$(SRC)/Computer/GlideRatioComputer.cpp \
+	$(SRC)/Computer/GlideComputer.cpp \
+	$(SRC)/Computer/GlideComputerBlackboard.cpp \
+	$(SRC)/Computer/TaskComputer.cpp \
+	$(SRC)/Computer/RouteComputer.cpp \
+	$(SRC)/Computer/GlideComputerAirData.cpp \
+	$(SRC)/Computer/WaveComputer.cpp \
+	$(SRC)/Computer/StatsComputer.cpp \
+	$(SRC)/Computer/GlideComputerInterface.cpp \
+	$(SRC)/Computer/LogComputer.cpp \
+	$(SRC)/Computer/CuComputer.cpp \
+	$(SRC)/Computer/Settings.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/Engine/Navigation/TraceHistory.cpp \
+	$(SRC)/Task/TaskFile.cpp \
+	$(SRC)/Task/TaskFileXCSoar.cpp \
+	$(SRC)/Task/TaskFileSeeYou.cpp \
+	$(SRC)/Task/TaskFileIGC.cpp \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/Task/LoadFile.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/Writer.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkReplay.cpp
+BENCHMARK_REPLAY_LDADD = $(DEBUG_REPLAY_LDADD)
+BENCHMARK_REPLAY_DEPENDS = \
+	TERRAIN \
+	CONTEST TASK ROUTE GLIDE WAYPOINT AIRSPACE \
+	IO OS THREAD ZZIP UTIL GEO MATH TIME
+$(eval $(call link-program,BenchmarkReplay,BENCHMARK_REPLAY))
+
 FLIGHT_PATH_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/IGC/IGCParser.cpp \
@@ -1783,6 +1993,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/GeoBitmapRenderer.cpp \
 	$(SRC)/Renderer/TransparentRendererCache.cpp \
+	$(SRC)/Renderer/LayerCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
 	$(SRC)/Renderer/BackgroundRenderer.cpp \
 	$(SRC)/LocalPath.cpp \
@@ -1791,9 +2002,14 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Projection/CompareProjection.cpp \
 	$(SRC)/Weather/Rasp/RaspStore.cpp \
 	$(SRC)/Weather/Rasp/RaspCache.cpp \
+	$(SRC)/Weather/Rasp/RaspThread.cpp \
 	$(SRC)/Weather/Rasp/RaspRenderer.cpp \
 	$(SRC)/Weather/Rasp/RaspStyle.cpp \
 	$(SRC)/MapWindow/MapWindow.cpp \
+	$(SRC)/PipelineLatency.cpp \
+	$(SRC)/FrameProfiler.cpp \
+	$(SRC)/FrameScheduler.cpp \
+	$(SRC)/JSON/Writer.cpp \
 	$(SRC)/MapWindow/MapWindowBlackboard.cpp \
 	$(SRC)/MapWindow/MapWindowEvents.cpp \
 	$(SRC)/MapWindow/MapWindowGlideRange.cpp \
@@ -1816,6 +2032,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
+	$(SRC)/Renderer/AirspaceShapeCache.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
 	$(SRC)/Renderer/AirspaceLabelRenderer.cpp \
 	$(SRC)/Renderer/BestCruiseArrowRenderer.cpp \
@@ -2331,11 +2548,13 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/MapSettings.cpp \
 	$(SRC)/Blackboard/InterfaceBlackboard.cpp \
+	$(SRC)/Blackboard/BlackboardSection.cpp \
 	$(SRC)/Engine/Navigation/TraceHistory.cpp \
 	$(SRC)/Airspace/ActivePredicate.cpp \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
@@ -36,6 +36,11 @@ Copyright_License {
 #include "Profile/Profile.hpp"
 #include "UIState.hpp"
 #include "Operation/MessageOperationEnvironment.hpp"
+#include "Tracking/Features.hpp"
+
+#ifdef HAVE_SKYLINES_TRACKING
+#include "Tracking/TrackingGlue.hpp"
+#endif
 
 using namespace CommonInterface;
 
@@ -43,6 +48,36 @@ namespace ActionInterface {
   static void SendGetComputerSettings();
 }
 
+#ifdef HAVE_SKYLINES_TRACKING
+
+/**
+ * Mark the SkyLines blackboard section as changed if the SkyLines
+ * traffic has been modified since the last call.
+ */
+static void
+CheckSkyLinesData()
+{
+  static Serial last_serial;
+
+  if (tracking == nullptr)
+    return;
+
+  const auto &data = tracking->GetSkyLinesData();
+
+  Serial serial;
+  {
+    const ScopeLock protect(data.mutex);
+    serial = data.serial;
+  }
+
+  if (serial != last_serial) {
+    last_serial = serial;
+    MarkSkyLinesChanged();
+  }
+}
+
+#endif
+
 void
 XCSoarInterface::ReceiveGPS()
 {
@@ -56,6 +91,10 @@ XCSoarInterface::ReceiveGPS()
       real.MovementDetected();
   }
 
+#ifdef HAVE_SKYLINES_TRACKING
+  CheckSkyLinesData();
+#endif
+
   BroadcastGPSUpdate();
 
   if (!Basic().flarm.traffic.IsEmpty())
@@ -69,7 +108,7 @@ XCSoarInterface::ReceiveCalculated()
   {
     ScopeLock protect(device_blackboard->mutex);
 
-    ReadBlackboardCalculated(device_blackboard->Calculated());
+    ReadBlackboardCalculated(device_blackboard->GetCalculatedSnapshot());
     device_blackboard->ReadComputerSettings(GetComputerSettings());
   }
 
@@ -285,7 +324,9 @@ void
 ActionInterface::SendUIState()
 {
   /* force-update all InfoBoxes just in case the display mode has
-     changed */
+     changed; the InfoBoxes are not a blackboard listener, and they
+     are refreshed on every calculated update, regardless of which
+     BlackboardSection has changed */
   InfoBoxManager::SetDirty();
   InfoBoxManager::ProcessTimer();
 
@@ -0,0 +1,221 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspaceCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+
+#include <vector>
+
+#include <stdint.h>
+#include <string.h>
+
+struct AirspaceCacheHeader {
+  static constexpr unsigned VERSION = 1;
+
+  uint32_t version;
+  uint32_t n_airspaces;
+};
+
+struct AirspaceCacheRecord {
+  AbstractAirspace::Shape shape;
+  AirspaceClass type;
+  AirspaceActivity days;
+
+  uint16_t name_length, radio_length;
+
+  /**
+   * The number of polygon vertices (0 for circles).
+   */
+  uint32_t n_points;
+
+  AirspaceAltitude base, top;
+
+  /**
+   * Only used for circles.
+   */
+  GeoPoint center;
+  double radius;
+};
+
+static constexpr size_t MAX_STRING_LENGTH = 1024;
+static constexpr uint32_t MAX_POINTS = 1024 * 1024;
+
+static bool
+WriteString(const tstring &s, FILE *file)
+{
+  return fwrite(s.data(), sizeof(TCHAR), s.length(), file) == s.length();
+}
+
+static bool
+ReadString(tstring &s, size_t length, FILE *file)
+{
+  s.resize(length);
+  return fread(&s[0], sizeof(TCHAR), length, file) == length;
+}
+
+static bool
+SaveAirspace(const AbstractAirspace &airspace, FILE *file)
+{
+  const tstring name(airspace.GetName());
+  const tstring &radio = airspace.GetRadioText();
+  if (name.length() > MAX_STRING_LENGTH ||
+      radio.length() > MAX_STRING_LENGTH)
+    return false;
+
+  AirspaceCacheRecord record;
+
+  /* zero-fill all implicit padding bytes (to make valgrind happy) */
+  memset(&record, 0, sizeof(record));
+
+  record.shape = airspace.GetShape();
+  record.type = airspace.GetType();
+  record.days = airspace.GetDays();
+  record.name_length = name.length();
+  record.radio_length = radio.length();
+  record.base = airspace.GetBase();
+  record.top = airspace.GetTop();
+
+  const SearchPointVector &points = airspace.GetPoints();
+
+  switch (record.shape) {
+  case AbstractAirspace::Shape::CIRCLE: {
+    const AirspaceCircle &circle = (const AirspaceCircle &)airspace;
+    record.center = circle.GetReferenceLocation();
+    record.radius = circle.GetRadius();
+    break;
+  }
+
+  case AbstractAirspace::Shape::POLYGON:
+    record.n_points = points.size();
+    break;
+  }
+
+  if (fwrite(&record, sizeof(record), 1, file) != 1 ||
+      !WriteString(name, file) ||
+      !WriteString(radio, file))
+    return false;
+
+  for (unsigned i = 0; i < record.n_points; ++i) {
+    const GeoPoint &location = points[i].GetLocation();
+    if (fwrite(&location, sizeof(location), 1, file) != 1)
+      return false;
+  }
+
+  return true;
+}
+
+bool
+SaveAirspaceCache(const Airspaces &airspaces, FILE *file)
+{
+  AirspaceCacheHeader header;
+  header.version = AirspaceCacheHeader::VERSION;
+  header.n_airspaces = airspaces.GetSize();
+
+  if (fwrite(&header, sizeof(header), 1, file) != 1)
+    return false;
+
+  unsigned n = 0;
+  for (const auto &i : airspaces.QueryAll()) {
+    if (!SaveAirspace(i.GetAirspace(), file))
+      return false;
+
+    ++n;
+  }
+
+  return n == header.n_airspaces;
+}
+
+static AbstractAirspace *
+LoadAirspace(FILE *file, std::vector<GeoPoint> &points)
+{
+  AirspaceCacheRecord record;
+  if (fread(&record, sizeof(record), 1, file) != 1 ||
+      record.name_length > MAX_STRING_LENGTH ||
+      record.radio_length > MAX_STRING_LENGTH ||
+      record.type >= AIRSPACECLASSCOUNT)
+    return nullptr;
+
+  tstring name, radio;
+  if (!ReadString(name, record.name_length, file) ||
+      !ReadString(radio, record.radio_length, file))
+    return nullptr;
+
+  AbstractAirspace *airspace;
+
+  switch (record.shape) {
+  case AbstractAirspace::Shape::CIRCLE:
+    if (!record.center.IsValid() || record.radius <= 0)
+      return nullptr;
+
+    airspace = new AirspaceCircle(record.center, record.radius);
+    break;
+
+  case AbstractAirspace::Shape::POLYGON:
+    if (record.n_points < 3 || record.n_points > MAX_POINTS)
+      return nullptr;
+
+    points.resize(record.n_points);
+    if (fread(points.data(), sizeof(points.front()), points.size(),
+              file) != points.size())
+      return nullptr;
+
+    airspace = new AirspacePolygon(points);
+    break;
+
+  default:
+    return nullptr;
+  }
+
+  airspace->SetProperties(std::move(name), record.type,
+                          record.base, record.top);
+  airspace->SetRadio(radio);
+  airspace->SetDays(record.days);
+  return airspace;
+}
+
+bool
+LoadAirspaceCache(Airspaces &airspaces, FILE *file)
+{
+  AirspaceCacheHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      header.version != AirspaceCacheHeader::VERSION)
+    return false;
+
+  /* load into a temporary container first, so a truncated or corrupt
+     cache file does not leave half of its contents behind */
+  Airspaces tmp;
+  std::vector<GeoPoint> points;
+
+  for (unsigned i = 0; i < header.n_airspaces; ++i) {
+    AbstractAirspace *airspace = LoadAirspace(file, points);
+    if (airspace == nullptr)
+      return false;
+
+    tmp.Add(airspace);
+  }
+
+  airspaces.MoveFrom(tmp);
+  return true;
+}
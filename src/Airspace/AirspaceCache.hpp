@@ -0,0 +1,56 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_CACHE_HPP
+#define XCSOAR_AIRSPACE_CACHE_HPP
+
+#include <stdio.h>
+
+class Airspaces;
+
+/**
+ * Write all airspaces of the given container to a binary cache file.
+ * Airspaces::Optimise() must have been called before.
+ * Only the parsed source data (shape, class, name, radio, altitudes,
+ * days of operation) is stored; derived data such as the projected
+ * border and the rtree is rebuilt by Airspaces::Optimise().
+ *
+ * This must be called before Airspaces::SetGroundLevels() and
+ * Airspaces::SetFlightLevels(), because those modify the altitudes.
+ *
+ * @return true on success
+ */
+bool
+SaveAirspaceCache(const Airspaces &airspaces, FILE *file);
+
+/**
+ * Load airspaces from a binary cache file written by
+ * SaveAirspaceCache() and add them to the container.  On error,
+ * nothing is added.
+ *
+ * @return true on success
+ */
+bool
+LoadAirspaceCache(Airspaces &airspaces, FILE *file);
+
+#endif
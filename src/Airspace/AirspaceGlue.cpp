@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Airspace/AirspaceGlue.hpp"
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Profile/ProfileKeys.hpp"
 #include "Operation/Operation.hpp"
@@ -33,6 +34,7 @@ Copyright_License {
 #include "IO/ZipArchive.hpp"
 #include "IO/ZipLineReader.hpp"
 #include "IO/MapFile.hpp"
+#include "IO/FileCache.hpp"
 #include "Profile/Profile.hpp"
 
 #include <string.h>
@@ -74,8 +76,77 @@ try {
   return false;
 }
 
+static bool
+LoadAirspaceCache(Airspaces &airspaces, FileCache &cache,
+                  const TCHAR *name, Path path)
+{
+  bool success = false;
+
+  FILE *file = cache.Load(name, path);
+  if (file != nullptr) {
+    success = LoadAirspaceCache(airspaces, file);
+    fclose(file);
+  }
+
+  return success;
+}
+
+static bool
+SaveAirspaceCache(const Airspaces &airspaces, FileCache &cache,
+                  const TCHAR *name, Path path)
+{
+  bool success = false;
+
+  FILE *file = cache.Save(name, path);
+  if (file != nullptr) {
+    success = SaveAirspaceCache(airspaces, file);
+    if (success)
+      cache.Commit(name, file);
+    else
+      cache.Cancel(name, file);
+  }
+
+  return success;
+}
+
+/**
+ * Load one airspace source, preferably from the #FileCache.  On a
+ * cache miss, the source is parsed into a temporary container, which
+ * is then written to the cache and merged into #airspaces.
+ *
+ * @param path the file the cache entry is bound to
+ * @param parse a function which feeds the source into the given
+ * #AirspaceParser
+ */
+template<typename P>
+static bool
+LoadAirspaceSource(Airspaces &airspaces, FileCache *cache,
+                   const TCHAR *cache_name, Path path, P &&parse)
+{
+  if (cache == nullptr) {
+    AirspaceParser parser(airspaces);
+    return parse(parser);
+  }
+
+  if (LoadAirspaceCache(airspaces, *cache, cache_name, path))
+    return true;
+
+  Airspaces parsed;
+  AirspaceParser parser(parsed);
+  const bool success = parse(parser);
+  if (success) {
+    parsed.Optimise();
+    if (!SaveAirspaceCache(parsed, *cache, cache_name, path))
+      LogFormat(_T("Failed to save airspace cache: %s"), cache_name);
+  }
+
+  airspaces.MoveFrom(parsed);
+  return success;
+}
+
 void
 ReadAirspace(Airspaces &airspaces,
+             FileCache *cache,
              RasterTerrain *terrain,
              const AtmosphericPressure &press,
              OperationEnvironment &operation)
@@ -85,21 +156,38 @@ ReadAirspace(Airspaces &airspaces,
 
   bool airspace_ok = false;
 
-  AirspaceParser parser(airspaces);
-
   // Read the airspace filenames from the registry
   auto path = Profile::GetPath(ProfileKeys::AirspaceFile);
   if (!path.IsNull())
-    airspace_ok |= ParseAirspaceFile(parser, path, operation);
+    airspace_ok |= LoadAirspaceSource(airspaces, cache, _T("airspace"), path,
+                                      [&](AirspaceParser &parser){
+                                        return ParseAirspaceFile(parser, path,
+                                                                 operation);
+                                      });
 
   path = Profile::GetPath(ProfileKeys::AdditionalAirspaceFile);
   if (!path.IsNull())
-    airspace_ok |= ParseAirspaceFile(parser, path, operation);
+    airspace_ok |= LoadAirspaceSource(airspaces, cache, _T("airspace2"), path,
+                                      [&](AirspaceParser &parser){
+                                        return ParseAirspaceFile(parser, path,
+                                                                 operation);
+                                      });
 
   auto archive = OpenMapFile();
-  if (archive)
-    airspace_ok |= ParseAirspaceFile(parser, archive->get(), "airspace.txt",
-                                     operation);
+  if (archive) {
+    /* the map file's "airspace.txt" is cached, too, bound to the map
+       file itself */
+    path = Profile::GetPath(ProfileKeys::MapFile);
+    airspace_ok |= LoadAirspaceSource(airspaces,
+                                      path.IsNull() ? nullptr : cache,
+                                      _T("airspace_map"), path,
+                                      [&](AirspaceParser &parser){
+                                        return ParseAirspaceFile(parser,
+                                                                 archive->get(),
+                                                                 "airspace.txt",
+                                                                 operation);
+                                      });
+  }
 
   if (airspace_ok) {
     airspaces.Optimise();
@@ -25,15 +25,20 @@ Copyright_License {
 #define XCSOAR_AIRSPACE_GLUE_HPP
 
 class RasterTerrain;
+class FileCache;
 class AtmosphericPressure;
 class Airspaces;
 class OperationEnvironment;
 
 /**
  * Reads the airspace files into the memory
+ *
+ * @param cache an optional #FileCache which stores a binary copy of
+ * each parsed airspace file; may be nullptr
  */
 void
 ReadAirspace(Airspaces &airspaces,
+             FileCache *cache,
              RasterTerrain *terrain,
              const AtmosphericPressure &press,
              OperationEnvironment &operation);
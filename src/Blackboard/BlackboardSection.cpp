@@ -0,0 +1,99 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "BlackboardSection.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+
+#include <string.h>
+
+template<typename T>
+gcc_pure
+static bool
+Differs(const T &a, const T &b)
+{
+  return memcmp(&a, &b, sizeof(T)) != 0;
+}
+
+BlackboardMask
+CompareBasic(const MoreData &a, const MoreData &b)
+{
+  BlackboardMask mask = 0;
+
+  if (a.location_available != b.location_available ||
+      a.track_available != b.track_available ||
+      a.ground_speed_available != b.ground_speed_available ||
+      a.gps_altitude_available != b.gps_altitude_available ||
+      a.baro_altitude_available != b.baro_altitude_available ||
+      a.pressure_altitude_available != b.pressure_altitude_available ||
+      a.attitude.heading_available != b.attitude.heading_available)
+    mask |= ToMask(BlackboardSection::POSITION);
+
+  if (a.total_energy_vario_available != b.total_energy_vario_available ||
+      a.netto_vario_available != b.netto_vario_available ||
+      a.noncomp_vario_available != b.noncomp_vario_available ||
+      a.gps_vario_available != b.gps_vario_available ||
+      a.brutto_vario_available != b.brutto_vario_available)
+    mask |= ToMask(BlackboardSection::VARIO);
+
+  if (a.external_wind_available != b.external_wind_available)
+    mask |= ToMask(BlackboardSection::WIND);
+
+  /* traffic which expires is removed without updating the
+     "modified" attribute */
+  if (a.flarm.status.available != b.flarm.status.available ||
+      a.flarm.traffic.modified != b.flarm.traffic.modified ||
+      a.flarm.traffic.list.size() != b.flarm.traffic.list.size())
+    mask |= ToMask(BlackboardSection::TRAFFIC);
+
+  return mask;
+}
+
+BlackboardMask
+CompareCalculated(const DerivedInfo &a, const DerivedInfo &b)
+{
+  BlackboardMask mask = 0;
+
+  if (Differs<VarioInfo>(a, b) || Differs<ClimbInfo>(a, b))
+    mask |= ToMask(BlackboardSection::VARIO);
+
+  if (a.wind_available != b.wind_available ||
+      a.estimated_wind_available != b.estimated_wind_available ||
+      a.head_wind_available != b.head_wind_available ||
+      a.wind_source != b.wind_source)
+    mask |= ToMask(BlackboardSection::WIND);
+
+  if (Differs(a.task_stats, b.task_stats) ||
+      Differs(a.ordered_task_stats, b.ordered_task_stats) ||
+      Differs(a.common_stats, b.common_stats) ||
+      Differs(a.planned_route, b.planned_route))
+    mask |= ToMask(BlackboardSection::TASK);
+
+  if (Differs(a.contest_stats, b.contest_stats))
+    mask |= ToMask(BlackboardSection::CONTEST);
+
+  if (a.airspace_warnings.latest != b.airspace_warnings.latest)
+    mask |= ToMask(BlackboardSection::AIRSPACE_WARNINGS);
+
+  return mask;
+}
@@ -0,0 +1,147 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_BLACKBOARD_SECTION_HPP
+#define XCSOAR_BLACKBOARD_SECTION_HPP
+
+#include "Compiler.h"
+
+#include <stdint.h>
+
+struct MoreData;
+struct DerivedInfo;
+
+/**
+ * A part of #MoreData and #DerivedInfo whose modifications are
+ * tracked separately, to allow a #BlackboardListener to ignore
+ * updates it is not interested in.
+ */
+enum class BlackboardSection : uint8_t {
+  /**
+   * Location, track, heading, ground speed and altitude.
+   */
+  POSITION,
+
+  /**
+   * Vario values from the devices and the derived climb rates.
+   */
+  VARIO,
+
+  WIND,
+
+  /**
+   * FLARM status and traffic.
+   */
+  TRAFFIC,
+
+  /**
+   * Task statistics and the planned route.
+   */
+  TASK,
+
+  CONTEST,
+
+  AIRSPACE_WARNINGS,
+
+  /**
+   * SkyLines live tracking traffic.  This is not part of #MoreData;
+   * see SkyLinesTracking::Data::serial.
+   */
+  SKYLINES,
+
+  COUNT
+};
+
+/**
+ * A bit mask of #BlackboardSection values.
+ */
+typedef uint8_t BlackboardMask;
+
+static_assert(unsigned(BlackboardSection::COUNT) <= 8 * sizeof(BlackboardMask),
+              "BlackboardMask is too small");
+
+static constexpr inline BlackboardMask
+ToMask(BlackboardSection section)
+{
+  return BlackboardMask(1u << unsigned(section));
+}
+
+/**
+ * All sections.  A #BlackboardListener registered with this mask
+ * receives every update, including those where none of the tracked
+ * sections has changed.
+ */
+static constexpr BlackboardMask BLACKBOARD_ALL =
+  BlackboardMask((1u << unsigned(BlackboardSection::COUNT)) - 1);
+
+/**
+ * One counter per #BlackboardSection which is incremented each time
+ * the section changes.  Code which polls the blackboard can keep a
+ * copy and compare it with the current one.
+ */
+class BlackboardGenerations {
+  unsigned value[unsigned(BlackboardSection::COUNT)];
+
+public:
+  BlackboardGenerations():value() {}
+
+  unsigned Get(BlackboardSection section) const {
+    return value[unsigned(section)];
+  }
+
+  void Increment(BlackboardMask mask) {
+    for (unsigned i = 0; i < unsigned(BlackboardSection::COUNT); ++i)
+      if (mask & ToMask(BlackboardSection(i)))
+        ++value[i];
+  }
+
+  /**
+   * Returns the sections which differ from the other object.
+   */
+  gcc_pure
+  BlackboardMask Compare(const BlackboardGenerations &other) const {
+    BlackboardMask mask = 0;
+    for (unsigned i = 0; i < unsigned(BlackboardSection::COUNT); ++i)
+      if (value[i] != other.value[i])
+        mask |= ToMask(BlackboardSection(i));
+    return mask;
+  }
+};
+
+/**
+ * Determine which sections of #MoreData differ.
+ */
+gcc_pure
+BlackboardMask
+CompareBasic(const MoreData &a, const MoreData &b);
+
+/**
+ * Determine which sections of #DerivedInfo differ.  The objects are
+ * compared byte-wise, which may report a section as modified even
+ * though only padding differs, but never misses a modification.
+ */
+gcc_pure
+BlackboardMask
+CompareCalculated(const DerivedInfo &a, const DerivedInfo &b);
+
+#endif
@@ -0,0 +1,102 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CALCULATED_SNAPSHOT_HPP
+#define XCSOAR_CALCULATED_SNAPSHOT_HPP
+
+#include "NMEA/Derived.hpp"
+
+#include <memory>
+
+/**
+ * A reference counted copy of #DerivedInfo.  The CalculationThread
+ * publishes a new snapshot after each iteration, and all readers
+ * share it instead of copying the (large) #DerivedInfo object while
+ * holding the #DeviceBlackboard lock.
+ *
+ * The #DerivedInfo object is immutable while it is shared; Modify()
+ * duplicates it before the first modification (copy-on-write).
+ */
+class CalculatedSnapshot {
+  std::shared_ptr<DerivedInfo> info;
+
+  /**
+   * Incremented by each publication, see
+   * DeviceBlackboard::ReadBlackboard().  A reader may compare it
+   * with the sequence number it has seen last to find out whether
+   * anything has changed.
+   */
+  unsigned sequence = 0;
+
+public:
+  /**
+   * Construct a snapshot of a freshly reset #DerivedInfo.
+   */
+  CalculatedSnapshot()
+    :info(std::make_shared<DerivedInfo>()) {
+    info->Reset();
+  }
+
+  /**
+   * Construct a snapshot of the given #DerivedInfo.  This copies the
+   * object, and should therefore not be called while holding a lock.
+   */
+  explicit CalculatedSnapshot(const DerivedInfo &_info)
+    :info(std::make_shared<DerivedInfo>(_info)) {}
+
+  const DerivedInfo &operator*() const {
+    return *info;
+  }
+
+  const DerivedInfo *operator->() const {
+    return info.get();
+  }
+
+  /**
+   * Do both objects refer to the same #DerivedInfo?
+   */
+  bool IsSame(const CalculatedSnapshot &other) const {
+    return info == other.info;
+  }
+
+  unsigned GetSequence() const {
+    return sequence;
+  }
+
+  void SetSequence(unsigned _sequence) {
+    sequence = _sequence;
+  }
+
+  /**
+   * Obtain a writable reference to the #DerivedInfo.  If it is shared
+   * with another snapshot, it is duplicated first.
+   */
+  DerivedInfo &Modify() {
+    if (info.use_count() != 1)
+      info = std::make_shared<DerivedInfo>(*info);
+
+    return *info;
+  }
+};
+
+#endif
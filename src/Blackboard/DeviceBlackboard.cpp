@@ -35,9 +35,8 @@ Copyright_License {
 DeviceBlackboard::DeviceBlackboard()
   :devices(nullptr)
 {
-  // Clear the gps_info and calculated_info
+  // Clear the gps_info (the CalculatedSnapshot is already reset)
   gps_info.Reset();
-  calculated_info.Reset();
 
   // Set GPS assumed time to system time
   gps_info.UpdateClock();
@@ -173,15 +172,16 @@ DeviceBlackboard::SetAltitude(double val)
 }
 
 /**
- * Reads the given derived_info usually provided by the
- * GlideComputerBlackboard and saves it to the own Blackboard
- * @param derived_info Calculated information usually provided
+ * Replaces the own calculated data with the given snapshot, usually
+ * created from the GlideComputerBlackboard
+ * @param snapshot Calculated information usually provided
  * by the GlideComputerBlackboard
  */
 void
-DeviceBlackboard::ReadBlackboard(const DerivedInfo &derived_info)
+DeviceBlackboard::ReadBlackboard(CalculatedSnapshot &&snapshot)
 {
-  calculated_info = derived_info;
+  snapshot.SetSequence(calculated.GetSequence() + 1);
+  calculated = std::move(snapshot);
 }
 
 /**
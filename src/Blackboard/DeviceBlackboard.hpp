@@ -24,7 +24,7 @@ Copyright_License {
 #ifndef DEVICE_BLACKBOARD_H
 #define DEVICE_BLACKBOARD_H
 
-#include "Blackboard/BaseBlackboard.hpp"
+#include "Blackboard/SnapshotBlackboard.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
@@ -46,7 +46,7 @@ class RadioFrequency;
  * since it is accessed quickly with only one mutex
  */
 class DeviceBlackboard
-  : public BaseBlackboard, public ComputerSettingsBlackboard
+  : public SnapshotBlackboard, public ComputerSettingsBlackboard
 {
   friend class MergeThread;
 
@@ -91,7 +91,11 @@ public:
     devices = &_devices;
   }
 
-  void ReadBlackboard(const DerivedInfo &derived_info);
+  /**
+   * Publish a new #CalculatedSnapshot.  It gets the next sequence
+   * number.  Caller must lock the blackboard.
+   */
+  void ReadBlackboard(CalculatedSnapshot &&snapshot);
   void ReadComputerSettings(const ComputerSettings &settings);
 
 protected:
@@ -25,12 +25,25 @@ Copyright_License {
 void
 InterfaceBlackboard::ReadBlackboardCalculated(const DerivedInfo &derived_info)
 {
-  calculated_info = derived_info;
+  MarkChanged(CompareCalculated(Calculated(), derived_info));
+  calculated = CalculatedSnapshot(derived_info);
+}
+
+void
+InterfaceBlackboard::ReadBlackboardCalculated(const CalculatedSnapshot
+                                              &snapshot)
+{
+  if (snapshot.IsSame(calculated))
+    return;
+
+  MarkChanged(CompareCalculated(Calculated(), *snapshot));
+  calculated = snapshot;
 }
 
 void
 InterfaceBlackboard::ReadBlackboardBasic(const MoreData &nmea_info)
 {
+  MarkChanged(CompareBasic(gps_info, nmea_info));
   gps_info = nmea_info;
 }
 
@@ -33,6 +33,11 @@ public:
   void ReadBlackboardBasic(const MoreData &nmea_info);
   void ReadBlackboardCalculated(const DerivedInfo &derived_info);
 
+  /**
+   * Share the given snapshot instead of copying it.
+   */
+  void ReadBlackboardCalculated(const CalculatedSnapshot &snapshot);
+
   gcc_const
   SystemSettings &SetSystemSettings() {
     return system_settings;
@@ -49,10 +54,18 @@ public:
   }
 
   inline void ReadCommonStats(const CommonStats &common_stats) {
-    calculated_info.common_stats = common_stats;
+    calculated.Modify().common_stats = common_stats;
+    MarkChanged(ToMask(BlackboardSection::TASK));
   }
 
   void ReadComputerSettings(const ComputerSettings &settings);
+
+  /**
+   * Announce that the SkyLines traffic data has been modified.
+   */
+  void MarkSkyLinesChanged() {
+    MarkChanged(ToMask(BlackboardSection::SKYLINES));
+  }
 };
 
 #endif
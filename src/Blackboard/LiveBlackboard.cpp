@@ -27,14 +27,16 @@ Copyright_License {
 #include <assert.h>
 
 void
-LiveBlackboard::AddListener(BlackboardListener &listener)
+LiveBlackboard::AddListener(BlackboardListener &listener,
+                            BlackboardMask mask)
 {
   assert(!calling_listeners);
+  assert(mask != 0);
   /* must not be registered already */
   assert(std::find(listeners.begin(), listeners.end(),
                    &listener) == listeners.end());
 
-  listeners.push_back(&listener);
+  listeners.push_back({&listener, mask});
 }
 
 void
@@ -55,8 +57,12 @@ LiveBlackboard::BroadcastGPSUpdate()
   calling_listeners = true;
 #endif
 
-  for (BlackboardListener *listener : listeners)
-    listener->OnGPSUpdate(Basic());
+  const BlackboardMask changes = gps_changes;
+  gps_changes = 0;
+
+  for (const Subscription &s : listeners)
+    if (s.Wants(changes))
+      s.listener->OnGPSUpdate(Basic());
 
 #ifndef NDEBUG
   calling_listeners = false;
@@ -70,8 +76,12 @@ LiveBlackboard::BroadcastCalculatedUpdate()
   calling_listeners = true;
 #endif
 
-  for (BlackboardListener *listener : listeners)
-    listener->OnCalculatedUpdate(Basic(), Calculated());
+  const BlackboardMask changes = calculated_changes;
+  calculated_changes = 0;
+
+  for (const Subscription &s : listeners)
+    if (s.Wants(changes))
+      s.listener->OnCalculatedUpdate(Basic(), Calculated());
 
 #ifndef NDEBUG
   calling_listeners = false;
@@ -85,8 +95,8 @@ LiveBlackboard::BroadcastComputerSettingsUpdate()
   calling_listeners = true;
 #endif
 
-  for (BlackboardListener *listener : listeners)
-    listener->OnComputerSettingsUpdate(GetComputerSettings());
+  for (const Subscription &s : listeners)
+    s.listener->OnComputerSettingsUpdate(GetComputerSettings());
 
 #ifndef NDEBUG
   calling_listeners = false;
@@ -100,8 +110,8 @@ LiveBlackboard::BroadcastUISettingsUpdate()
   calling_listeners = true;
 #endif
 
-  for (BlackboardListener *listener : listeners)
-    listener->OnUISettingsUpdate(GetUISettings());
+  for (const Subscription &s : listeners)
+    s.listener->OnUISettingsUpdate(GetUISettings());
 
 #ifndef NDEBUG
   calling_listeners = false;
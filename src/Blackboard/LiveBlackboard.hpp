@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_LIVE_BLACKBOARD_HPP
 
 #include "FullBlackboard.hpp"
+#include "BlackboardSection.hpp"
 
 #include <list>
 
@@ -34,7 +35,34 @@ class BlackboardListener;
  * A blackboard that supports #BlackboardListener.
  */
 class LiveBlackboard : public FullBlackboard {
-  std::list<BlackboardListener *> listeners;
+  struct Subscription {
+    BlackboardListener *listener;
+
+    /**
+     * GPS and calculated updates are only delivered if one of these
+     * sections has changed.
+     */
+    BlackboardMask mask;
+
+    bool operator==(const BlackboardListener *other) const {
+      return listener == other;
+    }
+
+    gcc_pure
+    bool Wants(BlackboardMask changes) const {
+      return mask == BLACKBOARD_ALL || (mask & changes) != 0;
+    }
+  };
+
+  std::list<Subscription> listeners;
+
+  BlackboardGenerations generations;
+
+  /**
+   * The sections which have changed since the last
+   * BroadcastGPSUpdate() / BroadcastCalculatedUpdate() call.
+   */
+  BlackboardMask gps_changes = 0, calculated_changes = 0;
 
 #ifndef NDEBUG
   bool calling_listeners;
@@ -45,13 +73,34 @@ public:
   LiveBlackboard():calling_listeners(false) {}
 #endif
 
-  void AddListener(BlackboardListener &listener);
+  /**
+   * @param mask the sections the listener is interested in; GPS and
+   * calculated updates which do not modify any of them are not
+   * delivered
+   */
+  void AddListener(BlackboardListener &listener,
+                   BlackboardMask mask=BLACKBOARD_ALL);
   void RemoveListener(BlackboardListener &listener);
 
+  const BlackboardGenerations &GetGenerations() const {
+    return generations;
+  }
+
   void BroadcastGPSUpdate();
   void BroadcastCalculatedUpdate();
   void BroadcastComputerSettingsUpdate();
   void BroadcastUISettingsUpdate();
+
+protected:
+  /**
+   * Record modifications to the given sections.  To be called by
+   * the derived class when it receives new data.
+   */
+  void MarkChanged(BlackboardMask mask) {
+    generations.Increment(mask);
+    gps_changes |= mask;
+    calculated_changes |= mask;
+  }
 };
 
 #endif
@@ -22,34 +22,34 @@ Copyright_License {
 */
 
 #include "RateLimitedBlackboardListener.hpp"
+#include "LiveBlackboard.hpp"
+#include "Compiler.h"
 
 void
-RateLimitedBlackboardListener::OnGPSUpdate(const MoreData &_basic)
+RateLimitedBlackboardListener::OnGPSUpdate(gcc_unused const MoreData &basic)
 {
-  basic = &_basic;
+  gps_pending = true;
   Trigger();
 }
 
 void
-RateLimitedBlackboardListener::OnCalculatedUpdate(const MoreData &_basic,
-                                                  const DerivedInfo &_calculated)
+RateLimitedBlackboardListener::OnCalculatedUpdate(gcc_unused const MoreData &basic,
+                                                  gcc_unused const DerivedInfo &calculated)
 {
-  basic2 = &_basic;
-  calculated = &_calculated;
+  calculated_pending = true;
   Trigger();
 }
 
 void
 RateLimitedBlackboardListener::Run()
 {
-  if (basic != nullptr) {
-    next.OnGPSUpdate(*basic);
-    basic = nullptr;
+  if (gps_pending) {
+    gps_pending = false;
+    next.OnGPSUpdate(blackboard.Basic());
   }
 
-  if (calculated != nullptr){
-    next.OnCalculatedUpdate(*basic2, *calculated);
-    basic2 = nullptr;
-    calculated = nullptr;
+  if (calculated_pending) {
+    calculated_pending = false;
+    next.OnCalculatedUpdate(blackboard.Basic(), blackboard.Calculated());
   }
 }
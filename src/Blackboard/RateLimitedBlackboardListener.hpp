@@ -27,21 +27,34 @@ Copyright_License {
 #include "ProxyBlackboardListener.hpp"
 #include "RateLimiter.hpp"
 
+class LiveBlackboard;
+
 /**
  * A proxy #BlackboardListener that limits the rate of GPS and
  * Calculated updates.
+ *
+ * The forwarded data is obtained from the #LiveBlackboard when the
+ * delayed call is made, because the #DerivedInfo passed to
+ * OnCalculatedUpdate() belongs to a #CalculatedSnapshot which may
+ * have been replaced meanwhile.
+ *
+ * Register it with the #BlackboardMask of the listener it forwards
+ * to; updates which do not touch those sections are then dropped
+ * before they reach the rate limiter.
  */
 class RateLimitedBlackboardListener
   : public ProxyBlackboardListener, private RateLimiter {
-  const MoreData *basic, *basic2;
-  const DerivedInfo *calculated;
+  const LiveBlackboard &blackboard;
+
+  bool gps_pending = false, calculated_pending = false;
 
 public:
-  RateLimitedBlackboardListener(BlackboardListener &_next,
+  RateLimitedBlackboardListener(const LiveBlackboard &_blackboard,
+                                BlackboardListener &_next,
                                 unsigned period_ms, unsigned delay_ms)
     :ProxyBlackboardListener(_next),
      RateLimiter(period_ms, delay_ms),
-     basic(nullptr), basic2(nullptr), calculated(nullptr) {}
+     blackboard(_blackboard) {}
 
   using RateLimiter::Cancel;
 
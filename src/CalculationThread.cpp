@@ -27,6 +27,7 @@ Copyright_License {
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Components.hpp"
 #include "Hardware/CPU.hpp"
+#include "PipelineLatency.hpp"
 
 /**
  * Constructor of the CalculationThread class
@@ -91,16 +92,23 @@ CalculationThread::Tick()
 
   bool do_idle = false;
 
-  if (gps_updated || force)
+  if (gps_updated || force) {
     // perform idle call if time advanced and slow calculations need to be updated
     do_idle |= glide_computer.ProcessGPS(force);
 
+    PipelineLatency::Record(PipelineLatency::Stage::CALCULATE,
+                            glide_computer.Basic().receive_clock_us);
+  }
+
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
-  // that one back (otherwise we may write over new data)
+  // that one back (otherwise we may write over new data); the copy
+  // is made before locking, publishing it is only a pointer swap
   {
+    CalculatedSnapshot snapshot(glide_computer.Calculated());
+
     ScopeLock protect(device_blackboard->mutex);
-    device_blackboard->ReadBlackboard(glide_computer.Calculated());
+    device_blackboard->ReadBlackboard(std::move(snapshot));
   }
 
   // if (new GPS data)
@@ -102,14 +102,22 @@ GlideComputer::ProcessGPS(bool force)
   // Process basic task information
   const bool last_finished = calculated.ordered_task_stats.task_finished;
 
-  task_computer.ProcessBasicTask(basic,
-                                 calculated,
-                                 settings,
-                                 force);
+  {
+    const ScopeStageTimer timer(stage_times,
+                                ComputerStageTimes::Stage::TASK);
+    task_computer.ProcessBasicTask(basic,
+                                   calculated,
+                                   settings,
+                                   force);
+  }
 
   CalculateWorkingBand();
 
-  task_computer.ProcessMoreTask(basic, calculated, settings);
+  {
+    const ScopeStageTimer timer(stage_times,
+                                ComputerStageTimes::Stage::TASK);
+    task_computer.ProcessMoreTask(basic, calculated, settings);
+  }
 
   if (!last_finished && calculated.ordered_task_stats.task_finished)
     OnFinishTask();
@@ -120,7 +128,11 @@ GlideComputer::ProcessGPS(bool force)
 
   TakeoffLanding(last_flying);
 
-  task_computer.ProcessAutoTask(basic, calculated);
+  {
+    const ScopeStageTimer timer(stage_times,
+                                ComputerStageTimes::Stage::TASK);
+    task_computer.ProcessAutoTask(basic, calculated);
+  }
 
   // Process extended information
   air_data_computer.ProcessVertical(Basic(),
@@ -149,6 +161,10 @@ GlideComputer::ProcessGPS(bool force)
 
   CalculateVarioScale();
 
+  /* the IGC logger runs here and not in ProcessIdle(), which is
+     throttled to 2 Hz, so it sees every fix in high-rate mode */
+  log_computer.Run(basic, calculated, settings.logger);
+
   // Update the ConditionMonitors
   ConditionMonitorsUpdate(Basic(), Calculated(), settings);
 
@@ -164,13 +180,20 @@ GlideComputer::ProcessIdle(bool exhaustive)
   // Log GPS fixes for internal usage
   // (snail trail, stats, olc, ...)
   stats_computer.DoLogging(basic, calculated);
-  log_computer.Run(basic, calculated, GetComputerSettings().logger);
 
-  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
-                            exhaustive);
+  {
+    const ScopeStageTimer timer(stage_times,
+                                ComputerStageTimes::Stage::CONTEST);
+    task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
+                              exhaustive);
+  }
 
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
+  {
+    const ScopeStageTimer timer(stage_times,
+                                ComputerStageTimes::Stage::AIRSPACE);
+    warning_computer.Update(GetComputerSettings(), basic,
+                            calculated, calculated.airspace_warnings);
+  }
 
   // Calculate summary of flight
   if (basic.location_available)
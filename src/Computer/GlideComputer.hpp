@@ -33,6 +33,7 @@ Copyright_License {
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
 #include "CuComputer.hpp"
+#include "StageTimes.hpp"
 #include "Compiler.h"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 
@@ -69,6 +70,12 @@ class GlideComputer : public GlideComputerBlackboard
    */
   DeltaTime trace_history_time;
 
+  /**
+   * If not nullptr, then the time spent in each stage is added to
+   * this object.
+   */
+  ComputerStageTimes *stage_times = nullptr;
+
 public:
   GlideComputer(const ComputerSettings &_settings,
                 const Waypoints &_way_points,
@@ -162,6 +169,14 @@ public:
     task_computer.SetContestIncremental(incremental);
   }
 
+  /**
+   * Enable measuring the time spent in the task, contest and
+   * airspace stages.  Pass nullptr to disable.
+   */
+  void SetStageTimes(ComputerStageTimes *_stage_times) {
+    stage_times = _stage_times;
+  }
+
 protected:
   void OnTakeoff();
   void OnLanding();
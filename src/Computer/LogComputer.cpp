@@ -61,8 +61,10 @@ LogComputer::Run(const MoreData &basic, const DerivedInfo &calculated,
     return false;
 
   // log points more often in circling mode
-  unsigned period;
-  if (fast_log_num) {
+  double period;
+  if (settings_logger.high_rate)
+    period = HIGH_RATE_PERIOD;
+  else if (fast_log_num) {
     period = 1;
     fast_log_num--;
   } else
@@ -36,6 +36,12 @@ struct LoggerSettings;
 class Logger;
 
 class LogComputer {
+  /**
+   * The minimum interval [s] between two fixes in high-rate mode,
+   * i.e. at most 10 Hz (with some tolerance for timestamp jitter).
+   */
+  static constexpr double HIGH_RATE_PERIOD = 0.09;
+
   GeoPoint last_location;
 
   GPSClock log_clock;
@@ -28,6 +28,8 @@ Copyright_License {
 #include "NMEA/Derived.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Engine/Route/ReachResult.hpp"
 
 #include <algorithm>
 
@@ -46,6 +48,8 @@ RouteComputer::ResetFlight()
 
   last_task_type = TaskType::NONE;
   last_active_tp = 0;
+
+  arrival_raster.Clear();
 }
 
 void
@@ -53,7 +57,8 @@ RouteComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                             const GlideSettings &settings,
                             const RoutePlannerConfig &config,
                             const GlidePolar &glide_polar,
-                            const GlidePolar &safety_polar)
+                            const GlidePolar &safety_polar,
+                            bool arrival_enabled)
 {
   if (!basic.location_available || !basic.NavAltitudeAvailable())
     return;
@@ -63,8 +68,18 @@ RouteComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                                     calculated.GetWindOrZero(),
                                     calculated.common_stats.height_min_working);
 
-  Reach(basic, calculated, config);
+  const bool reach_solved = Reach(basic, calculated, config);
   TerrainWarning(basic, calculated, config);
+
+  if (arrival_enabled) {
+    if (reach_solved)
+      BeginArrival();
+
+    StepArrival();
+  } else if (arrival_raster.IsDefined()) {
+    arrival_raster.Clear();
+    protected_route_planner.SetArrivalRaster(arrival_raster);
+  }
 }
 
 inline void
@@ -125,7 +140,7 @@ RouteComputer::TerrainWarning(const MoreData &basic,
   calculated.terrain_warning_location.SetInvalid();
 }
 
-inline void
+inline bool
 RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
                      const RoutePlannerConfig &config)
 {
@@ -134,7 +149,7 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
        reachabilty, so let's skip that step completely */
     calculated.terrain_base_valid = false;
     protected_route_planner.ClearReach();
-    return;
+    return false;
   }
 
   const bool do_solve = config.IsReachEnabled() && terrain != NULL;
@@ -150,8 +165,103 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
     if (do_solve) {
       calculated.terrain_base = route_planner.GetTerrainBase();
       calculated.terrain_base_valid = true;
+      return true;
     }
   }
+
+  return false;
+}
+
+void
+RouteComputer::BeginArrival()
+{
+  const GeoBounds reach = route_planner.GetTerrainReachBounds();
+  if (terrain == nullptr || !reach.IsValid()) {
+    arrival_raster.Clear();
+    return;
+  }
+
+  RasterTerrain::Lease map(*terrain);
+  const RasterProjection &projection = map->GetProjection();
+
+  const SignedRasterLocation nw =
+    projection.ProjectCoarse(reach.GetNorthWest());
+  const SignedRasterLocation se =
+    projection.ProjectCoarse(reach.GetSouthEast());
+
+  const ArrivalGrid grid = ArrivalGrid::Cover(nw.x, nw.y, se.x, se.y);
+  if (arrival_raster.Restart(grid))
+    /* the reach still fits into the same cells: reuse the grid */
+    return;
+
+  const int east = grid.x + int(grid.width) * grid.cell;
+  const int south = grid.y + int(grid.height) * grid.cell;
+  const GeoPoint north_west =
+    projection.UnprojectCoarse(SignedRasterLocation(grid.x, grid.y));
+  const GeoPoint south_east =
+    projection.UnprojectCoarse(SignedRasterLocation(east, south));
+
+  arrival_raster.Reset(grid, GeoBounds(north_west, south_east));
+}
+
+inline int16_t
+RouteComputer::CalculateArrival(const RasterMap &map,
+                                const GeoPoint &location) const
+{
+  const TerrainHeight h = map.GetHeight(location);
+  if (h.IsInvalid())
+    return ArrivalRaster::UNREACHABLE;
+
+  const int elevation = h.GetValueOr0();
+
+  ReachResult reach;
+  if (!route_planner.FindPositiveArrival(AGeoPoint(location, elevation),
+                                         reach))
+    return ArrivalRaster::UNREACHABLE;
+
+  int arrival;
+  switch (reach.terrain_valid) {
+  case ReachResult::Validity::VALID:
+    arrival = reach.terrain;
+    break;
+
+  case ReachResult::Validity::INVALID:
+    /* terrain reach not available */
+    arrival = reach.direct;
+    break;
+
+  default:
+    return ArrivalRaster::UNREACHABLE;
+  }
+
+  arrival -= elevation;
+  if (arrival < 0)
+    return ArrivalRaster::UNREACHABLE;
+
+  return std::min(arrival, INT16_MAX);
+}
+
+void
+RouteComputer::StepArrival()
+{
+  if (!arrival_raster.IsDefined() || arrival_raster.IsComplete() ||
+      terrain == nullptr)
+    /* nothing to do */
+    return;
+
+  bool complete;
+
+  {
+    RasterTerrain::Lease map(*terrain);
+
+    complete = arrival_raster.Fill(ARRIVAL_CELLS_PER_STEP,
+                                   [this, &map](const GeoPoint &location){
+                                     return CalculateArrival(map, location);
+                                   });
+  }
+
+  if (complete)
+    protected_route_planner.SetArrivalRaster(arrival_raster);
 }
 
 void
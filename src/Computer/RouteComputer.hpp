@@ -27,6 +27,7 @@ Copyright_License {
 #include "Task/ProtectedRoutePlanner.hpp"
 #include "Engine/Task/TaskType.hpp"
 #include "Engine/Route/RoutePlanner.hpp"
+#include "Engine/Route/ArrivalRaster.hpp"
 #include "Time/GPSClock.hpp"
 
 struct MoreData;
@@ -35,11 +36,19 @@ struct GlideSettings;
 struct RoutePlannerConfig;
 class ProtectedAirspaceWarningManager;
 class RasterTerrain;
+class RasterMap;
 class GlidePolar;
 
 class RouteComputer {
   static constexpr unsigned PERIOD = 5;
 
+  /**
+   * The number of #ArrivalRaster cells calculated per
+   * ProcessRoute() call.  A whole raster takes a few calls, which
+   * keeps the cost per GPS fix bounded.
+   */
+  static constexpr unsigned ARRIVAL_CELLS_PER_STEP = 1024;
+
   RoutePlannerGlue route_planner;
   ProtectedRoutePlanner protected_route_planner;
 
@@ -51,6 +60,12 @@ class RouteComputer {
   TaskType last_task_type;
   unsigned last_active_tp;
 
+  /**
+   * The arrival raster which is being calculated.  It is published
+   * to #protected_route_planner when all cells are done.
+   */
+  ArrivalRaster arrival_raster;
+
 public:
   RouteComputer(const Airspaces &airspace_database,
                 const ProtectedAirspaceWarningManager *warnings);
@@ -76,11 +91,16 @@ public:
   }
 
   void ResetFlight();
+
+  /**
+   * @param arrival_enabled calculate the #ArrivalRaster?
+   */
   void ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                     const GlideSettings &settings,
                     const RoutePlannerConfig &config,
                     const GlidePolar &glide_polar,
-                    const GlidePolar &safety_polar);
+                    const GlidePolar &safety_polar,
+                    bool arrival_enabled);
 
   void set_terrain(const RasterTerrain* _terrain);
 
@@ -89,8 +109,34 @@ private:
                       DerivedInfo &calculated,
                       const RoutePlannerConfig &config);
 
-  void Reach(const MoreData &basic, DerivedInfo &calculated,
+  /**
+   * @return true if the reach was solved
+   */
+  bool Reach(const MoreData &basic, DerivedInfo &calculated,
              const RoutePlannerConfig &config);
+
+  /**
+   * Set up #arrival_raster for the current reach, aligned with the
+   * terrain grid.  If the grid is unchanged, the old cells are kept
+   * and recalculated in place.
+   */
+  void BeginArrival();
+
+  /**
+   * Calculate the arrival height above terrain at the given
+   * location.
+   *
+   * @return the height or ArrivalRaster::UNREACHABLE
+   */
+  gcc_pure
+  int16_t CalculateArrival(const RasterMap &map,
+                           const GeoPoint &location) const;
+
+  /**
+   * Calculate the next batch of #arrival_raster cells, and publish
+   * the raster when it is complete.
+   */
+  void StepArrival();
 };
 
 #endif
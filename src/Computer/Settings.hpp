@@ -135,6 +135,7 @@ struct FeaturesSettings {
     WORKING,
     WORKING_TERRAIN_LINE,
     WORKING_TERRAIN_SHADE,
+    TERRAIN_ARRIVAL,
   } final_glide_terrain;
 
   /** block speed to fly instead of dolphin */
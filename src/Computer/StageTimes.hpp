@@ -0,0 +1,106 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_COMPUTER_STAGE_TIMES_HPP
+#define XCSOAR_COMPUTER_STAGE_TIMES_HPP
+
+#include "OS/Clock.hpp"
+
+#include <stdint.h>
+
+/**
+ * Accumulates the wall time spent in the stages of the calculation
+ * pipeline.  This is used by benchmarks, see
+ * GlideComputer::SetStageTimes(); normally, no instance exists, and
+ * each stage costs just a pointer check.
+ */
+struct ComputerStageTimes {
+  enum class Stage : uint8_t {
+    /**
+     * Copying the raw sensor data into #MoreData.
+     */
+    MERGE,
+
+    /**
+     * #BasicComputer and #FlyingComputer.
+     */
+    BASIC,
+
+    /**
+     * #TaskComputer, i.e. #TaskManager, the trace and the route
+     * planner.
+     */
+    TASK,
+
+    /**
+     * The contest solvers.
+     */
+    CONTEST,
+
+    /**
+     * The airspace warnings.
+     */
+    AIRSPACE,
+
+    COUNT
+  };
+
+  static constexpr unsigned N_STAGES = unsigned(Stage::COUNT);
+
+  uint64_t us[N_STAGES] = {};
+
+  uint64_t Get(Stage stage) const {
+    return us[unsigned(stage)];
+  }
+
+  void Add(Stage stage, uint64_t duration_us) {
+    us[unsigned(stage)] += duration_us;
+  }
+};
+
+/**
+ * Adds the wall time until the end of the scope to one stage of a
+ * #ComputerStageTimes object.  Does nothing if there is no such
+ * object.
+ */
+class ScopeStageTimer {
+  ComputerStageTimes *const times;
+  const ComputerStageTimes::Stage stage;
+  const uint64_t start_us;
+
+public:
+  ScopeStageTimer(ComputerStageTimes *_times,
+                  ComputerStageTimes::Stage _stage)
+    :times(_times), stage(_stage),
+     start_us(times != nullptr ? MonotonicClockUS() : 0) {}
+
+  ~ScopeStageTimer() {
+    if (times != nullptr)
+      times->Add(stage, MonotonicClockUS() - start_us);
+  }
+
+  ScopeStageTimer(const ScopeStageTimer &) = delete;
+  ScopeStageTimer &operator=(const ScopeStageTimer &) = delete;
+};
+
+#endif
@@ -112,7 +112,9 @@ TaskComputer::ProcessMoreTask(const MoreData &basic,
   route.ProcessRoute(basic, calculated,
                      settings_computer.task.glide,
                      settings_computer.task.route_planner,
-                     glide_polar, safety_polar);
+                     glide_polar, safety_polar,
+                     settings_computer.features.final_glide_terrain ==
+                     FeaturesSettings::FinalGlideTerrain::TERRAIN_ARRIVAL);
 
   if (settings_computer.features.block_stf_enabled)
     calculated.V_stf = calculated.common_stats.V_block;
@@ -25,6 +25,7 @@ Copyright_License {
 #include "Settings.hpp"
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
+#include "Engine/Trace/Vector.hpp"
 #include "Asset.hpp"
 
 static constexpr unsigned full_trace_size =
@@ -74,6 +75,32 @@ TraceComputer::LockedCopyTo(TracePointVector &v, unsigned min_time,
   full.GetPoints(v, min_time, location, resolution);
 }
 
+bool
+TraceComputer::LockedSyncTo(TracePointVector &v, unsigned min_time,
+                            const GeoPoint &location, double resolution,
+                            Serial &serial, unsigned &range) const
+{
+  const ScopeLock lock(mutex);
+
+  if (full.empty()) {
+    v.clear();
+    serial = full.GetModifySerial();
+    return true;
+  }
+
+  const unsigned new_range = full.ProjectRange(location, resolution);
+  if (!v.empty() && serial == full.GetModifySerial() && range == new_range) {
+    full.SyncPoints(v, range);
+    return false;
+  }
+
+  v.clear();
+  serial = full.GetModifySerial();
+  range = new_range;
+  full.GetPoints(v, min_time, range);
+  return true;
+}
+
 void
 TraceComputer::Update(const ComputerSettings &settings_computer,
                       const MoreData &basic, const DerivedInfo &calculated)
@@ -94,6 +94,24 @@ public:
   void LockedCopyTo(TracePointVector &v, unsigned min_time,
                             const GeoPoint &location, double resolution) const;
 
+  /**
+   * Incremental version of LockedCopyTo(v, min_time, location,
+   * resolution): if #v holds the result of an earlier call and the
+   * trace has only grown since, then just the new points are
+   * appended; points older than #min_time are not removed in that
+   * case.  The trace is locked, and the method may be called from
+   * any thread.
+   *
+   * @param serial the trace's modification serial, updated by this
+   * method
+   * @param range the resolution of #v in trace projection units,
+   * updated by this method
+   * @return true if #v was reloaded completely
+   */
+  bool LockedSyncTo(TracePointVector &v, unsigned min_time,
+                    const GeoPoint &location, double resolution,
+                    Serial &serial, unsigned &range) const;
+
   void Update(const ComputerSettings &settings_computer,
               const MoreData &basic, const DerivedInfo &calculated);
 };
@@ -81,7 +81,9 @@ CrossSectionWidget::Show(const PixelRect &rc)
 {
   Update(CommonInterface::Basic(), CommonInterface::Calculated(),
          CommonInterface::GetMapSettings());
-  CommonInterface::GetLiveBlackboard().AddListener(*this);
+  CommonInterface::GetLiveBlackboard()
+    .AddListener(*this, ToMask(BlackboardSection::POSITION) |
+                 ToMask(BlackboardSection::WIND));
 
   WindowWidget::Show(rc);
 }
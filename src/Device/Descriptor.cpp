@@ -43,6 +43,8 @@ Copyright_License {
 #include "../Simulator.hpp"
 #include "Input/InputQueue.hpp"
 #include "LogFile.hpp"
+#include "PipelineLatency.hpp"
+#include "OS/Clock.hpp"
 #include "Job/Job.hpp"
 
 #ifdef ANDROID
@@ -114,6 +116,7 @@ DeviceDescriptor::DeviceDescriptor(boost::asio::io_service &_io_service,
    nunchuck(nullptr),
    voltage(nullptr),
 #endif
+   receive_clock_us(0),
    n_failures(0u),
    ticker(false), borrowed(false)
 {
@@ -1144,7 +1147,12 @@ DeviceDescriptor::ParseLine(const char *line)
   ScopeLock protect(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
   basic.UpdateClock();
-  return ParseNMEA(line, basic);
+  if (!ParseNMEA(line, basic))
+    return false;
+
+  basic.receive_clock_us = receive_clock_us;
+  PipelineLatency::Record(PipelineLatency::Stage::PARSE, receive_clock_us);
+  return true;
 }
 
 void
@@ -1196,6 +1204,8 @@ DeviceDescriptor::PortError(const char *msg)
 void
 DeviceDescriptor::DataReceived(const void *data, size_t length)
 {
+  receive_clock_us = MonotonicClockUS();
+
   if (monitor != nullptr)
     monitor->DataReceived(data, length);
 
@@ -1211,6 +1221,10 @@ DeviceDescriptor::DataReceived(const void *data, size_t length)
       if (!config.sync_from_device)
         basic.settings = old_settings;
 
+      basic.receive_clock_us = receive_clock_us;
+      PipelineLatency::Record(PipelineLatency::Stage::PARSE,
+                              receive_clock_us);
+
       device_blackboard->ScheduleMerge();
     }
 
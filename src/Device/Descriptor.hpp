@@ -43,6 +43,7 @@ Copyright_License {
 #include <assert.h>
 #include <tchar.h>
 #include <stdio.h>
+#include <stdint.h>
 
 namespace boost { namespace asio { class io_service; }}
 
@@ -177,6 +178,13 @@ class DeviceDescriptor final : Notify, PortListener, PortLineSplitter {
    */
   NMEAParser parser;
 
+  /**
+   * The MonotonicClockUS() time stamp of the current DataReceived()
+   * call.  It is copied to NMEAInfo::receive_clock_us by
+   * ParseLine().
+   */
+  uint64_t receive_clock_us;
+
   /**
    * The settings that were sent to the device.  This is used to check
    * if the device is sending back the new configuration; then the
@@ -25,6 +25,7 @@ Copyright_License {
 #include "Units/System.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceKey.hpp"
 #include "NMEA/Checksum.hpp"
 
 static bool
@@ -148,17 +149,17 @@ CAI302Device::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
 
-  if (StringIsEqual(type, "$PCAIB"))
+  switch (NMEASentenceKey(line.ReadView())) {
+  case NMEASentenceKey("$PCAIB"):
     return cai_PCAIB(line, info);
 
-  if (StringIsEqual(type, "$PCAID"))
+  case NMEASentenceKey("$PCAID"):
     return cai_PCAID(line, info);
 
-  if (StringIsEqual(type, "!w"))
+  case NMEASentenceKey("!w"):
     return cai_w(line, info);
+  }
 
   return false;
 }
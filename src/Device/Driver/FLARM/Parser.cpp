@@ -59,10 +59,7 @@ FlarmDevice::ParseNMEA(const char *_line, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(_line);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$PFLAC"))
+  if (line.ReadCompare("$PFLAC"))
     return ParsePFLAC(line);
   else
     return false;
@@ -25,6 +25,7 @@ Copyright_License {
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Info.hpp"
+#include "NMEA/SentenceKey.hpp"
 #include "Geo/SpeedVector.hpp"
 #include "Units/System.hpp"
 #include "Util/Macros.hpp"
@@ -344,13 +345,12 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
 
-  if (StringIsEqual(type, "$LXWP0"))
+  switch (NMEASentenceKey(line.ReadView())) {
+  case NMEASentenceKey("$LXWP0"):
     return LXWP0(line, info);
 
-  if (StringIsEqual(type, "$LXWP1")) {
+  case NMEASentenceKey("$LXWP1"): {
     /* if in pass-through mode, assume that this line was sent by the
        secondary device */
     DeviceInfo &device_info = mode == Mode::PASS_THROUGH
@@ -384,34 +384,31 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return true;
   }
 
-  if (StringIsEqual(type, "$LXWP2"))
+  case NMEASentenceKey("$LXWP2"):
     return LXWP2(line, info);
 
-  if (StringIsEqual(type, "$LXWP3"))
+  case NMEASentenceKey("$LXWP3"):
     return LXWP3(line, info);
 
-  if (StringIsEqual(type, "$PLXV0")) {
+  case NMEASentenceKey("$PLXV0"):
     is_v7 = true;
     is_colibri = false;
     return PLXV0(line, v7_settings);
-  }
 
-  if (StringIsEqual(type, "$PLXVC")) {
+  case NMEASentenceKey("$PLXVC"):
     is_nano = true;
     is_colibri = false;
     PLXVC(line, info.device, info.secondary_device, nano_settings);
     is_forwarded_nano = info.secondary_device.product.equals("NANO") ||
                           info.secondary_device.product.equals("NANO3");
     return true;
-  }
 
-  if (StringIsEqual(type, "$PLXVF")) {
+  case NMEASentenceKey("$PLXVF"):
     is_v7 = true;
     is_colibri = false;
     return PLXVF(line, info);
-  }
 
-  if (StringIsEqual(type, "$PLXVS")) {
+  case NMEASentenceKey("$PLXVS"):
     is_v7 = true;
     is_colibri = false;
     return PLXVS(line, info);
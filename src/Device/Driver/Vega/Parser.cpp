@@ -25,6 +25,7 @@ Copyright_License {
 #include "Message.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceKey.hpp"
 #include "Compiler.h"
 
 #include <tchar.h>
@@ -218,32 +219,42 @@ bool
 VegaDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
+  const auto type = line.ReadView();
 
-  if (memcmp(type, "$PD", 3) == 0)
+  if (type.end() - type.begin() >= 3 && memcmp(type.begin(), "$PD", 3) == 0)
     detected = true;
 
-  if (StringIsEqual(type, "$PDSWC"))
+  switch (NMEASentenceKey(type)) {
+  case NMEASentenceKey("$PDSWC"):
     return PDSWC(line, info, volatile_data);
-  else if (StringIsEqual(type, "$PDAAV"))
+
+  case NMEASentenceKey("$PDAAV"):
     return PDAAV(line, info);
-  else if (StringIsEqual(type, "$PDVSC"))
+
+  case NMEASentenceKey("$PDVSC"):
     return PDVSC(line, info);
-  else if (StringIsEqual(type, "$PDVDV"))
+
+  case NMEASentenceKey("$PDVDV"):
     return PDVDV(line, info);
-  else if (StringIsEqual(type, "$PDVDS"))
+
+  case NMEASentenceKey("$PDVDS"):
     return PDVDS(line, info);
-  else if (StringIsEqual(type, "$PDVVT"))
+
+  case NMEASentenceKey("$PDVVT"):
     return PDVVT(line, info);
-  else if (StringIsEqual(type, "$PDVSD")) {
+
+  case NMEASentenceKey("$PDVSD"): {
     const auto message = line.Rest();
     StaticString<256> buffer;
     buffer.SetASCII(message.begin(), message.end());
     Message::AddMessage(buffer);
     return true;
-  } else if (StringIsEqual(type, "$PDTSM"))
+  }
+
+  case NMEASentenceKey("$PDTSM"):
     return PDTSM(line, info);
-  else
+
+  default:
     return false;
+  }
 }
@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceKey.hpp"
 #include "Units/System.hpp"
 #include "Driver/FLARM/StaticParser.hpp"
 #include "Util/CharUtil.hxx"
@@ -58,61 +59,62 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
 
   NMEAInputLine line(string);
 
-  char type[16];
-  line.Read(type, 16);
+  const auto type = line.ReadView();
+  if (type.end() - type.begin() != 6)
+    return false;
+
+  const char *t = type.begin();
 
-  if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
-    if (StringIsEqual(type + 3, "GSA"))
+  if (IsAlphaASCII(t[1]) && IsAlphaASCII(t[2])) {
+    switch (NMEASentenceKey(t + 3, 3)) {
+    case NMEASentenceKey("GSA"):
       return GSA(line, info);
 
-    if (StringIsEqual(type + 3, "GLL"))
+    case NMEASentenceKey("GLL"):
       return GLL(line, info);
 
-    if (StringIsEqual(type + 3, "RMC"))
+    case NMEASentenceKey("RMC"):
       return RMC(line, info);
 
-    if (StringIsEqual(type + 3, "GGA"))
+    case NMEASentenceKey("GGA"):
       return GGA(line, info);
 
-    if (StringIsEqual(type + 3, "HDM"))
+    case NMEASentenceKey("HDM"):
       return HDM(line, info);
 
-    if (StringIsEqual(type + 3, "MWV"))
+    case NMEASentenceKey("MWV"):
       return MWV(line, info);
+    }
   }
 
   // if (proprietary sentence) ...
-  if (type[1] == 'P') {
-    // Airspeed and vario sentence
-    if (StringIsEqual(type + 1, "PTAS1"))
+  if (t[1] == 'P') {
+    switch (NMEASentenceKey(t + 2, 4)) {
+    case NMEASentenceKey("TAS1"):
+      // Airspeed and vario sentence
       return PTAS1(line, info);
 
     // FLARM sentences
-    if (StringIsEqual(type + 1, "PFLAE")) {
+    case NMEASentenceKey("FLAE"):
       ParsePFLAE(line, info.flarm.error, info.clock);
       return true;
-    }
 
-    if (StringIsEqual(type + 1, "PFLAV")) {
+    case NMEASentenceKey("FLAV"):
       ParsePFLAV(line, info.flarm.version, info.clock);
       return true;
-    }
 
-    if (StringIsEqual(type + 1, "PFLAA")) {
+    case NMEASentenceKey("FLAA"):
       ParsePFLAA(line, info.flarm.traffic, info.clock);
       return true;
-    }
 
-    if (StringIsEqual(type + 1, "PFLAU")) {
+    case NMEASentenceKey("FLAU"):
       ParsePFLAU(line, info.flarm.status, info.clock);
       return true;
-    }
 
-    // Garmin altitude sentence
-    if (StringIsEqual(type + 1, "PGRMZ"))
+    case NMEASentenceKey("GRMZ"):
+      // Garmin altitude sentence
       return RMZ(line, info);
-
-    return false;
+    }
   }
 
   return false;
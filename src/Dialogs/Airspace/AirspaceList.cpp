@@ -93,7 +93,8 @@ public:
   virtual void Show(const PixelRect &rc) override {
     ListWidget::Show(rc);
     UpdateList();
-    CommonInterface::GetLiveBlackboard().AddListener(*this);
+    CommonInterface::GetLiveBlackboard()
+      .AddListener(*this, ToMask(BlackboardSection::POSITION));
   }
 
   virtual void Hide() override {
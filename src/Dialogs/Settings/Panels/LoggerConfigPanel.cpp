@@ -35,6 +35,7 @@ enum ControlIndex {
   PilotName,
   LoggerTimeStepCruise,
   LoggerTimeStepCircling,
+  LoggerHighRate,
   DisableAutoLogger,
   EnableNMEALogger,
   EnableFlightLogger,
@@ -77,6 +78,13 @@ LoggerConfigPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
           1, 30, 1, logger.time_step_circling);
   SetExpertRow(LoggerTimeStepCircling);
 
+  AddBoolean(_("High rate"),
+             _("Log every GPS fix (up to 10 per second) with airspeed, "
+               "vario and engine noise, ignoring the time steps above. "
+               "Requires a GPS with a high update rate."),
+             logger.high_rate);
+  SetExpertRow(LoggerHighRate);
+
   AddEnum(_("Auto. logger"),
           _("Enables the automatic starting and stopping of logger on takeoff and landing "
             "respectively. Disable when flying paragliders."),
@@ -112,6 +120,9 @@ LoggerConfigPanel::Save(bool &changed)
   changed |= SaveValue(LoggerTimeStepCircling, ProfileKeys::LoggerTimeStepCircling,
                        logger.time_step_circling);
 
+  changed |= SaveValue(LoggerHighRate, ProfileKeys::LoggerHighRate,
+                       logger.high_rate);
+
   /* GUI label is "Enable Auto Logger" */
   changed |= SaveValueEnum(DisableAutoLogger, ProfileKeys::AutoLogger,
                            logger.auto_logger);
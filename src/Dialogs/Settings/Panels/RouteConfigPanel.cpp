@@ -169,6 +169,8 @@ RouteConfigPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
       N_("Draws a dashed line at the working and terrain glide reaches.") },
     { (unsigned)FeaturesSettings::FinalGlideTerrain::WORKING_TERRAIN_SHADE, N_("Working line, terrain shade"),
       N_("Draws a dashed line at working, and shade terrain, glide reaches.") },
+    { (unsigned)FeaturesSettings::FinalGlideTerrain::TERRAIN_ARRIVAL, N_("Arrival height"),
+      N_("Draws a dashed line at the terrain glide reach, and colours the terrain inside by the arrival height.") },
     { 0 }
   };
 
@@ -113,7 +113,8 @@ WindSettingsPanel::Show(const PixelRect &rc)
 {
   if (edit_manual_wind) {
     UpdateVector();
-    CommonInterface::GetLiveBlackboard().AddListener(*this);
+    CommonInterface::GetLiveBlackboard()
+      .AddListener(*this, ToMask(BlackboardSection::WIND));
   }
 
   RowFormWidget::Show(rc);
@@ -0,0 +1,89 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LatencyStatusPanel.hpp"
+#include "PipelineLatency.hpp"
+#include "Interface.hpp"
+#include "Language/Language.hpp"
+#include "Util/StaticString.hxx"
+
+LatencyStatusPanel::LatencyStatusPanel(const DialogLook &look)
+  :StatusPanel(look),
+   rate_limiter(CommonInterface::GetLiveBlackboard(), *this, 2000, 500) {}
+
+void
+LatencyStatusPanel::Refresh()
+{
+  StaticString<80> buffer;
+
+  for (unsigned i = 0; i < PipelineLatency::N_STAGES; ++i) {
+    const auto summary =
+      PipelineLatency::GetSummary(PipelineLatency::Stage(i));
+    if (summary.n == 0) {
+      ClearText(i);
+      continue;
+    }
+
+    buffer.Format(_T("%.1f / %.1f / %.1f ms"),
+                  summary.mean_us / 1000., summary.p95_us / 1000.,
+                  summary.max_us / 1000.);
+    SetText(i, buffer);
+  }
+}
+
+void
+LatencyStatusPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
+{
+  /* the rows must be in the order of PipelineLatency::Stage; each
+     one shows average / 95th percentile / maximum */
+  AddReadOnly(_("Parse"),
+              _("Time from receiving data until the driver has parsed it."));
+  AddReadOnly(_("Merge"),
+              _("Time from receiving data until it is merged with the data of other devices."));
+  AddReadOnly(_("Calculation"),
+              _("Time from receiving a GPS fix until the glide computer has processed it."));
+  AddReadOnly(_("Drawing"),
+              _("Time from receiving a GPS fix until the map showing it has been drawn."));
+}
+
+void
+LatencyStatusPanel::Show(const PixelRect &rc)
+{
+  Refresh();
+  CommonInterface::GetLiveBlackboard().AddListener(rate_limiter);
+  StatusPanel::Show(rc);
+}
+
+void
+LatencyStatusPanel::Hide()
+{
+  StatusPanel::Hide();
+  CommonInterface::GetLiveBlackboard().RemoveListener(rate_limiter);
+  rate_limiter.Cancel();
+}
+
+void
+LatencyStatusPanel::OnGPSUpdate(const MoreData &basic)
+{
+  Refresh();
+}
@@ -0,0 +1,55 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LATENCY_STATUS_PANEL_HPP
+#define XCSOAR_LATENCY_STATUS_PANEL_HPP
+
+#include "StatusPanel.hpp"
+#include "Blackboard/RateLimitedBlackboardListener.hpp"
+
+/**
+ * Shows the #PipelineLatency statistics, i.e. how long it takes for
+ * data received from a device to be parsed, calculated and drawn.
+ */
+class LatencyStatusPanel final
+  : public StatusPanel,
+    private NullBlackboardListener {
+  RateLimitedBlackboardListener rate_limiter;
+
+public:
+  LatencyStatusPanel(const DialogLook &look);
+
+  /* virtual methods from class StatusPanel */
+  void Refresh() override;
+
+  /* virtual methods from class Widget */
+  void Prepare(ContainerWindow &parent, const PixelRect &rc) override;
+  void Show(const PixelRect &rc) override;
+  void Hide() override;
+
+private:
+  /* virtual methods from class BlackboardListener */
+  void OnGPSUpdate(const MoreData &basic) override;
+};
+
+#endif
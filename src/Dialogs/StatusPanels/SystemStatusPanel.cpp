@@ -39,6 +39,10 @@ enum Controls {
   Network,
 };
 
+SystemStatusPanel::SystemStatusPanel(const DialogLook &look)
+  :StatusPanel(look),
+   rate_limiter(CommonInterface::GetLiveBlackboard(), *this, 2000, 500) {}
+
 gcc_pure
 static const TCHAR *
 GetGPSStatus(const NMEAInfo &basic)
@@ -33,8 +33,7 @@ class SystemStatusPanel final
   RateLimitedBlackboardListener rate_limiter;
 
 public:
-  SystemStatusPanel(const DialogLook &look)
-    :StatusPanel(look), rate_limiter(*this, 2000, 500) {}
+  SystemStatusPanel(const DialogLook &look);
 
   /* virtual methods from class StatusPanel */
   void Refresh() override;
@@ -120,7 +120,7 @@ public:
   TargetWidget(ActionListener &_dialog,
                const DialogLook &dialog_look, const MapLook &map_look)
     :dialog(_dialog),
-     rate_limited_bl(*this, 1800, 300),
+     rate_limited_bl(CommonInterface::GetLiveBlackboard(), *this, 1800, 300),
      map(*this,
          map_look.waypoint, map_look.airspace,
          map_look.trail, map_look.task, map_look.aircraft,
@@ -209,7 +209,9 @@ public:
     SetTarget();
     UpdateNameButton();
 
-    CommonInterface::GetLiveBlackboard().AddListener(rate_limited_bl);
+    CommonInterface::GetLiveBlackboard()
+      .AddListener(rate_limited_bl, ToMask(BlackboardSection::TASK) |
+                   ToMask(BlackboardSection::POSITION));
   }
 
   void Hide() override {
@@ -162,7 +162,8 @@ FlarmTrafficDetailsWidget::Show(const PixelRect &rc)
 {
   RowFormWidget::Show(rc);
   Update();
-  CommonInterface::GetLiveBlackboard().AddListener(*this);
+  CommonInterface::GetLiveBlackboard()
+    .AddListener(*this, ToMask(BlackboardSection::TRAFFIC));
 }
 
 void
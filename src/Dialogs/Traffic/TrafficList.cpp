@@ -284,7 +284,11 @@ public:
     if (filter_widget != nullptr)
       UpdateList();
 
-    CommonInterface::GetLiveBlackboard().AddListener(*this);
+    CommonInterface::GetLiveBlackboard()
+      .AddListener(*this, ToMask(BlackboardSection::TRAFFIC) |
+                   /* distance and bearing depend on our own position */
+                   ToMask(BlackboardSection::POSITION) |
+                   ToMask(BlackboardSection::SKYLINES));
   }
 
   virtual void Hide() override {
@@ -33,6 +33,7 @@ Copyright_License {
 #include "StatusPanels/RulesStatusPanel.hpp"
 #include "StatusPanels/SystemStatusPanel.hpp"
 #include "StatusPanels/TimesStatusPanel.hpp"
+#include "StatusPanels/LatencyStatusPanel.hpp"
 #include "Components.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Interface.hpp"
@@ -100,6 +101,9 @@ dlgStatusShowModal(int start_page)
   Widget *times_panel = new TimesStatusPanel(look);
   widget.AddTab(times_panel, _("Times"), TimesIcon);
 
+  Widget *latency_panel = new LatencyStatusPanel(look);
+  widget.AddTab(latency_panel, _("Latency"));
+
   /* restore previous page */
 
   if (start_page != -1) {
@@ -26,7 +26,9 @@ Copyright_License {
 #ifndef ENABLE_OPENGL
 
 #include "MapWindow/GlueMapWindow.hpp"
+#include "FrameScheduler.hpp"
 #include "Hardware/CPU.hpp"
+#include "OS/Clock.hpp"
 
 /**
  * Main loop of the DrawThread
@@ -40,8 +42,26 @@ DrawThread::Run()
 
   // circle until application is closed
   while (!_CheckStoppedOrSuspended()) {
+    const FrameScheduler &scheduler = map.GetFrameScheduler();
+
     if (!pending) {
-      command_trigger.wait(mutex);
+      if (!scheduler.IsDegraded()) {
+        command_trigger.wait(mutex);
+        continue;
+      }
+
+      /* the last frame was drawn at reduced quality: redraw at full
+         quality as soon as the map has been idle for a while */
+      if (!command_trigger.timed_wait(mutex, FrameScheduler::IDLE_TIME))
+        pending = true;
+      continue;
+    }
+
+    const unsigned delay = scheduler.GetDelay(MonotonicClockMS());
+    if (delay > 0) {
+      /* too early for the next frame; all triggers which arrive
+         meanwhile are coalesced into one frame */
+      command_trigger.timed_wait(mutex, delay);
       continue;
     }
 
@@ -34,11 +34,10 @@ class GlueMapWindow;
  * which is why they are both handled by this thread.  The GaugeVario is
  * triggered on vario data which may be faster than GPS updates, which is
  * why it is not handled by this thread.
- * 
+ *
+ * The frame rate is limited by the MapWindow's #FrameScheduler.
  */
 class DrawThread final : public RecursivelySuspensibleThread {
-  static constexpr unsigned MIN_WAIT_TIME = 100;
-
   /**
    * Is work pending?  This flag gets cleared by the thread as soon as
    * it starts working.
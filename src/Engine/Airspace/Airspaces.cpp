@@ -30,6 +30,8 @@
 #include <boost/geometry/algorithms/intersection.hpp>
 #include <boost/geometry/strategies/strategies.hpp>
 
+#include <assert.h>
+
 namespace bgi = boost::geometry::index;
 
 Airspaces::const_iterator_range
@@ -102,9 +104,23 @@ Airspaces::Optimise()
     airspace_tree.clear();
   }
 
-  for (AbstractAirspace *i : tmp_as) {
-    Airspace as(*i, task_projection);
-    airspace_tree.insert(as);
+  if (airspace_tree.empty()) {
+    /* bulk load: calculate all envelopes first, then let Boost build
+       a packed tree in one pass, which is much faster than inserting
+       the airspaces one by one, and yields a better tree */
+    AirspaceVector v;
+    v.reserve(tmp_as.size());
+
+    for (AbstractAirspace *i : tmp_as)
+      v.emplace_back(*i, task_projection);
+
+    AirspaceTree packed(v.begin(), v.end());
+    airspace_tree.swap(packed);
+  } else {
+    for (AbstractAirspace *i : tmp_as) {
+      Airspace as(*i, task_projection);
+      airspace_tree.insert(as);
+    }
   }
 
   tmp_as.clear();
@@ -137,6 +153,25 @@ Airspaces::Add(AbstractAirspace *airspace)
   tmp_as.push_back(airspace);
 }
 
+void
+Airspaces::MoveFrom(Airspaces &other)
+{
+  assert(owns_children);
+  assert(other.owns_children);
+
+  for (const auto &i : other.QueryAll())
+    Add(&i.GetAirspace());
+
+  other.airspace_tree.clear();
+
+  for (AbstractAirspace *i : other.tmp_as)
+    Add(i);
+
+  other.tmp_as.clear();
+
+  ++other.serial;
+}
+
 void
 Airspaces::Clear()
 {
@@ -250,10 +285,9 @@ Airspaces::SynchroniseInRange(const Airspaces &master,
 
   for (auto &i : QueryAll())
     i.ClearClearance();
-  airspace_tree.clear();
 
-  for (const auto &i : contents_master)
-    airspace_tree.insert(i);
+  AirspaceTree packed(contents_master.begin(), contents_master.end());
+  airspace_tree.swap(packed);
 
   ++serial;
 
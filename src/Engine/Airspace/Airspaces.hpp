@@ -93,10 +93,19 @@ public:
    */
   void Add(AbstractAirspace *asp);
 
+  /**
+   * Move all airspaces (including those which have not been
+   * optimised yet) from the other container into this one.  Both
+   * containers must own their children.  Call Optimise() afterwards.
+   */
+  void MoveFrom(Airspaces &other);
+
   /**
    * Re-organise the internal airspace tree after inserting/deleting.
    * Should be called after inserting/deleting airspaces prior to performing
    * any searches, but can be done once after a batch insert/delete.
+   * If the tree is empty (e.g. after loading a file), it is
+   * bulk-loaded with the packing algorithm.
    */
   void Optimise();
 
@@ -0,0 +1,246 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_ARRIVAL_RASTER_HPP
+#define XCSOAR_ARRIVAL_RASTER_HPP
+
+#include "Geo/GeoBounds.hpp"
+#include "Compiler.h"
+
+#include <array>
+#include <algorithm>
+
+#include <assert.h>
+#include <stdint.h>
+
+/**
+ * The position and cell size of an #ArrivalRaster on the terrain
+ * grid, in terrain pixels.
+ */
+struct ArrivalGrid {
+  /**
+   * The maximum number of cells in each direction.
+   */
+  static constexpr unsigned MAX_SIZE = 64;
+
+  /**
+   * The north-west corner, a multiple of #cell.
+   */
+  int x, y;
+
+  /**
+   * The size of a cell in terrain pixels.
+   */
+  int cell;
+
+  unsigned width, height;
+
+  /**
+   * Integer division rounding towards negative infinity.
+   */
+  static constexpr int FloorDivide(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+  }
+
+  /**
+   * Choose a grid which covers the given range of terrain pixels
+   * (inclusive).  The cell size is chosen so the range fits into
+   * MAX_SIZE-1 cells, leaving one spare cell for snapping the origin
+   * to a multiple of the cell size.  That way, the cells stay in
+   * place while the range moves.
+   */
+  gcc_const
+  static ArrivalGrid Cover(int west, int north, int east, int south) {
+    assert(east >= west);
+    assert(south >= north);
+
+    constexpr int max_cells = MAX_SIZE - 1;
+    const int span = std::max(east - west, south - north) + 1;
+    const int cell = std::max(1, (span + max_cells - 1) / max_cells);
+
+    ArrivalGrid grid;
+    grid.cell = cell;
+    grid.x = FloorDivide(west, cell) * cell;
+    grid.y = FloorDivide(north, cell) * cell;
+    grid.width = (east - grid.x) / cell + 1;
+    grid.height = (south - grid.y) / cell + 1;
+    return grid;
+  }
+
+  bool operator==(const ArrivalGrid &other) const {
+    return x == other.x && y == other.y && cell == other.cell &&
+      width == other.width && height == other.height;
+  }
+};
+
+/**
+ * A low-resolution raster of arrival heights above terrain within
+ * the glide reach.  Its cells are aligned with the terrain grid (see
+ * #ArrivalGrid), so consecutive rasters line up while the aircraft
+ * moves.  The cells are calculated incrementally with Fill().
+ */
+class ArrivalRaster {
+public:
+  static constexpr unsigned MAX_SIZE = ArrivalGrid::MAX_SIZE;
+
+  /**
+   * Marks a cell which cannot be reached.
+   */
+  static constexpr int16_t UNREACHABLE = INT16_MIN;
+
+private:
+  GeoBounds bounds = GeoBounds::Invalid();
+
+  ArrivalGrid grid;
+
+  unsigned width = 0, height = 0;
+
+  /**
+   * The index of the next cell to be calculated by Fill().
+   */
+  unsigned next = 0;
+
+  /**
+   * Arrival heights above terrain in metres, row by row starting in
+   * the north-west corner.
+   */
+  std::array<int16_t, MAX_SIZE * MAX_SIZE> cells;
+
+public:
+  bool IsDefined() const {
+    return width > 0;
+  }
+
+  /**
+   * Have all cells been calculated since the last Reset() or
+   * Restart()?
+   */
+  bool IsComplete() const {
+    return IsDefined() && next == GetSize();
+  }
+
+  void Clear() {
+    bounds.SetInvalid();
+    width = height = 0;
+    next = 0;
+  }
+
+  /**
+   * Set up a new grid.  All cells are initialised as unreachable.
+   *
+   * @param _bounds the geographic bounds of #_grid
+   */
+  void Reset(const ArrivalGrid &_grid, const GeoBounds &_bounds) {
+    assert(_bounds.IsValid());
+    assert(_grid.width > 0 && _grid.width <= MAX_SIZE);
+    assert(_grid.height > 0 && _grid.height <= MAX_SIZE);
+
+    grid = _grid;
+    bounds = _bounds;
+    width = _grid.width;
+    height = _grid.height;
+    next = 0;
+    std::fill_n(cells.begin(), GetSize(), int16_t(UNREACHABLE));
+  }
+
+  /**
+   * Start recalculating all cells if the raster is already set up
+   * with the given grid.  The old cell values are kept until Fill()
+   * overwrites them.
+   *
+   * @return false if the grid is different, and Reset() must be
+   * called instead
+   */
+  bool Restart(const ArrivalGrid &_grid) {
+    if (!IsDefined() || !(_grid == grid))
+      return false;
+
+    next = 0;
+    return true;
+  }
+
+  /**
+   * Calculate up to #max_cells cells, continuing where the previous
+   * call left off.
+   *
+   * @param f a function which returns the arrival height (or
+   * #UNREACHABLE) at the given cell center
+   * @return true if the raster is complete
+   */
+  template<typename F>
+  bool Fill(unsigned max_cells, F &&f) {
+    const unsigned end = std::min(next + max_cells, GetSize());
+    for (; next < end; ++next)
+      cells[next] = f(GetCenter(next));
+
+    return IsComplete();
+  }
+
+  const GeoBounds &GetBounds() const {
+    return bounds;
+  }
+
+  unsigned GetWidth() const {
+    return width;
+  }
+
+  unsigned GetHeight() const {
+    return height;
+  }
+
+  unsigned GetSize() const {
+    return width * height;
+  }
+
+  /**
+   * Returns the north-west corner of the given cell.  Passing
+   * #width / #height returns the eastern / southern edge of the last
+   * column / row.
+   */
+  gcc_pure
+  GeoPoint GetCorner(unsigned x, unsigned y) const {
+    assert(x <= width);
+    assert(y <= height);
+
+    return GeoPoint(bounds.GetWest() + bounds.GetWidth() * x / width,
+                    bounds.GetNorth() - bounds.GetHeight() * y / height);
+  }
+
+  gcc_pure
+  GeoPoint GetCenter(unsigned i) const {
+    assert(i < GetSize());
+
+    const unsigned x = i % width, y = i / width;
+    return GeoPoint(bounds.GetWest() + bounds.GetWidth() * (x * 2 + 1) / (width * 2),
+                    bounds.GetNorth() - bounds.GetHeight() * (y * 2 + 1) / (height * 2));
+  }
+
+  int16_t Get(unsigned x, unsigned y) const {
+    assert(x < width);
+    assert(y < height);
+
+    return cells[y * width + x];
+  }
+};
+
+#endif
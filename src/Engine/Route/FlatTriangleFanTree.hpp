@@ -74,6 +74,14 @@ public:
 
   void CalcBB();
 
+  /**
+   * Returns the bounding box of this fan and all of its children.
+   * Valid after CalcBB().
+   */
+  const FlatBoundingBox &GetChildrenBoundingBox() const {
+    return bb_children;
+  }
+
   gcc_pure
   bool IsInside(FlatGeoPoint p) const {
     return FlatTriangleFan::IsInside(p, IsRoot());
@@ -24,6 +24,7 @@
 #include "Terrain/RasterMap.hpp"
 #include "ReachFanParms.hpp"
 #include "ReachResult.hpp"
+#include "Geo/GeoBounds.hpp"
 
 static constexpr int MIN_FLOOR_CLEARANCE = 100;
 
@@ -126,3 +127,12 @@ ReachFan::AcceptInRange(const GeoBounds &bounds,
   const FlatBoundingBox bb = projection.Project(bounds);
   root.AcceptInRange(bb, visitor);
 }
+
+GeoBounds
+ReachFan::GetBounds() const
+{
+  if (root.IsEmpty() || root.IsDummy())
+    return GeoBounds::Invalid();
+
+  return projection.Unproject(root.GetChildrenBoundingBox());
+}
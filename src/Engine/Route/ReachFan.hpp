@@ -61,6 +61,13 @@ public:
   void AcceptInRange(const GeoBounds &bounds,
                      FlatTriangleFanVisitor &visitor) const;
 
+  /**
+   * Returns the area covered by the reach, or an invalid object if
+   * no reach has been solved.
+   */
+  gcc_pure
+  GeoBounds GetBounds() const;
+
   int GetTerrainBase() const {
     return terrain_base;
   }
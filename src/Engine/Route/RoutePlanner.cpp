@@ -23,6 +23,7 @@
 #include "RoutePlanner.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/GeoBounds.hpp"
 
 RoutePlanner::RoutePlanner()
   :terrain(NULL), planner(0),
@@ -531,3 +532,9 @@ RoutePlanner::AcceptInRange(const GeoBounds &bounds,
   else
     reach_terrain.AcceptInRange(bounds, visitor);
 }
+
+GeoBounds
+RoutePlanner::GetTerrainReachBounds() const
+{
+  return reach_terrain.GetBounds();
+}
@@ -226,6 +226,12 @@ public:
     return reach_terrain.GetProjection();
   }
 
+  /**
+   * @see ReachFan::GetBounds()
+   */
+  gcc_pure
+  GeoBounds GetTerrainReachBounds() const;
+
   /** Visit reach (working or terrain reach) */
   void AcceptInRange(const GeoBounds &bounds,
                      FlatTriangleFanVisitor &visitor,
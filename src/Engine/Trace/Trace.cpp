@@ -429,6 +429,16 @@ Trace::SyncPoints(TracePointerVector &v) const
 void
 Trace::GetPoints(TracePointVector &v, unsigned min_time,
                  const GeoPoint &location, double min_distance) const
+{
+  if (empty())
+    return;
+
+  GetPoints(v, min_time, ProjectRange(location, min_distance));
+}
+
+void
+Trace::GetPoints(TracePointVector &v, unsigned min_time,
+                 unsigned range) const
 {
   /* skip the trace points that are before min_time */
   Trace::const_iterator i = begin(), end = this->end();
@@ -449,10 +459,31 @@ Trace::GetPoints(TracePointVector &v, unsigned min_time,
   assert(skipped < size());
 
   v.reserve(size() - skipped);
-  const unsigned range = ProjectRange(location, min_distance);
   const unsigned sq_range = range * range;
   do {
     v.push_back(*i);
     i.NextSquareRange(sq_range, end);
   } while (i != end);
 }
+
+void
+Trace::SyncPoints(TracePointVector &v, unsigned range) const
+{
+  assert(!v.empty());
+
+  /* find the last point of the vector, searching backwards because
+     usually only few points have been appended */
+  const unsigned last_time = v.back().GetTime();
+  Trace::const_iterator i = end();
+  do {
+    if (i == begin())
+      return;
+
+    --i;
+  } while (i->GetTime() > last_time);
+
+  const Trace::const_iterator end = this->end();
+  const unsigned sq_range = range * range;
+  while (i.NextSquareRange(sq_range, end) != end)
+    v.push_back(*i);
+}
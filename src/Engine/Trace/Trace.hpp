@@ -397,6 +397,20 @@ public:
   void GetPoints(TracePointVector &v, unsigned min_time,
                  const GeoPoint &location, double resolution) const;
 
+  /**
+   * Fill the vector with trace points, not before #min_time, minimum
+   * resolution #range (in #TaskProjection units, see ProjectRange()).
+   */
+  void GetPoints(TracePointVector &v, unsigned min_time,
+                 unsigned range) const;
+
+  /**
+   * Update a #TracePointVector obtained by GetPoints() with the same
+   * #range after points were appended to this object.  This must not
+   * be called after thinning has occurred, see GetModifySerial().
+   */
+  void SyncPoints(TracePointVector &v, unsigned range) const;
+
   const TracePoint &front() const {
     assert(!empty());
 
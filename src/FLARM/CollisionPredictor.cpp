@@ -0,0 +1,190 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CollisionPredictor.hpp"
+#include "Util/Clamp.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+#include <math.h>
+
+/**
+ * Added to the squared segment length to avoid a division by zero
+ * when both aircraft move in parallel.
+ */
+static constexpr double EPSILON = 1e-6;
+
+/**
+ * A later approach must be closer than the best one by this factor
+ * (applied to the squared distance) to replace it.  Without this
+ * margin, rounding errors may pick a later revolution of a circling
+ * target, while the first one is the one that matters.
+ */
+static constexpr double IMPROVEMENT = 0.999;
+
+constexpr double CollisionPredictor::MAX_TURN_RATE;
+
+/**
+ * The per-second displacement of an aircraft along its arc, and the
+ * rotation which is applied to it after each second.
+ */
+struct ArcStep {
+  double east, north;
+  double rotate_cos, rotate_sin;
+
+  explicit ArcStep(const CollisionPredictor::Motion &motion) {
+    const double turn_rate =
+      Clamp(motion.turn_rate, -CollisionPredictor::MAX_TURN_RATE,
+            CollisionPredictor::MAX_TURN_RATE);
+
+    /* the chord of a circular arc has the direction of the tangent
+       at half the arc, and is shorter than the arc by
+       sin(x)/x */
+    const Angle half = Angle::Degrees(turn_rate / 2);
+    const double x = half.Radians();
+    const double chord = fabs(x) > EPSILON
+      ? motion.speed * sin(x) / x
+      : motion.speed;
+
+    const auto sc = (motion.track + half).SinCos();
+    east = chord * sc.first;
+    north = chord * sc.second;
+
+    const auto rotate = Angle::Degrees(turn_rate).SinCos();
+    rotate_sin = rotate.first;
+    rotate_cos = rotate.second;
+  }
+
+  void Next() {
+    const double e = east, n = north;
+    east = e * rotate_cos + n * rotate_sin;
+    north = n * rotate_cos - e * rotate_sin;
+  }
+};
+
+unsigned
+CollisionPredictor::Add(double north, double east, const Motion &target)
+{
+  assert(!full());
+
+  const ArcStep step(target);
+
+  const unsigned i = n++;
+  rel_east[i] = east;
+  rel_north[i] = north;
+  step_east[i] = step.east;
+  step_north[i] = step.north;
+  rotate_cos[i] = step.rotate_cos;
+  rotate_sin[i] = step.rotate_sin;
+  best_distance_sq[i] = east * east + north * north;
+  best_time[i] = 0;
+  return i;
+}
+
+void
+CollisionPredictor::Solve(const Motion &own)
+{
+  float own_east[HORIZON], own_north[HORIZON];
+
+  ArcStep own_step(own);
+  for (unsigned k = 0; k < HORIZON; ++k) {
+    own_east[k] = own_step.east;
+    own_north[k] = own_step.north;
+    own_step.Next();
+  }
+
+  /* the loop over all targets has no branches and no dependencies
+     between iterations, which allows the compiler to vectorise it */
+  for (unsigned k = 0; k < HORIZON; ++k) {
+    const float oe = own_east[k], on = own_north[k];
+    const float t0 = k;
+
+    for (unsigned i = 0; i < n; ++i) {
+      /* relative movement during this step */
+      const float de = step_east[i] - oe, dn = step_north[i] - on;
+      const float re = rel_east[i], rn = rel_north[i];
+
+      /* closest point on this segment */
+      float u = -(re * de + rn * dn) / (de * de + dn * dn + float(EPSILON));
+      u = std::min(std::max(u, 0.f), 1.f);
+
+      const float qe = re + u * de, qn = rn + u * dn;
+      const float d = qe * qe + qn * qn;
+
+      /* blend instead of selecting: gcc does not if-convert two
+         conditional stores, and would not vectorise this loop */
+      const float bd = best_distance_sq[i], bt = best_time[i];
+      const float better = d < bd * float(IMPROVEMENT) ? 1.f : 0.f;
+      best_distance_sq[i] = bd + better * (d - bd);
+      best_time[i] = bt + better * (t0 + u - bt);
+
+      rel_east[i] = re + de;
+      rel_north[i] = rn + dn;
+
+      const float se = step_east[i], sn = step_north[i];
+      step_east[i] = se * rotate_cos[i] + sn * rotate_sin[i];
+      step_north[i] = sn * rotate_cos[i] - se * rotate_sin[i];
+    }
+  }
+}
+
+CollisionPredictor::Result
+CollisionPredictor::Get(unsigned i) const
+{
+  assert(i < n);
+
+  return Result{best_time[i], sqrt(best_distance_sq[i])};
+}
+
+CollisionPredictor::Result
+CollisionPredictor::SolveScalar(double north, double east,
+                                const Motion &target, const Motion &own)
+{
+  ArcStep target_step(target), own_step(own);
+
+  double best = east * east + north * north, best_time = 0;
+
+  for (unsigned k = 0; k < HORIZON; ++k) {
+    const double de = target_step.east - own_step.east;
+    const double dn = target_step.north - own_step.north;
+
+    double u = -(east * de + north * dn) / (de * de + dn * dn + EPSILON);
+    u = Clamp(u, 0., 1.);
+
+    const double qe = east + u * de, qn = north + u * dn;
+    const double d = qe * qe + qn * qn;
+    if (d < best * IMPROVEMENT) {
+      best = d;
+      best_time = k + u;
+    }
+
+    east += de;
+    north += dn;
+
+    target_step.Next();
+    own_step.Next();
+  }
+
+  return Result{best_time, sqrt(best)};
+}
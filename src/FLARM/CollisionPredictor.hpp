@@ -0,0 +1,137 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLARM_COLLISION_PREDICTOR_HPP
+#define XCSOAR_FLARM_COLLISION_PREDICTOR_HPP
+
+#include "FLARM/List.hpp"
+#include "Math/Angle.hpp"
+#include "Compiler.h"
+
+/**
+ * Predicts the closest point of approach (CPA) between the own
+ * aircraft and a batch of traffic targets.
+ *
+ * Every aircraft is extrapolated along a circular arc, assuming
+ * constant ground speed and turn rate.  The trajectories are sampled
+ * once per second up to #HORIZON, and the minimum distance is
+ * searched on the straight segments between the samples.
+ *
+ * The targets are stored as a structure of arrays in single
+ * precision, so the inner loop over all targets can be vectorised
+ * by the compiler.
+ */
+class CollisionPredictor {
+public:
+  static constexpr unsigned MAX_TARGETS = TrafficList::MAX_COUNT;
+
+  /**
+   * How far into the future shall the trajectories be extrapolated?
+   * [s]
+   */
+  static constexpr unsigned HORIZON = 30;
+
+  /**
+   * Turn rates are clipped to this value [deg/s], to tame noisy
+   * values which were calculated from position differences.
+   */
+  static constexpr double MAX_TURN_RATE = 30;
+
+  struct Motion {
+    /** Ground speed [m/s] */
+    double speed;
+
+    /** Ground track */
+    Angle track;
+
+    /** Turn rate [deg/s]; positive values turn right */
+    double turn_rate;
+  };
+
+  struct Result {
+    /** Time until the closest point of approach [s] */
+    double time;
+
+    /** Horizontal distance at the closest point of approach [m] */
+    double distance;
+  };
+
+private:
+  unsigned n;
+
+  /* relative position of the target [m] */
+  float rel_east[MAX_TARGETS], rel_north[MAX_TARGETS];
+
+  /* displacement of the target during the next step [m] */
+  float step_east[MAX_TARGETS], step_north[MAX_TARGETS];
+
+  /* rotation of the displacement vector per step */
+  float rotate_cos[MAX_TARGETS], rotate_sin[MAX_TARGETS];
+
+  float best_distance_sq[MAX_TARGETS], best_time[MAX_TARGETS];
+
+public:
+  CollisionPredictor():n(0) {}
+
+  void Clear() {
+    n = 0;
+  }
+
+  unsigned size() const {
+    return n;
+  }
+
+  bool full() const {
+    return n >= MAX_TARGETS;
+  }
+
+  /**
+   * Add a target to the batch.
+   *
+   * @param north the relative position of the target [m]
+   * @param east the relative position of the target [m]
+   * @return the index of the target, to be passed to Get()
+   */
+  unsigned Add(double north, double east, const Motion &target);
+
+  /**
+   * Predict the closest point of approach for all targets which were
+   * added since the last Clear() call.  This consumes the input;
+   * call it only once per batch.
+   */
+  void Solve(const Motion &own);
+
+  gcc_pure
+  Result Get(unsigned i) const;
+
+  /**
+   * A scalar double precision implementation of the same algorithm
+   * for one target.  It is a reference for unit tests and
+   * benchmarks.
+   */
+  gcc_pure
+  static Result SolveScalar(double north, double east,
+                            const Motion &target, const Motion &own);
+};
+
+#endif
@@ -23,23 +23,15 @@ Copyright_License {
 
 #include "FLARM/FlarmCalculations.hpp"
 
-double
-FlarmCalculations::Average30s(FlarmId id, double time, double altitude)
-{
-  ClimbAverageCalculator &item = averageCalculatorMap[id];
-  return item.GetAverage(time, altitude, 30);
-}
-
 void
 FlarmCalculations::CleanUp(double now)
 {
   static constexpr double MAX_AGE = 60;
 
-  // Iterate through ClimbAverageCalculators and remove expired ones
-  for (auto it = averageCalculatorMap.begin(),
-       it_end = averageCalculatorMap.end(); it != it_end;)
-    if (it->second.Expired(now, MAX_AGE))
-      it = averageCalculatorMap.erase(it);
+  // Iterate through the targets and remove expired ones
+  for (auto it = targets.begin(), it_end = targets.end(); it != it_end;)
+    if (now < it->second.last_seen || now > it->second.last_seen + MAX_AGE)
+      it = targets.erase(it);
     else
       ++it;
 }
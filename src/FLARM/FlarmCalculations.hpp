@@ -26,17 +26,57 @@ Copyright_License {
 
 #include "FLARM/FlarmId.hpp"
 #include "Computer/ClimbAverageCalculator.hpp"
+#include "Util/StaticString.hxx"
 
 #include <map>
 
 class FlarmCalculations
 {
+public:
+  /**
+   * Per-target state which survives across merges.  The
+   * #TrafficList is rebuilt from the device data on every merge, so
+   * anything expensive to obtain is kept here.  The map
+   * value-initialises new entries, which clears all members.
+   */
+  struct Target {
+    /**
+     * When was this target last processed?  Used to expire the
+     * entry.
+     */
+    double last_seen;
+
+    ClimbAverageCalculator climb;
+
+    /**
+     * The cached result of FlarmDetails::LookupCallsign(); empty if
+     * the target is unknown.
+     */
+    StaticString<10> callsign;
+
+    /**
+     * The FlarmDetails::GetSerial() value at the time #callsign was
+     * resolved.  The cached callsign is stale if it differs.
+     */
+    unsigned callsign_serial = 0;
+
+    bool callsign_resolved = false;
+  };
+
 private:
-  typedef std::map<FlarmId, ClimbAverageCalculator> AverageCalculatorMap;
-  AverageCalculatorMap averageCalculatorMap;
+  typedef std::map<FlarmId, Target> TargetMap;
+  TargetMap targets;
 
 public:
-  double Average30s(FlarmId flarmId, double curTime, double curAltitude);
+  /**
+   * Returns the state of the specified target, creating it if it
+   * does not exist yet.
+   */
+  Target &GetTarget(FlarmId id, double time) {
+    Target &target = targets[id];
+    target.last_seen = time;
+    return target;
+  }
 
   void CleanUp(double now);
 };
@@ -23,21 +23,40 @@ Copyright_License {
 
 #include "FLARM/FlarmComputer.hpp"
 #include "FLARM/FlarmDetails.hpp"
-#include "NMEA/Info.hpp"
+#include "NMEA/MoreData.hpp"
 #include "Geo/GeoVector.hpp"
 
+/**
+ * Add the target to the collision prediction batch, and mark it for
+ * PredictCollisions().  Targets must be added in list order.
+ */
+static void
+AddTarget(CollisionPredictor &predictor, FlarmTraffic &traffic)
+{
+  const CollisionPredictor::Motion motion{
+    traffic.speed, traffic.track, traffic.turn_rate,
+  };
+
+  predictor.Add(traffic.relative_north, traffic.relative_east, motion);
+  traffic.cpa_available = true;
+}
+
 void
 FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
-                       const NMEAInfo &basic)
+                       const MoreData &basic)
 {
   // Cleanup old calculation instances
   if (basic.time_available)
     flarm_calculations.CleanUp(basic.time);
 
+  UpdateTurnRate(basic);
+
   // if (FLARM data is available)
   if (!flarm.IsDetected())
     return;
 
+  collision_predictor.Clear();
+
   double north_to_latitude(0);
   double east_to_longitude(0);
 
@@ -61,14 +80,31 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
     }
   }
 
+  const unsigned serial = FlarmDetails::GetSerial();
+
   // for each item in traffic
   for (auto &traffic : flarm.traffic.list) {
+    FlarmCalculations::Target &target =
+      flarm_calculations.GetTarget(traffic.id, basic.time);
+
+    traffic.cpa_available = false;
+
     // if we don't know the target's name yet
     if (!traffic.HasName()) {
-      // lookup the name of this target's id
-      const TCHAR *fname = FlarmDetails::LookupCallsign(traffic.id);
-      if (fname != NULL)
-        traffic.name = fname;
+      /* the database lookup is done only once per target; unknown
+         targets are remembered as well */
+      if (!target.callsign_resolved || target.callsign_serial != serial) {
+        const TCHAR *fname = FlarmDetails::LookupCallsign(traffic.id);
+        if (fname != NULL)
+          target.callsign = fname;
+        else
+          target.callsign.clear();
+
+        target.callsign_serial = serial;
+        target.callsign_resolved = true;
+      }
+
+      traffic.name = target.callsign;
     }
 
     // Calculate distance
@@ -95,19 +131,26 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
     traffic.climb_rate_avg30s_available = traffic.altitude_available;
     if (traffic.climb_rate_avg30s_available)
       traffic.climb_rate_avg30s =
-        flarm_calculations.Average30s(traffic.id, basic.time, traffic.altitude);
+        target.climb.GetAverage(basic.time, traffic.altitude, 30);
 
     // The following calculations are only relevant for targets
     // where information is missing
     if (traffic.track_received && traffic.turn_rate_received &&
-        traffic.speed_received && traffic.climb_rate_received)
+        traffic.speed_received && traffic.climb_rate_received) {
+      AddTarget(collision_predictor, traffic);
       continue;
+    }
 
     // Check if the target has been seen before in the last seconds
     const FlarmTraffic *last_traffic =
       last_flarm.traffic.FindTraffic(traffic.id);
-    if (last_traffic == NULL || !last_traffic->valid)
+    if (last_traffic == NULL || !last_traffic->valid) {
+      /* without history, the motion is only known if the FLARM has
+         sent it */
+      if (traffic.track_received && traffic.speed_received)
+        AddTarget(collision_predictor, traffic);
       continue;
+    }
 
     // Calculate the time difference between now and the last contact
     double dt = traffic.valid.GetTimeDifference(last_traffic->valid);
@@ -154,5 +197,69 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
       if (!traffic.speed_received)
         traffic.speed = last_traffic->speed;
     }
+
+    AddTarget(collision_predictor, traffic);
+  }
+
+  PredictCollisions(flarm, basic);
+}
+
+void
+FlarmComputer::UpdateTurnRate(const MoreData &basic)
+{
+  if (!basic.track_available || !basic.time_available) {
+    last_track_time = -1;
+    turn_rate = 0;
+    return;
+  }
+
+  const double dt = basic.time - last_track_time;
+  if (last_track_time >= 0 && dt > 0 && dt < 5) {
+    const double current =
+      (basic.track - last_track).AsDelta().Degrees() / dt;
+
+    /* low-pass filter against GPS track noise */
+    turn_rate = (turn_rate + current) / 2;
+  } else if (dt != 0)
+    turn_rate = 0;
+
+  if (dt != 0) {
+    last_track = basic.track;
+    last_track_time = basic.time;
+  }
+}
+
+void
+FlarmComputer::PredictCollisions(FlarmData &flarm, const MoreData &basic)
+{
+  if (collision_predictor.size() == 0)
+    return;
+
+  if (!basic.track_available || !basic.ground_speed_available) {
+    for (auto &traffic : flarm.traffic.list)
+      traffic.cpa_available = false;
+    return;
+  }
+
+  const CollisionPredictor::Motion own{
+    basic.ground_speed, basic.track, turn_rate,
+  };
+
+  collision_predictor.Solve(own);
+
+  const double own_climb_rate =
+    basic.gps_vario_available ? basic.gps_vario : 0;
+
+  /* the targets were added in list order */
+  unsigned i = 0;
+  for (auto &traffic : flarm.traffic.list) {
+    if (!traffic.cpa_available)
+      continue;
+
+    const auto result = collision_predictor.Get(i++);
+    traffic.cpa_time = result.time;
+    traffic.cpa_distance = result.distance;
+    traffic.cpa_relative_altitude = double(traffic.relative_altitude) +
+      (traffic.climb_rate - own_climb_rate) * result.time;
   }
 }
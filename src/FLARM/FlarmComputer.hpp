@@ -25,20 +25,43 @@ Copyright_License {
 #define XCSOAR_FLARM_COMPUTER_HPP
 
 #include "FLARM/FlarmCalculations.hpp"
+#include "FLARM/CollisionPredictor.hpp"
+#include "Math/Angle.hpp"
 
 struct FlarmData;
-struct NMEAInfo;
+struct MoreData;
 
 class FlarmComputer {
   FlarmCalculations flarm_calculations;
 
+  CollisionPredictor collision_predictor;
+
+  /**
+   * The own track and time of the previous Process() call, used to
+   * calculate the own turn rate.
+   */
+  Angle last_track;
+  double last_track_time;
+
+  /** The smoothed own turn rate [deg/s] */
+  double turn_rate;
+
 public:
+  FlarmComputer()
+    :last_track(Angle::Zero()), last_track_time(-1), turn_rate(0) {}
+
   /**
    * Calculates location, altitude, average climb speed and
-   * looks up the callsign of each target
+   * looks up the callsign of each target, and predicts the closest
+   * point of approach
    */
   void Process(FlarmData &flarm, const FlarmData &last_flarm,
-               const NMEAInfo &basic);
+               const MoreData &basic);
+
+private:
+  void UpdateTurnRate(const MoreData &basic);
+
+  void PredictCollisions(FlarmData &flarm, const MoreData &basic);
 };
 
 #endif
@@ -27,8 +27,16 @@ Copyright_License {
 #include "FLARM/FlarmId.hpp"
 #include "Util/StringCompare.hxx"
 
+#include <atomic>
+
 #include <assert.h>
 
+/**
+ * Incremented by Invalidate() in the main thread, read by
+ * #FlarmComputer in the MergeThread.
+ */
+static std::atomic<unsigned> serial;
+
 const FlarmNetRecord *
 FlarmDetails::LookupRecord(FlarmId id)
 {
@@ -48,6 +56,18 @@ FlarmDetails::LookupCallsign(FlarmId id)
   return traffic_databases->FindNameById(id);
 }
 
+unsigned
+FlarmDetails::GetSerial()
+{
+  return serial;
+}
+
+void
+FlarmDetails::Invalidate()
+{
+  ++serial;
+}
+
 FlarmId
 FlarmDetails::LookupId(const TCHAR *cn)
 {
@@ -62,6 +82,7 @@ FlarmDetails::AddSecondaryItem(FlarmId id, const TCHAR *name)
   assert(id.IsDefined());
   assert(traffic_databases != nullptr);
 
+  Invalidate();
   return traffic_databases->flarm_names.Set(id, name);
 }
 
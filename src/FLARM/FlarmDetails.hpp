@@ -48,6 +48,20 @@ namespace FlarmDetails
   const TCHAR *
   LookupCallsign(FlarmId id);
 
+  /**
+   * Returns a number which changes whenever the result of
+   * LookupCallsign() may have changed.  Callers which cache
+   * callsigns compare it to discard stale entries.
+   */
+  unsigned
+  GetSerial();
+
+  /**
+   * Announce that the databases have been modified or replaced.
+   */
+  void
+  Invalidate();
+
   /**
    * Looks up the callsign in the FLARM details array
    * and the FLARMnet file and returns the FLARM id
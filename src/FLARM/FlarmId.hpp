@@ -65,6 +65,14 @@ public:
     return value < other.value;
   }
 
+  /**
+   * Returns a value suitable for hash tables.  Equal ids have equal
+   * hashes.
+   */
+  constexpr uint32_t GetHash() const {
+    return value;
+  }
+
   static FlarmId Parse(const char *input, char **endptr_r);
 #ifdef _UNICODE
   static FlarmId Parse(const TCHAR *input, TCHAR **endptr_r);
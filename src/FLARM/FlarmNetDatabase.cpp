@@ -22,10 +22,97 @@ Copyright_License {
 */
 
 #include "FlarmNetDatabase.hpp"
+#include "OS/FileMapping.hpp"
 #include "Util/StringUtil.hpp"
 
+#include <algorithm>
+#include <type_traits>
+
 #include <assert.h>
 
+static_assert(std::is_trivially_copyable<FlarmId>::value &&
+              sizeof(FlarmId) == sizeof(uint32_t),
+              "FlarmId cannot be stored in the binary cache");
+static_assert(std::is_trivially_copyable<FlarmNetRecord>::value,
+              "FlarmNetRecord cannot be stored in the binary cache");
+static_assert(alignof(FlarmNetRecord) <= alignof(uint32_t),
+              "FlarmNetRecord alignment not supported");
+
+struct FlarmNetCacheHeader {
+  static constexpr uint32_t MAGIC = 0x464e4244;
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t magic, version;
+
+  /**
+   * sizeof(FlarmNetRecord) of the build which wrote the file; it
+   * differs between builds with different character types.
+   */
+  uint32_t record_size;
+
+  uint32_t n_records, n_callsigns;
+
+  /*
+   * followed by:
+   *   FlarmId ids[n_records];
+   *   uint32_t callsign_index[n_callsigns];
+   *   FlarmNetRecord records[n_records];
+   */
+
+  /**
+   * Calculated in 64 bit, so the untrusted counts cannot make it
+   * wrap around on 32 bit targets.
+   */
+  uint64_t GetPayloadSize() const {
+    return uint64_t(n_records) * (sizeof(FlarmId) + sizeof(FlarmNetRecord)) +
+      uint64_t(n_callsigns) * sizeof(uint32_t);
+  }
+};
+
+template<typename T, size_t max>
+gcc_pure
+static bool
+IsTerminated(const StaticStringBase<T, max> &s)
+{
+  const T *p = s.c_str(), *end = p + s.capacity();
+  return std::find(p, end, T(0)) != end;
+}
+
+/**
+ * Does each string in the record have a terminator within its
+ * buffer?  A record from a corrupt cache file might not.
+ */
+gcc_pure
+static bool
+IsTerminated(const FlarmNetRecord &record)
+{
+  return IsTerminated(record.id) && IsTerminated(record.pilot) &&
+    IsTerminated(record.airfield) && IsTerminated(record.plane_type) &&
+    IsTerminated(record.registration) && IsTerminated(record.callsign) &&
+    IsTerminated(record.frequency);
+}
+
+FlarmNetDatabase::FlarmNetDatabase()
+  :records(nullptr), ids(nullptr), callsign_index(nullptr),
+   n_records(0), n_callsigns(0) {}
+
+FlarmNetDatabase::~FlarmNetDatabase() = default;
+
+void
+FlarmNetDatabase::Clear()
+{
+  pending.clear();
+  record_storage.clear();
+  id_storage.clear();
+  callsign_storage.clear();
+  mapping.reset();
+
+  records = nullptr;
+  ids = nullptr;
+  callsign_index = nullptr;
+  n_records = n_callsigns = 0;
+}
+
 void
 FlarmNetDatabase::Insert(const FlarmNetRecord &record)
 {
@@ -34,21 +121,183 @@ FlarmNetDatabase::Insert(const FlarmNetRecord &record)
     /* ignore malformed records */
     return;
 
-  map.insert(std::make_pair(id, record));
+  pending.push_back(record);
 }
 
-const FlarmNetRecord *
-FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+void
+FlarmNetDatabase::BuildIndex()
 {
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  if (pending.empty())
+    return;
+
+  /* merge the existing records (they may come from a mapped
+     cache) */
+  pending.insert(pending.begin(), begin(), end());
 
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      return &record;
+  struct Item {
+    FlarmId id;
+    unsigned position;
+  };
+
+  std::vector<Item> items;
+  items.reserve(pending.size());
+  for (unsigned i = 0; i < pending.size(); ++i)
+    items.push_back({pending[i].GetId(), i});
+
+  /* stable, so the first of several duplicate ids wins */
+  std::stable_sort(items.begin(), items.end(),
+                   [](const Item &a, const Item &b){
+                     return a.id < b.id;
+                   });
+
+  std::vector<FlarmNetRecord> new_records;
+  std::vector<FlarmId> new_ids;
+  new_records.reserve(items.size());
+  new_ids.reserve(items.size());
+
+  for (const auto &item : items) {
+    if (!new_ids.empty() && new_ids.back() == item.id)
+      continue;
+
+    new_ids.push_back(item.id);
+    new_records.push_back(pending[item.position]);
   }
 
-  return NULL;
+  std::vector<uint32_t> new_callsigns;
+  for (unsigned i = 0; i < new_records.size(); ++i)
+    if (!new_records[i].callsign.empty())
+      new_callsigns.push_back(i);
+
+  std::stable_sort(new_callsigns.begin(), new_callsigns.end(),
+                   [&new_records](uint32_t a, uint32_t b){
+                     return _tcscmp(new_records[a].callsign,
+                                    new_records[b].callsign) < 0;
+                   });
+
+  pending.clear();
+  pending.shrink_to_fit();
+  mapping.reset();
+
+  record_storage = std::move(new_records);
+  id_storage = std::move(new_ids);
+  callsign_storage = std::move(new_callsigns);
+
+  records = record_storage.data();
+  ids = id_storage.data();
+  callsign_index = callsign_storage.data();
+  n_records = record_storage.size();
+  n_callsigns = callsign_storage.size();
+}
+
+bool
+FlarmNetDatabase::SaveCache(FILE *file) const
+{
+  assert(pending.empty());
+
+  FlarmNetCacheHeader header;
+  header.magic = FlarmNetCacheHeader::MAGIC;
+  header.version = FlarmNetCacheHeader::VERSION;
+  header.record_size = sizeof(FlarmNetRecord);
+  header.n_records = n_records;
+  header.n_callsigns = n_callsigns;
+
+  return fwrite(&header, sizeof(header), 1, file) == 1 &&
+    fwrite(ids, sizeof(*ids), n_records, file) == n_records &&
+    fwrite(callsign_index, sizeof(*callsign_index), n_callsigns,
+           file) == n_callsigns &&
+    fwrite(records, sizeof(*records), n_records, file) == n_records;
+}
+
+bool
+FlarmNetDatabase::LoadCache(std::unique_ptr<FileMapping> &&_mapping,
+                            size_t offset)
+{
+  assert(_mapping);
+
+  if (_mapping->error() || offset % alignof(uint32_t) != 0 ||
+      _mapping->size() < offset + sizeof(FlarmNetCacheHeader))
+    return false;
+
+  FlarmNetCacheHeader header;
+  std::copy_n((const char *)_mapping->at(offset), sizeof(header),
+              (char *)&header);
+
+  /* each callsign refers to a different record, and each record
+     occupies more than one byte of the file; this bounds both
+     counts before they are multiplied */
+  if (header.magic != FlarmNetCacheHeader::MAGIC ||
+      header.version != FlarmNetCacheHeader::VERSION ||
+      header.record_size != sizeof(FlarmNetRecord) ||
+      header.n_records > _mapping->size() ||
+      header.n_callsigns > header.n_records ||
+      uint64_t(_mapping->size()) !=
+      uint64_t(offset) + sizeof(header) + header.GetPayloadSize())
+    return false;
+
+  const char *p = (const char *)_mapping->at(offset + sizeof(header));
+  const FlarmId *new_ids = (const FlarmId *)p;
+  p += header.n_records * sizeof(FlarmId);
+  const uint32_t *new_callsigns = (const uint32_t *)p;
+  p += header.n_callsigns * sizeof(uint32_t);
+  const FlarmNetRecord *new_records = (const FlarmNetRecord *)p;
+
+  for (unsigned i = 0; i < header.n_callsigns; ++i)
+    if (new_callsigns[i] >= header.n_records)
+      return false;
+
+  for (unsigned i = 0; i < header.n_records; ++i)
+    if (!IsTerminated(new_records[i]))
+      return false;
+
+  Clear();
+
+  mapping = std::move(_mapping);
+  records = new_records;
+  ids = new_ids;
+  callsign_index = new_callsigns;
+  n_records = header.n_records;
+  n_callsigns = header.n_callsigns;
+  return true;
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindRecordById(FlarmId id) const
+{
+  const FlarmId *end = ids + n_records;
+  const FlarmId *i = std::lower_bound(ids, end, id);
+  return i != end && *i == id
+    ? &records[i - ids]
+    : nullptr;
+}
+
+std::pair<const uint32_t *, const uint32_t *>
+FlarmNetDatabase::FindCallSign(const TCHAR *cn) const
+{
+  assert(cn != nullptr);
+
+  struct Compare {
+    const FlarmNetRecord *records;
+
+    bool operator()(uint32_t a, const TCHAR *b) const {
+      return _tcscmp(records[a].callsign, b) < 0;
+    }
+
+    bool operator()(const TCHAR *a, uint32_t b) const {
+      return _tcscmp(a, records[b].callsign) < 0;
+    }
+  };
+
+  return std::equal_range(callsign_index, callsign_index + n_callsigns,
+                          cn, Compare{records});
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+{
+  const auto range = FindCallSign(cn);
+  return range.first != range.second
+    ? &records[*range.first]
+    : nullptr;
 }
 
 unsigned
@@ -58,13 +307,9 @@ FlarmNetDatabase::FindRecordsByCallSign(const TCHAR *cn,
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
-
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = &record;
-  }
+  const auto range = FindCallSign(cn);
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = &records[*i];
 
   return count;
 }
@@ -75,13 +320,9 @@ FlarmNetDatabase::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
-
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = i.first;
-  }
+  const auto range = FindCallSign(cn);
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = ids[*i];
 
   return count;
 }
@@ -28,39 +28,102 @@ Copyright_License {
 #include "FlarmNetRecord.hpp"
 #include "Compiler.h"
 
-#include <map>
+#include <memory>
+#include <vector>
+
+#include <stdint.h>
+#include <stdio.h>
 #include <tchar.h>
 
+class FileMapping;
+
 /**
  * An in-memory representation of the FlarmNet.org database.
+ *
+ * The records are sorted by FLARM id, with a parallel array of ids
+ * for binary search and an index of record numbers sorted by
+ * callsign.  This layout can be written to a binary cache file with
+ * SaveCache(), and later be memory-mapped with LoadCache() instead
+ * of parsing the text file again.
  */
 class FlarmNetDatabase {
-  typedef std::map<FlarmId, FlarmNetRecord> RecordMap;
-  RecordMap map;
+  /**
+   * Records which were inserted, but are not in the index yet.
+   */
+  std::vector<FlarmNetRecord> pending;
+
+  /* the index, if it was built in memory */
+  std::vector<FlarmNetRecord> record_storage;
+  std::vector<FlarmId> id_storage;
+  std::vector<uint32_t> callsign_storage;
+
+  /**
+   * The index, if it was loaded from the binary cache.
+   */
+  std::unique_ptr<FileMapping> mapping;
+
+  /* views on either of the above */
+  const FlarmNetRecord *records;
+  const FlarmId *ids;
+  const uint32_t *callsign_index;
+  unsigned n_records, n_callsigns;
 
 public:
+  FlarmNetDatabase();
+  ~FlarmNetDatabase();
+
+  FlarmNetDatabase(const FlarmNetDatabase &) = delete;
+  FlarmNetDatabase &operator=(const FlarmNetDatabase &) = delete;
+
   bool IsEmpty() const {
-    return map.empty();
+    return n_records == 0 && pending.empty();
   }
 
-  void Clear() {
-    map.clear();
+  unsigned size() const {
+    return n_records;
   }
 
+  void Clear();
+
+  /**
+   * Add a record.  It will not be found before BuildIndex() is
+   * called.  If there are several records with the same id, the
+   * first one wins.
+   */
   void Insert(const FlarmNetRecord &record);
 
+  /**
+   * Sort the inserted records into the index.
+   */
+  void BuildIndex();
+
+  /**
+   * Write the index to a binary file, which can be loaded with
+   * LoadCache().  The format depends on the build (byte order,
+   * character type), which is why it is only useful as a cache.
+   *
+   * @return true on success
+   */
+  bool SaveCache(FILE *file) const;
+
+  /**
+   * Use the binary index in the given file mapping, which was
+   * written by SaveCache().  The previous contents of this object
+   * are discarded.
+   *
+   * @param offset the position of the SaveCache() data within the
+   * mapping
+   * @return false if the data is malformed or incompatible
+   */
+  bool LoadCache(std::unique_ptr<FileMapping> &&mapping, size_t offset);
+
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
    * @param id FLARM id
    * @return FLARMNetRecord object
    */
   gcc_pure
-  const FlarmNetRecord *FindRecordById(FlarmId id) const {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
-  }
+  const FlarmNetRecord *FindRecordById(FlarmId id) const;
 
   /**
    * Finds a FLARMNetRecord object based on the given Callsign
@@ -76,13 +139,22 @@ public:
   unsigned FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                              unsigned size) const;
 
-  RecordMap::const_iterator begin() const {
-    return map.begin();
+  const FlarmNetRecord *begin() const {
+    return records;
   }
 
-  RecordMap::const_iterator end() const {
-    return map.end();
+  const FlarmNetRecord *end() const {
+    return records + n_records;
   }
+
+private:
+  /**
+   * Returns the range of #callsign_index entries with the specified
+   * callsign.
+   */
+  gcc_pure
+  std::pair<const uint32_t *, const uint32_t *>
+  FindCallSign(const TCHAR *cn) const;
 };
 
 #endif
@@ -24,12 +24,15 @@ Copyright_License {
 #include "Glue.hpp"
 #include "Global.hpp"
 #include "TrafficDatabases.hpp"
+#include "FlarmDetails.hpp"
 #include "FlarmNetReader.hpp"
 #include "NameFile.hpp"
 #include "Components.hpp"
 #include "MergeThread.hpp"
 #include "LocalPath.hpp"
 #include "IO/DataFile.hpp"
+#include "IO/FileCache.hpp"
+#include "OS/FileMapping.hpp"
 #include "IO/LineReader.hpp"
 #include "IO/FileOutputStream.hxx"
 #include "IO/BufferedOutputStream.hxx"
@@ -37,17 +40,67 @@ Copyright_License {
 #include "Profile/Current.hpp"
 #include "LogFile.hpp"
 
+static constexpr TCHAR flarmnet_cache_name[] = _T("flarmnet.bin");
+
+/**
+ * Attempt to map the binary FlarmNet index from the #FileCache.
+ */
+static bool
+LoadFLARMnetCache(FlarmNetDatabase &db, FileCache &cache, Path path)
+{
+  size_t offset;
+  auto mapping = cache.Map(flarmnet_cache_name, path, offset);
+  if (!mapping)
+    return false;
+
+  if (!db.LoadCache(std::move(mapping), offset)) {
+    /* unmap the file before deleting it, or deleting fails on
+       Windows */
+    mapping.reset();
+    cache.Flush(flarmnet_cache_name);
+    return false;
+  }
+
+  return true;
+}
+
+static void
+SaveFLARMnetCache(const FlarmNetDatabase &db, FileCache &cache, Path path)
+{
+  FILE *file = cache.Save(flarmnet_cache_name, path);
+  if (file == nullptr)
+    return;
+
+  if (db.SaveCache(file))
+    cache.Commit(flarmnet_cache_name, file);
+  else
+    cache.Cancel(flarmnet_cache_name, file);
+}
+
 /**
- * Loads the FLARMnet file
+ * Loads the FLARMnet file, preferably from the binary index in the
+ * #FileCache.  After parsing the text file, the index is written to
+ * the cache for the next start.
  */
 static void
 LoadFLARMnet(FlarmNetDatabase &db)
 try {
+  const auto path = LocalPath(_T("data.fln"));
+
+  if (file_cache != nullptr && LoadFLARMnetCache(db, *file_cache, path)) {
+    LogFormat("%u FLARMnet ids found in cache", db.size());
+    return;
+  }
+
   auto reader = OpenDataTextFileA(_T("data.fln"));
 
   unsigned num_records = FlarmNetReader::LoadFile(*reader, db);
-  if (num_records > 0)
+  if (num_records > 0) {
     LogFormat("%u FLARMnet ids found", num_records);
+
+    if (file_cache != nullptr)
+      SaveFLARMnetCache(db, *file_cache, path);
+  }
 } catch (const std::runtime_error &e) {
   LogError(e);
 }
@@ -84,6 +137,8 @@ LoadFlarmDatabases()
   LoadFLARMnet(traffic_databases->flarm_net);
   Profile::Load(Profile::map, traffic_databases->flarm_colors);
 
+  FlarmDetails::Invalidate();
+
   merge_thread->Resume();
 }
 
@@ -122,5 +177,7 @@ DeinitTrafficGlobals()
 {
   delete traffic_databases;
   traffic_databases = nullptr;
+
+  FlarmDetails::Invalidate();
 }
 
@@ -27,15 +27,35 @@ Copyright_License {
 #include "Traffic.hpp"
 #include "NMEA/Validity.hpp"
 #include "Util/TrivialArray.hxx"
+#include "Compiler.h"
 
 #include <type_traits>
 
+#include <stdint.h>
+#include <string.h>
+
 /**
  * This class keeps track of the traffic objects received from a
  * FLARM.
  */
 struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+  /**
+   * The maximum number of targets.  This is large enough for the
+   * ADS-B traffic reported by modern devices; the array is part of
+   * #NMEAInfo, so every increase makes each blackboard copy larger.
+   */
+  static constexpr size_t MAX_COUNT = 200;
+
+  /**
+   * The number of slots in the #FlarmId hash table.  Must be a power
+   * of two, and large enough to keep the load factor below 1/2.
+   */
+  static constexpr size_t INDEX_SIZE = 512;
+
+  static_assert((INDEX_SIZE & (INDEX_SIZE - 1)) == 0,
+                "INDEX_SIZE must be a power of two");
+  static_assert(INDEX_SIZE >= 2 * MAX_COUNT, "INDEX_SIZE too small");
+  static_assert(MAX_COUNT < 0xff, "MAX_COUNT too large for the index");
 
   /**
    * Time stamp of the latest modification to this object.
@@ -50,10 +70,19 @@ struct TrafficList {
   /** Flarm traffic information */
   TrivialArray<FlarmTraffic, MAX_COUNT> list;
 
+  /**
+   * Open addressing hash table (linear probing) which maps a #FlarmId
+   * to its position in #list.  Each slot contains the array index
+   * plus one; zero marks an empty slot.  Do not modify #list
+   * directly, or this table will be out of sync.
+   */
+  uint8_t index[INDEX_SIZE];
+
   void Clear() {
     modified.Clear();
     new_traffic.Clear();
     list.clear();
+    ClearIndex();
   }
 
   bool IsEmpty() const {
@@ -73,9 +102,16 @@ struct TrafficList {
     modified.Expire(clock, 300);
     new_traffic.Expire(clock, 60);
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
+    bool removed = false;
+    for (unsigned i = list.size(); i-- > 0;) {
+      if (!list[i].Refresh(clock)) {
         list.quick_remove(i);
+        removed = true;
+      }
+    }
+
+    if (removed)
+      RebuildIndex();
   }
 
   unsigned GetActiveTrafficCount() const {
@@ -89,11 +125,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   FlarmTraffic *FindTraffic(FlarmId id) {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = FindIndex(id);
+    return i >= 0 ? &list[i] : NULL;
   }
 
   /**
@@ -103,11 +136,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   const FlarmTraffic *FindTraffic(FlarmId id) const {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = FindIndex(id);
+    return i >= 0 ? &list[i] : NULL;
   }
 
   /**
@@ -139,14 +169,22 @@ struct TrafficList {
   }
 
   /**
-   * Allocates a new FLARM_TRAFFIC object from the array.
+   * Allocates a new FLARM_TRAFFIC object from the array and
+   * registers it with the specified id.  The caller must check
+   * FindTraffic() first; the id must not be in the list already.
    *
    * @return the FLARM_TRAFFIC pointer, NULL if the array is full
    */
-  FlarmTraffic *AllocateTraffic() {
-    return list.full()
-      ? NULL
-      : &list.append();
+  FlarmTraffic *AllocateTraffic(FlarmId id) {
+    if (list.full())
+      return NULL;
+
+    const unsigned i = list.size();
+    FlarmTraffic &traffic = list.append();
+    traffic.Clear();
+    traffic.id = id;
+    index[FindSlot(id)] = i + 1;
+    return &traffic;
   }
 
   /**
@@ -190,6 +228,46 @@ struct TrafficList {
   unsigned TrafficIndex(const FlarmTraffic *t) const {
     return t - list.begin();
   }
+
+private:
+  static constexpr unsigned INDEX_MASK = INDEX_SIZE - 1;
+
+  gcc_const
+  static unsigned Hash(FlarmId id) {
+    /* Fibonacci hashing: FLARM ids are often allocated
+       sequentially, so use the high bits of the product */
+    return (id.GetHash() * 2654435761u) >> 16;
+  }
+
+  void ClearIndex() {
+    memset(index, 0, sizeof(index));
+  }
+
+  void RebuildIndex() {
+    ClearIndex();
+    for (unsigned i = 0, n = list.size(); i < n; ++i)
+      index[FindSlot(list[i].id)] = i + 1;
+  }
+
+  /**
+   * Returns the hash table slot which contains the specified id, or
+   * the empty slot where it would be inserted.
+   */
+  gcc_pure
+  unsigned FindSlot(FlarmId id) const {
+    unsigned slot = Hash(id) & INDEX_MASK;
+    while (index[slot] != 0 && !(list[index[slot] - 1].id == id))
+      slot = (slot + 1) & INDEX_MASK;
+    return slot;
+  }
+
+  /**
+   * @return the position of the id in #list, or -1 if not found
+   */
+  gcc_pure
+  int FindIndex(FlarmId id) const {
+    return int(index[FindSlot(id)]) - 1;
+  }
 };
 
 static_assert(std::is_trivial<TrafficList>::value, "type is not trivial");
@@ -35,6 +35,7 @@ Copyright_License {
 
 #include <type_traits>
 
+#include <math.h>
 #include <tchar.h>
 
 struct FlarmTraffic {
@@ -93,6 +94,9 @@ struct FlarmTraffic {
   /** Has the averaged climb rate of the target been calculated yet? */
   bool climb_rate_avg30s_available;
 
+  /** Has the closest point of approach been predicted? */
+  bool cpa_available;
+
   /** Is this object valid, or has it expired already? */
   Validity valid;
 
@@ -140,6 +144,15 @@ struct FlarmTraffic {
   /** Average climb rate over 30s */
   double climb_rate_avg30s;
 
+  /** Predicted time until the closest point of approach [s] */
+  double cpa_time;
+
+  /** Predicted horizontal distance at the closest point of approach */
+  RoughDistance cpa_distance;
+
+  /** Predicted relative altitude at the closest point of approach */
+  RoughAltitude cpa_relative_altitude;
+
   bool IsDefined() const {
     return valid;
   }
@@ -148,6 +161,17 @@ struct FlarmTraffic {
     return alarm_level != AlarmType::NONE;
   }
 
+  /**
+   * Does the collision prediction say that this target will come
+   * dangerously close soon?  This is calculated by XCSoar and is
+   * independent of the FLARM's own #alarm_level.
+   */
+  bool IsPredictedConflict() const {
+    return cpa_available && cpa_time <= 20 &&
+      cpa_distance < RoughDistance(150) &&
+      fabs(double(cpa_relative_altitude)) < 100;
+  }
+
   /**
    * Does the target have a name?
    * @return True if a name has been assigned to the target
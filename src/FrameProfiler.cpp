@@ -0,0 +1,279 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FrameProfiler.hpp"
+#include "JSON/Writer.hpp"
+#include "IO/BufferedOutputStream.hxx"
+#include "IO/FileOutputStream.hxx"
+#include "OS/Path.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include <string.h>
+
+namespace FrameProfiler {
+  struct Layer {
+    std::atomic<const char *> name;
+
+    /**
+     * The total number of samples written to this layer.  The most
+     * recent one is at index (count - 1) % WINDOW.
+     */
+    std::atomic<unsigned> count;
+
+    std::atomic<uint32_t> wall_us[WINDOW], cpu_us[WINDOW];
+  };
+
+  struct Event {
+    std::atomic<const char *> name;
+    std::atomic<uint64_t> start_us;
+    std::atomic<uint32_t> wall_us, cpu_us;
+  };
+
+#ifdef STOP_WATCH
+  static std::atomic<bool> enabled(true);
+#else
+  static std::atomic<bool> enabled(false);
+#endif
+
+  static Layer layers[MAX_LAYERS];
+  static std::atomic<unsigned> n_layers;
+
+  static Event events[MAX_EVENTS];
+  static std::atomic<unsigned> n_events;
+
+  static Layer *FindLayer(const char *name);
+  static Layer *MakeLayer(const char *name);
+  static Percentiles CalculatePercentiles(const std::atomic<uint32_t> *src,
+                                          unsigned n);
+}
+
+bool
+FrameProfiler::IsEnabled()
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+void
+FrameProfiler::SetEnabled(bool _enabled)
+{
+  if (_enabled == IsEnabled())
+    return;
+
+  if (_enabled) {
+    /* discard old data; the producer is idle because "enabled" is
+       still false */
+    n_layers.store(0, std::memory_order_relaxed);
+    for (auto &layer : layers) {
+      layer.name.store(nullptr, std::memory_order_relaxed);
+      layer.count.store(0, std::memory_order_relaxed);
+    }
+
+    n_events.store(0, std::memory_order_relaxed);
+  }
+
+  enabled.store(_enabled, std::memory_order_release);
+}
+
+FrameProfiler::Layer *
+FrameProfiler::FindLayer(const char *name)
+{
+  const unsigned n = n_layers.load(std::memory_order_acquire);
+  for (unsigned i = 0; i < n; ++i) {
+    const char *layer_name = layers[i].name.load(std::memory_order_relaxed);
+    if (layer_name == name || strcmp(layer_name, name) == 0)
+      return &layers[i];
+  }
+
+  return nullptr;
+}
+
+FrameProfiler::Layer *
+FrameProfiler::MakeLayer(const char *name)
+{
+  Layer *layer = FindLayer(name);
+  if (layer != nullptr)
+    return layer;
+
+  /* only the producer thread adds layers, so there is no race
+     between the load and the store */
+  const unsigned n = n_layers.load(std::memory_order_relaxed);
+  if (n >= MAX_LAYERS)
+    return nullptr;
+
+  layer = &layers[n];
+  layer->name.store(name, std::memory_order_relaxed);
+  layer->count.store(0, std::memory_order_relaxed);
+  n_layers.store(n + 1, std::memory_order_release);
+  return layer;
+}
+
+void
+FrameProfiler::SubmitFrame(const Sample *samples, unsigned n)
+{
+  if (!IsEnabled())
+    return;
+
+  for (unsigned i = 0; i < n; ++i) {
+    const Sample &sample = samples[i];
+
+    Layer *layer = MakeLayer(sample.name);
+    if (layer != nullptr) {
+      const unsigned count = layer->count.load(std::memory_order_relaxed);
+      const unsigned index = count % WINDOW;
+      layer->wall_us[index].store(sample.wall_us, std::memory_order_relaxed);
+      layer->cpu_us[index].store(sample.cpu_us, std::memory_order_relaxed);
+      layer->count.store(count + 1, std::memory_order_release);
+    }
+
+    const unsigned n_e = n_events.load(std::memory_order_relaxed);
+    Event &event = events[n_e % MAX_EVENTS];
+    event.name.store(sample.name, std::memory_order_relaxed);
+    event.start_us.store(sample.start_us, std::memory_order_relaxed);
+    event.wall_us.store(sample.wall_us, std::memory_order_relaxed);
+    event.cpu_us.store(sample.cpu_us, std::memory_order_relaxed);
+    n_events.store(n_e + 1, std::memory_order_release);
+  }
+}
+
+FrameProfiler::Percentiles
+FrameProfiler::CalculatePercentiles(const std::atomic<uint32_t> *src,
+                                    unsigned n)
+{
+  Percentiles p;
+  if (n == 0) {
+    p.p50 = p.p95 = p.p99 = 0;
+    return p;
+  }
+
+  uint32_t sorted[WINDOW];
+  for (unsigned i = 0; i < n; ++i)
+    sorted[i] = src[i].load(std::memory_order_relaxed);
+
+  std::sort(sorted, sorted + n);
+
+  p.p50 = sorted[(n - 1) * 50 / 100];
+  p.p95 = sorted[(n - 1) * 95 / 100];
+  p.p99 = sorted[(n - 1) * 99 / 100];
+  return p;
+}
+
+unsigned
+FrameProfiler::GetStatistics(LayerStatistics *dest, unsigned max)
+{
+  const unsigned n = std::min(n_layers.load(std::memory_order_acquire),
+                              max);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const Layer &layer = layers[i];
+    LayerStatistics &s = dest[i];
+
+    s.name = layer.name.load(std::memory_order_relaxed);
+    s.n = std::min(layer.count.load(std::memory_order_acquire), WINDOW);
+    s.wall = CalculatePercentiles(layer.wall_us, s.n);
+    s.cpu = CalculatePercentiles(layer.cpu_us, s.n);
+  }
+
+  return n;
+}
+
+void
+FrameProfiler::Log()
+{
+  LayerStatistics statistics[MAX_LAYERS];
+  const unsigned n = GetStatistics(statistics, MAX_LAYERS);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const LayerStatistics &s = statistics[i];
+    LogFormat("FrameProfiler '%s': n=%u wall=%u/%u/%u cpu=%u/%u/%u us",
+              s.name, s.n,
+              (unsigned)s.wall.p50, (unsigned)s.wall.p95,
+              (unsigned)s.wall.p99,
+              (unsigned)s.cpu.p50, (unsigned)s.cpu.p95,
+              (unsigned)s.cpu.p99);
+  }
+}
+
+static void
+WriteEvent(BufferedOutputStream &os, const char *name, uint64_t start_us,
+           uint32_t wall_us, uint32_t cpu_us)
+{
+  JSON::ObjectWriter object(os);
+  object.WriteElement("name", JSON::WriteString, name);
+  object.WriteElement("cat", JSON::WriteString, "map");
+  object.WriteElement("ph", JSON::WriteString, "X");
+
+  object.BeginElement("ts");
+  os.Format("%llu", (unsigned long long)start_us);
+  object.EndElement();
+
+  object.WriteElement("dur", JSON::WriteUnsigned, unsigned(wall_us));
+  object.WriteElement("pid", JSON::WriteUnsigned, 1u);
+  object.WriteElement("tid", JSON::WriteUnsigned, 1u);
+
+  object.BeginElement("args");
+  {
+    JSON::ObjectWriter args(os);
+    args.WriteElement("cpu_us", JSON::WriteUnsigned, unsigned(cpu_us));
+  }
+  object.EndElement();
+}
+
+void
+FrameProfiler::ExportChromeTrace(BufferedOutputStream &os)
+{
+  const unsigned end = n_events.load(std::memory_order_acquire);
+  const unsigned begin = end > MAX_EVENTS ? end - MAX_EVENTS : 0;
+
+  JSON::ObjectWriter root(os);
+  root.BeginElement("traceEvents");
+  {
+    JSON::ArrayWriter array(os);
+    for (unsigned i = begin; i != end; ++i) {
+      const Event &event = events[i % MAX_EVENTS];
+      const char *name = event.name.load(std::memory_order_relaxed);
+      if (name == nullptr)
+        continue;
+
+      array.WriteElement(WriteEvent, name,
+                         event.start_us.load(std::memory_order_relaxed),
+                         event.wall_us.load(std::memory_order_relaxed),
+                         event.cpu_us.load(std::memory_order_relaxed));
+    }
+  }
+  root.EndElement();
+
+  root.WriteElement("displayTimeUnit", JSON::WriteString, "ms");
+}
+
+void
+FrameProfiler::ExportChromeTrace(Path path)
+{
+  FileOutputStream file(path);
+  BufferedOutputStream buffered(file);
+  ExportChromeTrace(buffered);
+  buffered.Flush();
+  file.Commit();
+}
@@ -0,0 +1,129 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FRAME_PROFILER_HPP
+#define XCSOAR_FRAME_PROFILER_HPP
+
+#include "Compiler.h"
+
+#include <stdint.h>
+
+class BufferedOutputStream;
+class Path;
+
+/**
+ * Collects the wall and CPU time spent in each layer of the map
+ * renderer.  Frames are submitted by #ScreenStopWatch, which is the
+ * only producer; recording is wait-free and does not allocate, so the
+ * profiler can be switched on in the field without disturbing the
+ * frame rate much.
+ *
+ * The statistics may be read from any thread at any time; a reader
+ * may see a sample which is being overwritten concurrently, which is
+ * acceptable for statistics.
+ */
+namespace FrameProfiler {
+  /**
+   * The maximum number of distinct layer names.  Further layers are
+   * ignored.
+   */
+  static constexpr unsigned MAX_LAYERS = 32;
+
+  /**
+   * The number of most recent frames kept for each layer.
+   */
+  static constexpr unsigned WINDOW = 256;
+
+  /**
+   * The number of most recent layer events kept for the trace
+   * export.
+   */
+  static constexpr unsigned MAX_EVENTS = 4096;
+
+  struct Sample {
+    /**
+     * The layer name.  This must be a string literal (or otherwise
+     * live forever), because only the pointer is stored.
+     */
+    const char *name;
+
+    /**
+     * MonotonicClockUS() when this layer began.
+     */
+    uint64_t start_us;
+
+    uint32_t wall_us, cpu_us;
+  };
+
+  struct Percentiles {
+    uint32_t p50, p95, p99;
+  };
+
+  struct LayerStatistics {
+    const char *name;
+    unsigned n;
+    Percentiles wall, cpu;
+  };
+
+  gcc_pure
+  bool IsEnabled();
+
+  /**
+   * Switch recording on or off.  Enabling the profiler discards all
+   * data recorded previously.
+   */
+  void SetEnabled(bool enabled);
+
+  /**
+   * Record the layers of one frame.  Must be called from one thread
+   * only (the one which renders the map).
+   */
+  void SubmitFrame(const Sample *samples, unsigned n);
+
+  /**
+   * Calculate the statistics of all layers which have been recorded.
+   *
+   * @return the number of elements written to #dest
+   */
+  unsigned GetStatistics(LayerStatistics *dest, unsigned max);
+
+  /**
+   * Write the statistics of all layers to the log file.
+   */
+  void Log();
+
+  /**
+   * Write the most recent events in the Chrome trace event format
+   * (JSON), which can be loaded into chrome://tracing or Perfetto.
+   */
+  void ExportChromeTrace(BufferedOutputStream &os);
+
+  /**
+   * Write a Chrome trace event file.
+   *
+   * Throws std::runtime_error on error.
+   */
+  void ExportChromeTrace(Path path);
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FrameScheduler.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+
+unsigned
+FrameScheduler::GetDelay(unsigned now) const
+{
+  if (!has_frame)
+    return 0;
+
+  const unsigned elapsed = now - last_start;
+  return elapsed < min_interval
+    ? min_interval - elapsed
+    : 0;
+}
+
+unsigned
+FrameScheduler::GetAverageCost() const
+{
+  if (n_costs == 0)
+    return 0;
+
+  unsigned sum = 0;
+  for (unsigned i = 0; i < n_costs; ++i)
+    sum += costs[i];
+
+  return sum / n_costs;
+}
+
+unsigned
+FrameScheduler::GetMaxCost() const
+{
+  return n_costs > 0
+    ? *std::max_element(costs, costs + n_costs)
+    : 0;
+}
+
+void
+FrameScheduler::BeginFrame(unsigned now)
+{
+  if (has_frame && level > 0 && now - last_end >= IDLE_TIME) {
+    /* the map has been idle; there is time for a full quality
+       frame */
+    level = 0;
+    ClearCosts();
+  }
+
+  has_frame = true;
+  last_start = now;
+}
+
+void
+FrameScheduler::EndFrame(unsigned now)
+{
+  assert(has_frame);
+
+  last_end = now;
+
+  costs[next_cost] = now - last_start;
+  next_cost = (next_cost + 1) % WINDOW;
+  if (n_costs < WINDOW)
+    ++n_costs;
+
+  if (level < MAX_LEVEL && n_costs >= 2 && GetAverageCost() > budget) {
+    /* two or more frames over budget: degrade; measure the new level
+       from scratch */
+    ++level;
+    ClearCosts();
+  } else if (level > 0 && n_costs == WINDOW && GetMaxCost() < budget / 2) {
+    /* a whole window of cheap frames: try the next better level */
+    --level;
+    ClearCosts();
+  }
+}
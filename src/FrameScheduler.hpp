@@ -0,0 +1,137 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FRAME_SCHEDULER_HPP
+#define XCSOAR_FRAME_SCHEDULER_HPP
+
+#include "Compiler.h"
+
+/**
+ * Paces map frames and adapts the rendering quality to the frame
+ * cost.  It caps the frame rate at a minimum interval between two
+ * frames, and it raises the "degradation level" when frames exceed
+ * the budget, which tells the renderer to skip or simplify expensive
+ * layers.  The level is lowered again after a series of cheap
+ * frames, or as soon as the map has been idle for a while.
+ *
+ * All times are in milliseconds, as returned by MonotonicClockMS().
+ * This class is not thread-safe; it is meant to be used by the thread
+ * which renders the map.
+ */
+class FrameScheduler {
+public:
+  /**
+   * The highest degradation level.  0 means full quality.
+   */
+  static constexpr unsigned MAX_LEVEL = 3;
+
+  /**
+   * The number of most recent frame costs which are kept.  Restoring
+   * a level requires this many cheap frames in a row.
+   */
+  static constexpr unsigned WINDOW = 16;
+
+  /**
+   * Full quality is restored when no frame has been drawn for this
+   * long.
+   */
+  static constexpr unsigned IDLE_TIME = 2000;
+
+private:
+  const unsigned min_interval;
+
+  const unsigned budget;
+
+  unsigned level = 0;
+
+  /**
+   * The most recent frame costs; the oldest one is at #next_cost
+   * once the buffer is full.
+   */
+  unsigned costs[WINDOW];
+  unsigned n_costs = 0, next_cost = 0;
+
+  bool has_frame = false;
+  unsigned last_start = 0, last_end = 0;
+
+public:
+  /**
+   * @param _min_interval the minimum time between the start of two
+   * frames
+   * @param _budget frames which take longer than this cause
+   * degradation
+   */
+  constexpr FrameScheduler(unsigned _min_interval, unsigned _budget)
+    :min_interval(_min_interval), budget(_budget), costs() {}
+
+  unsigned GetMinInterval() const {
+    return min_interval;
+  }
+
+  unsigned GetBudget() const {
+    return budget;
+  }
+
+  unsigned GetLevel() const {
+    return level;
+  }
+
+  bool IsDegraded() const {
+    return level > 0;
+  }
+
+  /**
+   * How long shall the caller wait before the next frame may begin?
+   */
+  gcc_pure
+  unsigned GetDelay(unsigned now) const;
+
+  /**
+   * Returns the average cost of the frames in the window since the
+   * last level change, or 0 if there are none.
+   */
+  gcc_pure
+  unsigned GetAverageCost() const;
+
+  /**
+   * A frame begins.  Restores full quality if the previous frame was
+   * long ago.
+   */
+  void BeginFrame(unsigned now);
+
+  /**
+   * The frame which was started by BeginFrame() is finished.  Adapts
+   * the degradation level.
+   */
+  void EndFrame(unsigned now);
+
+private:
+  void ClearCosts() {
+    n_costs = next_cost = 0;
+  }
+
+  gcc_pure
+  unsigned GetMaxCost() const;
+};
+
+#endif
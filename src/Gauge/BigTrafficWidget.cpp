@@ -917,7 +917,9 @@ TrafficWidget::Show(const PixelRect &rc)
   /* show the "Close" button only if this is a "special" page */
   close_button->SetVisible(CommonInterface::GetUIState().pages.special_page.IsDefined());
 
-  CommonInterface::GetLiveBlackboard().AddListener(*this);
+  CommonInterface::GetLiveBlackboard()
+    .AddListener(*this, ToMask(BlackboardSection::TRAFFIC) |
+                 ToMask(BlackboardSection::POSITION));
 }
 
 void
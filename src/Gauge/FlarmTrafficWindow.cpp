@@ -336,7 +336,15 @@ FlarmTrafficWindow::PaintRadarTarget(Canvas &canvas,
     break;
   case FlarmTraffic::AlarmType::NONE:
   default:
-    if (WarningMode()) {
+    if (traffic.IsPredictedConflict()) {
+      /* the FLARM does not warn (yet), but our own prediction
+         says this target will come close */
+      text_color = &look.default_color;
+      target_pen = circle_pen = &look.warning_pen;
+      arrow_brush = &look.default_brush;
+      hollow_brush = true;
+      circles = 1;
+    } else if (WarningMode()) {
       text_color = &look.passive_color;
       target_pen = &look.passive_pen;
       arrow_brush = &look.passive_brush;
@@ -175,7 +175,8 @@ GaugeFLARM::Show(const PixelRect &rc)
 
   OverlappedWidget::Show(rc);
 
-  blackboard.AddListener(*this);
+  blackboard.AddListener(*this, ToMask(BlackboardSection::TRAFFIC) |
+                         ToMask(BlackboardSection::POSITION));
 }
 
 void
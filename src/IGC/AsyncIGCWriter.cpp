@@ -0,0 +1,238 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AsyncIGCWriter.hpp"
+#include "NMEA/Info.hpp"
+#include "Util/StringUtil.hpp"
+#include "Util/Macros.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+AsyncIGCWriter::AsyncIGCWriter(Path path, bool high_rate)
+  :Thread("IGCWriter"), writer(path, high_rate), sync_requested(false)
+{
+  fix.Clear();
+}
+
+AsyncIGCWriter::Record *
+AsyncIGCWriter::BeginRecord(Record::Type type)
+{
+  Record *record = queue.Write();
+  if (record == nullptr) {
+    ++n_dropped;
+    return nullptr;
+  }
+
+  record->type = type;
+  return record;
+}
+
+void
+AsyncIGCWriter::LogPoint(const NMEAInfo &gps_info)
+{
+  if (!fix.Apply(gps_info))
+    return;
+
+  Record *record = BeginRecord(Record::Type::POINT);
+  if (record == nullptr)
+    return;
+
+  record->fix = fix;
+  record->epe = (int)IGCWriter::GetEPE(gps_info.gps);
+  record->satellites = IGCWriter::GetSIU(gps_info.gps);
+  queue.Append();
+
+  WriteIfNoThread();
+}
+
+void
+AsyncIGCWriter::LogEvent(const NMEAInfo &gps_info, const char *event)
+{
+  Record *record = BeginRecord(Record::Type::EVENT);
+  if (record != nullptr) {
+    record->time = gps_info.date_time_utc;
+    CopyString(record->event, event, sizeof(record->event));
+    queue.Append();
+  }
+
+  // tech_spec_gnss.pdf says we need a B record immediately after an E record
+  LogPoint(gps_info);
+
+  sync_requested.store(true);
+  WriteIfNoThread();
+}
+
+void
+AsyncIGCWriter::LogEmptyFRecord(const BrokenTime &time)
+{
+  Record *record = BeginRecord(Record::Type::EMPTY_F_RECORD);
+  if (record == nullptr)
+    return;
+
+  record->time = time;
+  queue.Append();
+
+  WriteIfNoThread();
+}
+
+void
+AsyncIGCWriter::LogFRecord(const BrokenTime &time, const int *satellite_ids)
+{
+  Record *record = BeginRecord(Record::Type::F_RECORD);
+  if (record == nullptr)
+    return;
+
+  record->time = time;
+  std::copy_n(satellite_ids, GPSState::MAXSATELLITES, record->satellite_ids);
+  queue.Append();
+
+  WriteIfNoThread();
+}
+
+void
+AsyncIGCWriter::LoggerNote(const TCHAR *text)
+{
+  Record *record = BeginRecord(Record::Type::NOTE);
+  if (record == nullptr)
+    return;
+
+  CopyString(record->note, text, ARRAY_SIZE(record->note));
+  queue.Append();
+
+  sync_requested.store(true);
+  WriteIfNoThread();
+}
+
+inline void
+AsyncIGCWriter::WriteRecord(const Record &record)
+{
+  switch (record.type) {
+  case Record::Type::POINT:
+    writer.LogPoint(record.fix, record.epe, record.satellites);
+    break;
+
+  case Record::Type::EVENT:
+    writer.LogEvent(record.time, record.event);
+    break;
+
+  case Record::Type::F_RECORD:
+    writer.LogFRecord(record.time, record.satellite_ids);
+    break;
+
+  case Record::Type::EMPTY_F_RECORD:
+    writer.LogEmptyFRecord(record.time);
+    break;
+
+  case Record::Type::NOTE:
+    writer.LoggerNote(record.note);
+    break;
+  }
+}
+
+void
+AsyncIGCWriter::WriteQueued(bool sync, bool _sign)
+{
+  const Record *record;
+  while ((record = queue.Read()) != nullptr) {
+    if (!failed) {
+      try {
+        WriteRecord(*record);
+      } catch (const std::runtime_error &e) {
+        LogError(e);
+        failed = true;
+      }
+    }
+
+    queue.Shift();
+  }
+
+  if (failed)
+    return;
+
+  try {
+    if (_sign)
+      writer.Sign();
+
+    if (sync)
+      writer.Sync();
+    else
+      writer.Flush();
+  } catch (const std::runtime_error &e) {
+    LogError(e);
+    failed = true;
+  }
+}
+
+void
+AsyncIGCWriter::Stop(bool _sign)
+{
+  if (!IsDefined()) {
+    /* the thread was never started: finish the file right here */
+    WriteQueued(true, _sign);
+    return;
+  }
+
+  {
+    const ScopeLock protect(mutex);
+    stop = true;
+    sign = _sign;
+    cond.signal();
+  }
+
+  Join();
+}
+
+void
+AsyncIGCWriter::Run()
+{
+  unsigned n_flushes = 0;
+
+  const ScopeLock protect(mutex);
+
+  while (true) {
+    const bool stopping = stop, _sign = sign;
+
+    {
+      const ScopeUnlock unlock(mutex);
+
+      /* check the request before draining the queue, so the record
+         which triggered it is included in this sync */
+      bool sync = sync_requested.exchange(false);
+      if (++n_flushes >= SYNC_INTERVAL)
+        sync = true;
+
+      WriteQueued(sync || stopping, stopping && _sign);
+
+      if (sync)
+        n_flushes = 0;
+    }
+
+    if (stopping)
+      break;
+
+    if (!stop)
+      cond.timed_wait(mutex, FLUSH_INTERVAL_MS);
+  }
+}
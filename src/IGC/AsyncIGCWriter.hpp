@@ -0,0 +1,210 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_ASYNC_IGC_WRITER_HPP
+#define XCSOAR_ASYNC_IGC_WRITER_HPP
+
+#include "IGCWriter.hpp"
+#include "IGCFix.hpp"
+#include "NMEA/GPSState.hpp"
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
+#include "Thread/Cond.hxx"
+#include "Util/SPSCRingBuffer.hpp"
+
+#include <atomic>
+
+#include <stdint.h>
+#include <tchar.h>
+
+/**
+ * An #IGCWriter which runs in its own thread.  The caller only copies
+ * each record into a lock-free queue; formatting, G record hashing
+ * and all file I/O happen in the writer thread, so a slow SD card
+ * never holds up the caller.
+ *
+ * Queued records are written every #FLUSH_INTERVAL_MS milliseconds.
+ * They are synced to the storage device on every #SYNC_INTERVAL'th
+ * flush, after events and pilot notes, and when the writer is
+ * stopped.  A power loss therefore loses at most the last
+ * #SYNC_INTERVAL flush intervals of B records.
+ *
+ * If the writer thread is not running (because Start() has not been
+ * called or has failed), the producer methods write each record
+ * right away, just like #IGCWriter, so nothing is lost when the
+ * queue would overflow.
+ *
+ * The producer methods may be called from only one thread at a time.
+ */
+class AsyncIGCWriter final : Thread {
+public:
+  /**
+   * The number of queued records; at 10 Hz, this is more than a
+   * minute, and it takes a full pre-takeoff buffer.
+   */
+  static constexpr unsigned QUEUE_SIZE = 1024;
+
+  static constexpr unsigned FLUSH_INTERVAL_MS = 1000;
+
+  static constexpr unsigned SYNC_INTERVAL = 10;
+
+private:
+  struct Record {
+    enum class Type : uint8_t {
+      POINT,
+      EVENT,
+      F_RECORD,
+      EMPTY_F_RECORD,
+      NOTE,
+    };
+
+    Type type;
+
+    /**
+     * The time stamp of EVENT and F records.
+     */
+    BrokenTime time;
+
+    IGCFix fix;
+    int epe, satellites;
+
+    union {
+      char event[16];
+      TCHAR note[64];
+      int satellite_ids[GPSState::MAXSATELLITES];
+    };
+  };
+
+  IGCWriter writer;
+
+  SPSCRingBuffer<Record, QUEUE_SIZE> queue;
+
+  /**
+   * Set by the producer to have the writer thread sync at the end of
+   * its next flush.
+   */
+  std::atomic<bool> sync_requested;
+
+  /**
+   * The last fix passed to LogPoint(); owned by the producer.
+   */
+  IGCFix fix;
+
+  /**
+   * The number of records which were discarded because the queue was
+   * full; owned by the producer.
+   */
+  unsigned n_dropped = 0;
+
+  Mutex mutex;
+  Cond cond;
+
+  /**
+   * Protected by #mutex.
+   */
+  bool stop = false, sign = false;
+
+  /**
+   * Has writing failed?  From then on, all records are discarded.
+   * Owned by the writer thread.
+   */
+  bool failed = false;
+
+public:
+  /**
+   * Create a new IGC file.
+   *
+   * Throws std::runtime_error on error.
+   *
+   * @param high_rate see #IGCWriter
+   */
+  explicit AsyncIGCWriter(Path path, bool high_rate=false);
+
+  /**
+   * Access the underlying #IGCWriter to write the header and the
+   * declaration.  This is only allowed before Start().
+   */
+  IGCWriter &GetWriter() {
+    assert(!IsDefined());
+
+    return writer;
+  }
+
+  /**
+   * Launch the writer thread.
+   */
+  bool Start() {
+    return Thread::Start();
+  }
+
+  /**
+   * Write all pending records, optionally append the G record, sync
+   * the file and wait for the writer thread to exit.
+   */
+  void Stop(bool sign);
+
+  /**
+   * @return the number of records which were lost because the queue
+   * was full
+   */
+  unsigned GetDroppedCount() const {
+    return n_dropped;
+  }
+
+  void LogPoint(const NMEAInfo &gps_info);
+  void LogEvent(const NMEAInfo &gps_info, const char *event);
+  void LogEmptyFRecord(const BrokenTime &time);
+  void LogFRecord(const BrokenTime &time, const int *satellite_ids);
+  void LoggerNote(const TCHAR *text);
+
+private:
+  /**
+   * Obtain a queue slot for a new record.  Call queue.Append() after
+   * filling it.
+   *
+   * @return nullptr if the queue is full
+   */
+  Record *BeginRecord(Record::Type type);
+
+  void WriteRecord(const Record &record);
+
+  /**
+   * Called by the producer methods after queueing records: if there
+   * is no writer thread, write them now.
+   */
+  void WriteIfNoThread() {
+    if (!IsDefined())
+      WriteQueued(sync_requested.exchange(false), false);
+  }
+
+  /**
+   * Write all queued records and flush (or sync) them.  Errors are
+   * logged, and further records are discarded.
+   */
+  void WriteQueued(bool sync, bool sign);
+
+  /* virtual methods from class Thread */
+  void Run() override;
+};
+
+#endif
@@ -59,11 +59,16 @@ FormatIGCLocation(char *buffer, const GeoPoint &location)
   unsigned longitude =
     (unsigned)uround(fabs(location.longitude.Degrees() * 60000));
 
-  sprintf(buffer, "%02u%05u%c%03u%05u%c",
-          latitude / 60000, latitude % 60000, latitude_suffix,
-          longitude / 60000, longitude % 60000, longitude_suffix);
+  char *p = buffer;
+  p = FormatIGCDigits<2>(p, latitude / 60000);
+  p = FormatIGCDigits<5>(p, latitude % 60000);
+  *p++ = latitude_suffix;
+  p = FormatIGCDigits<3>(p, longitude / 60000);
+  p = FormatIGCDigits<5>(p, longitude % 60000);
+  *p++ = longitude_suffix;
+  *p = '\0';
 
-  return buffer + strlen(buffer);
+  return p;
 }
 
 void
@@ -29,6 +29,53 @@ Copyright_License {
 struct BrokenDateTime;
 struct GeoPoint;
 
+static constexpr unsigned
+IGCPower10(unsigned n)
+{
+  return n == 0 ? 1 : 10 * IGCPower10(n - 1);
+}
+
+/**
+ * Write exactly #width decimal digits, zero-padded.  Values which
+ * don't fit are clipped to the largest value that does.  The width
+ * is a compile-time constant, so the loop is unrolled completely;
+ * this is much cheaper than sprintf() on the logger's hot path.
+ *
+ * @return a pointer to the end of the buffer (not null-terminated)
+ */
+template<unsigned width>
+static inline char *
+FormatIGCDigits(char *p, unsigned value)
+{
+  static_assert(width > 0 && width < 10, "Bad width");
+
+  if (value >= IGCPower10(width))
+    value = IGCPower10(width) - 1;
+
+  for (unsigned i = width; i-- > 0;) {
+    p[i] = '0' + value % 10;
+    value /= 10;
+  }
+
+  return p + width;
+}
+
+/**
+ * Like FormatIGCDigits(), but negative values are written as a minus
+ * sign followed by #width-1 digits.
+ */
+template<unsigned width>
+static inline char *
+FormatIGCSigned(char *p, int value)
+{
+  if (value < 0) {
+    *p++ = '-';
+    return FormatIGCDigits<width - 1>(p, -value);
+  }
+
+  return FormatIGCDigits<width>(p, value);
+}
+
 /**
  * Generate a task declaration takeoff line according to IGC GNSS
  * specification 3.6.3
@@ -0,0 +1,252 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_B_RECORD_HPP
+#define XCSOAR_IGC_B_RECORD_HPP
+
+#include "IGCFix.hpp"
+#include "Generator.hpp"
+
+/**
+ * Compile-time generated B record formatters.  Each extension to the
+ * B record is described by a type; IGCBRecordFormat<...> combines a
+ * list of them into a formatter for the B record and the matching I
+ * record.  All field widths and offsets are known at compile time, so
+ * formatting a fix is a sequence of unrolled digit stores without any
+ * sprintf() call.
+ */
+namespace IGCBRecord {
+
+/**
+ * The length of a B record without extensions.
+ */
+static constexpr unsigned BASE_LENGTH = 35;
+
+/**
+ * Applies range checks to the specified altitude value and converts
+ * it to an integer suitable for printing in the IGC file.
+ */
+static inline int
+NormalizeAltitude(int value)
+{
+  if (value < -9999)
+    /* for negative values, there are only 4 characters left (after
+       the minus sign), and besides that, IGC does not support a
+       journey towards the center of the earth */
+    return -9999;
+
+  if (value >= 99999)
+    /* hooray, new world record! .. or just some invalid value; we
+       have only 5 characters for the altitude, so we must clip it at
+       99999 */
+    return 99999;
+
+  return value;
+}
+
+/**
+ * Fix accuracy: the estimated position error [m].
+ */
+struct FXA {
+  static constexpr unsigned WIDTH = 3;
+  static constexpr const char *Code() { return "FXA"; }
+
+  static char *Format(char *p, const IGCFix &, int epe, int) {
+    return FormatIGCDigits<WIDTH>(p, epe > 0 ? epe : 0);
+  }
+};
+
+/**
+ * Satellites in use.
+ */
+struct SIU {
+  static constexpr unsigned WIDTH = 2;
+  static constexpr const char *Code() { return "SIU"; }
+
+  static char *Format(char *p, const IGCFix &, int, int satellites) {
+    return FormatIGCDigits<WIDTH>(p, satellites > 0 ? satellites : 0);
+  }
+};
+
+/**
+ * Engine noise level [0 to 999].
+ */
+struct ENL {
+  static constexpr unsigned WIDTH = 3;
+  static constexpr const char *Code() { return "ENL"; }
+
+  static char *Format(char *p, const IGCFix &fix, int, int) {
+    return FormatIGCDigits<WIDTH>(p, fix.enl > 0 ? fix.enl : 0);
+  }
+};
+
+/**
+ * Tenths of the second of the fix time.
+ */
+struct TDS {
+  static constexpr unsigned WIDTH = 1;
+  static constexpr const char *Code() { return "TDS"; }
+
+  static char *Format(char *p, const IGCFix &fix, int, int) {
+    return FormatIGCDigits<WIDTH>(p, fix.tds > 0 ? fix.tds : 0);
+  }
+};
+
+/**
+ * True airspeed [km/h].
+ */
+struct TAS {
+  static constexpr unsigned WIDTH = 3;
+  static constexpr const char *Code() { return "TAS"; }
+
+  static char *Format(char *p, const IGCFix &fix, int, int) {
+    return FormatIGCDigits<WIDTH>(p, fix.tas > 0 ? fix.tas : 0);
+  }
+};
+
+/**
+ * Total energy vario [dm/s], with a leading minus sign for sink.
+ */
+struct VAT {
+  static constexpr unsigned WIDTH = 4;
+  static constexpr const char *Code() { return "VAT"; }
+
+  static char *Format(char *p, const IGCFix &fix, int, int) {
+    return FormatIGCSigned<WIDTH>(p, fix.vat != IGCFix::VAT_UNDEFINED
+                                  ? fix.vat : 0);
+  }
+};
+
+template<typename... Fields>
+struct Extensions;
+
+template<>
+struct Extensions<> {
+  static constexpr unsigned COUNT = 0;
+  static constexpr unsigned LENGTH = 0;
+
+  static char *FormatIRecord(char *p, unsigned) {
+    return p;
+  }
+
+  static char *Format(char *p, const IGCFix &, int, int) {
+    return p;
+  }
+};
+
+template<typename F, typename... Rest>
+struct Extensions<F, Rest...> {
+  typedef Extensions<Rest...> Tail;
+
+  static constexpr unsigned COUNT = 1 + Tail::COUNT;
+  static constexpr unsigned LENGTH = F::WIDTH + Tail::LENGTH;
+
+  /**
+   * @param start the (1-based) column of the first byte of this
+   * extension
+   */
+  static char *FormatIRecord(char *p, unsigned start) {
+    p = FormatIGCDigits<2>(p, start);
+    p = FormatIGCDigits<2>(p, start + F::WIDTH - 1);
+
+    const char *code = F::Code();
+    *p++ = code[0];
+    *p++ = code[1];
+    *p++ = code[2];
+
+    return Tail::FormatIRecord(p, start + F::WIDTH);
+  }
+
+  static char *Format(char *p, const IGCFix &fix, int epe, int satellites) {
+    p = F::Format(p, fix, epe, satellites);
+    return Tail::Format(p, fix, epe, satellites);
+  }
+};
+
+} // namespace IGCBRecord
+
+template<typename... Fields>
+struct IGCBRecordFormat {
+  typedef IGCBRecord::Extensions<Fields...> Extensions;
+
+  /**
+   * The length of the B record, not including the null terminator.
+   */
+  static constexpr unsigned LENGTH =
+    IGCBRecord::BASE_LENGTH + Extensions::LENGTH;
+
+  static_assert(Extensions::COUNT < 100, "Too many extensions");
+  static_assert(LENGTH < 100, "B record too long for the I record");
+
+  /**
+   * Write the I record declaring the extensions.  The buffer must
+   * hold 3 + 7 * COUNT + 1 bytes.
+   *
+   * @return a pointer to the null terminator
+   */
+  static char *FormatIRecord(char *p) {
+    *p++ = 'I';
+    p = FormatIGCDigits<2>(p, Extensions::COUNT);
+    p = Extensions::FormatIRecord(p, IGCBRecord::BASE_LENGTH + 1);
+    *p = '\0';
+    return p;
+  }
+
+  /**
+   * Write the B record.  The buffer must hold #LENGTH + 1 bytes.
+   *
+   * @return a pointer to the null terminator
+   */
+  static char *Format(char *p, const IGCFix &fix, int epe, int satellites) {
+    *p++ = 'B';
+    p = FormatIGCDigits<2>(p, fix.time.hour);
+    p = FormatIGCDigits<2>(p, fix.time.minute);
+    p = FormatIGCDigits<2>(p, fix.time.second);
+    p = FormatIGCLocation(p, fix.location);
+    *p++ = fix.gps_valid ? 'A' : 'V';
+
+    using IGCBRecord::NormalizeAltitude;
+    p = FormatIGCSigned<5>(p, NormalizeAltitude(fix.pressure_altitude));
+    p = FormatIGCSigned<5>(p, NormalizeAltitude(fix.gps_altitude));
+    p = Extensions::Format(p, fix, epe, satellites);
+    *p = '\0';
+    return p;
+  }
+};
+
+/**
+ * The B record written by default: 1 Hz or slower, with the
+ * mandatory fix accuracy and the satellite count.
+ */
+typedef IGCBRecordFormat<IGCBRecord::FXA, IGCBRecord::SIU> IGCBasicBRecord;
+
+/**
+ * The B record written at high logging rates (up to 10 Hz): adds the
+ * engine noise level, the tenths of the second, true airspeed and
+ * the total energy vario.
+ */
+typedef IGCBRecordFormat<IGCBRecord::FXA, IGCBRecord::SIU,
+                         IGCBRecord::ENL, IGCBRecord::TDS,
+                         IGCBRecord::TAS, IGCBRecord::VAT> IGCHighRateBRecord;
+
+#endif
@@ -29,9 +29,21 @@ Copyright_License {
 #include <stdint.h>
 
 struct IGCExtension {
+  /**
+   * The #IGCFix attribute this column is decoded into.  Resolved
+   * once by IGCParseExtensions(), so IGCParseFix() does not need to
+   * compare the three-letter codes for each fix.
+   */
+  enum class Type : uint8_t {
+    UNKNOWN,
+    ENL, RPM, HDM, HDT, TRM, TRT, GSP, IAS, TAS, SIU, TDS, VAT,
+  };
+
   uint16_t start, finish;
 
   char code[4];
+
+  Type type;
 };
 
 struct IGCExtensions : public TrivialArray<IGCExtension, 16> {
@@ -0,0 +1,108 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IGCFileReader.hpp"
+#include "IGCParser.hpp"
+#include "OS/Path.hpp"
+#include "OS/ConvertPathName.hpp"
+#include "OS/FileUtil.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include <string.h>
+
+IGCFileReader::IGCFileReader(Path path)
+  :mapping(path)
+{
+  if (mapping.error()) {
+    /* FileMapping refuses to map empty files */
+    if (!File::Exists(path) || File::GetSize(path) > 0)
+      throw std::runtime_error(std::string("Failed to map ") +
+                               (const char *)NarrowPathName(path));
+
+    begin = position = end = nullptr;
+  } else {
+    begin = position = (const char *)mapping.data();
+    end = (const char *)mapping.end();
+  }
+
+  extensions.clear();
+  date = BrokenDate::Invalid();
+}
+
+void
+IGCFileReader::ParseLine(const char *line, size_t length)
+{
+  /* the parsers for these (rare) records expect a null-terminated
+     string; copy the line to a buffer, so they can't read beyond the
+     end of the mapping */
+  char buffer[256];
+  if (length >= sizeof(buffer))
+    length = sizeof(buffer) - 1;
+
+  memcpy(buffer, line, length);
+  buffer[length] = 0;
+
+  if (buffer[0] == 'I') {
+    IGCParseExtensions(buffer, extensions);
+  } else {
+    BrokenDate new_date;
+    if (IGCParseDateRecord(buffer, new_date))
+      date = new_date;
+  }
+}
+
+bool
+IGCFileReader::Next(IGCFix &fix)
+{
+  while (position != end) {
+    const char *line = position;
+    const char *eol = (const char *)memchr(line, '\n', end - line);
+    if (eol != nullptr)
+      position = eol + 1;
+    else
+      position = eol = end;
+
+    size_t length = eol - line;
+    if (length > 0 && line[length - 1] == '\r')
+      --length;
+
+    if (length == 0)
+      continue;
+
+    switch (line[0]) {
+    case 'B':
+      if (IGCParseFix(line, length, extensions, fix))
+        return true;
+      break;
+
+    case 'H':
+    case 'I':
+      ParseLine(line, length);
+      break;
+    }
+  }
+
+  return false;
+}
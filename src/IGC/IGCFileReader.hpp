@@ -0,0 +1,97 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_FILE_READER_HPP
+#define XCSOAR_IGC_FILE_READER_HPP
+
+#include "IGCExtensions.hpp"
+#include "OS/FileMapping.hpp"
+#include "Time/BrokenDate.hpp"
+
+struct IGCFix;
+class Path;
+
+/**
+ * Reads the fixes of an IGC file.  The file is mapped into memory,
+ * and the "B" records are decoded in place, without copying each
+ * line into a buffer first.  "I" and "HFDTE" records are handled
+ * along the way.
+ */
+class IGCFileReader {
+  FileMapping mapping;
+
+  /**
+   * The mapped file contents.  All three are nullptr if the file is
+   * empty.
+   */
+  const char *begin, *position, *end;
+
+  IGCExtensions extensions;
+
+  BrokenDate date;
+
+public:
+  /**
+   * Throws std::runtime_error if the file cannot be mapped.  An
+   * empty file is not an error; it just has no records.
+   */
+  explicit IGCFileReader(Path path);
+
+  IGCFileReader(const IGCFileReader &) = delete;
+  IGCFileReader &operator=(const IGCFileReader &) = delete;
+
+  /**
+   * Read until the next valid "B" record.
+   *
+   * @return false on end-of-file
+   */
+  bool Next(IGCFix &fix);
+
+  /**
+   * The extensions declared by the most recent "I" record.
+   */
+  const IGCExtensions &GetExtensions() const {
+    return extensions;
+  }
+
+  /**
+   * The date of the most recent "HFDTE" record, or an invalid
+   * #BrokenDate if there was none yet.
+   */
+  const BrokenDate &GetDate() const {
+    return date;
+  }
+
+  size_t GetSize() const {
+    return end - begin;
+  }
+
+  size_t Tell() const {
+    return position - begin;
+  }
+
+private:
+  void ParseLine(const char *line, size_t length);
+};
+
+#endif
@@ -25,6 +25,10 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "Units/System.hpp"
 
+#include <algorithm>
+
+#include <math.h>
+
 bool
 IGCFix::Apply(const NMEAInfo &basic)
 {
@@ -80,5 +84,13 @@ IGCFix::Apply(const NMEAInfo &basic)
     ? (int16_t) basic.gps.satellites_used
     : -1;
 
+  /* the time of day has sub-second resolution if the receiver
+     delivers more than one fix per second */
+  const int tenths = int((basic.time - floor(basic.time)) * 10 + 0.05);
+  tds = (int16_t)std::min(tenths, 9);
+
+  if (basic.total_energy_vario_available)
+    vat = (int16_t)lround(basic.total_energy_vario * 10);
+
   return true;
 }
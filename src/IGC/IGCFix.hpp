@@ -27,6 +27,8 @@ Copyright_License {
 #include "Geo/GeoPoint.hpp"
 #include "Time/BrokenTime.hpp"
 
+#include <stdint.h>
+
 struct NMEAInfo;
 
 struct IGCFix
@@ -92,11 +94,26 @@ struct IGCFix
    */
   int16_t siu;
 
+  /**
+   * Tenths of the second [0 to 9], for fixes logged at more than
+   * 1 Hz.  Negative if undefined.
+   */
+  int16_t tds;
+
+  static constexpr int16_t VAT_UNDEFINED = INT16_MIN;
+
+  /**
+   * Total energy vario [dm/s].  #VAT_UNDEFINED if undefined.
+   */
+  int16_t vat;
+
   void ClearExtensions() {
     enl = rpm = -1;
     hdm = hdt = trm = trt = -1;
     gsp = ias = tas = -1;
     siu = -1;
+    tds = -1;
+    vat = VAT_UNDEFINED;
   }
 
   void Clear() {
@@ -30,6 +30,7 @@ Copyright_License {
 #include "Time/BrokenTime.hpp"
 #include "Util/CharUtil.hxx"
 #include "Util/StringAPI.hxx"
+#include "Compiler.h"
 
 #include <stdlib.h>
 
@@ -108,13 +109,74 @@ IGCParseDateRecord(const char *line, BrokenDate &date)
   return date.IsPlausible();
 }
 
+/**
+ * Check whether the null-terminated string has at least #n
+ * characters, without scanning all of it.
+ */
+gcc_pure
+static bool
+HasLength(const char *p, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    if (p[i] == 0)
+      return false;
+
+  return true;
+}
+
+/**
+ * Parse a decimal column with a fixed width.  All characters are
+ * validated without branching; the loop is unrolled by the compiler,
+ * because #width is a compile-time constant.
+ *
+ * @return the value, or -1 if a character is not a digit
+ */
+template<unsigned width>
+gcc_pure
+static inline int
+ParseFixedDigits(const char *p)
+{
+  unsigned value = 0;
+  bool invalid = false;
+
+  for (unsigned i = 0; i < width; ++i) {
+    const unsigned digit = (unsigned char)p[i] - '0';
+    invalid |= digit > 9;
+    value = value * 10 + digit;
+  }
+
+  return invalid ? -1 : int(value);
+}
+
+/**
+ * Parse a fixed-width decimal column which may start with a minus
+ * sign.
+ */
+template<unsigned width>
+static inline bool
+ParseFixedSigned(const char *p, int &value_r)
+{
+  int value;
+  if (*p == '-') {
+    value = ParseFixedDigits<width - 1>(p + 1);
+    if (value < 0)
+      return false;
+
+    value = -value;
+  } else {
+    value = ParseFixedDigits<width>(p);
+    if (value < 0)
+      return false;
+  }
+
+  value_r = value;
+  return true;
+}
+
 static int
 ParseTwoDigits(const char *p)
 {
-  if (!IsDigitASCII(p[0]) || !IsDigitASCII(p[1]))
-    return -1;
-
-  return (p[0] - '0') * 10 + (p[1] - '0');
+  return ParseFixedDigits<2>(p);
 }
 
 static bool
@@ -124,6 +186,35 @@ CheckThreeAlphaNumeric(const char *src)
     IsAlphaNumericASCII(src[2]);
 }
 
+gcc_pure
+static IGCExtension::Type
+LookupExtensionType(const char *code)
+{
+  static constexpr struct {
+    char code[4];
+    IGCExtension::Type type;
+  } types[] = {
+    { "ENL", IGCExtension::Type::ENL },
+    { "RPM", IGCExtension::Type::RPM },
+    { "HDM", IGCExtension::Type::HDM },
+    { "HDT", IGCExtension::Type::HDT },
+    { "TRM", IGCExtension::Type::TRM },
+    { "TRT", IGCExtension::Type::TRT },
+    { "GSP", IGCExtension::Type::GSP },
+    { "IAS", IGCExtension::Type::IAS },
+    { "TAS", IGCExtension::Type::TAS },
+    { "SIU", IGCExtension::Type::SIU },
+    { "TDS", IGCExtension::Type::TDS },
+    { "VAT", IGCExtension::Type::VAT },
+  };
+
+  for (const auto &i : types)
+    if (memcmp(code, i.code, 3) == 0)
+      return i.type;
+
+  return IGCExtension::Type::UNKNOWN;
+}
+
 bool
 IGCParseExtensions(const char *buffer, IGCExtensions &extensions)
 {
@@ -138,7 +229,7 @@ IGCParseExtensions(const char *buffer, IGCExtensions &extensions)
 
   extensions.clear();
 
-  while (count-- > 0) {
+  while (count-- > 0 && !extensions.full()) {
     const int start = ParseTwoDigits(buffer);
     if (start < 8)
       return false;
@@ -159,6 +250,7 @@ IGCParseExtensions(const char *buffer, IGCExtensions &extensions)
     x.finish = finish;
     memcpy(x.code, buffer, 3);
     x.code[3] = 0;
+    x.type = LookupExtensionType(x.code);
 
     buffer += 3;
   }
@@ -207,7 +299,7 @@ static void
 ParseExtensionValueN(const char *p, const char *end, size_t n,
                      int16_t &value_r)
 {
-  if (n > (size_t)(p - end))
+  if (n > (size_t)(end - p))
     /* string is too short */
     return;
 
@@ -216,23 +308,145 @@ ParseExtensionValueN(const char *p, const char *end, size_t n,
     value_r = value;
 }
 
-bool
-IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
+/**
+ * Parse an extension value which may start with a minus sign.
+ */
+static void
+ParseExtensionSigned(const char *p, const char *end, int16_t &value_r)
 {
-  if (*buffer != 'B')
+  const bool negative = p < end && *p == '-';
+  int value = ParseUnsigned(p + negative, end);
+  if (value >= 0)
+    value_r = negative ? -value : value;
+}
+
+/**
+ * Decode a time in IGC file format (HHMMSS).  The caller must
+ * ensure that 6 characters are readable.
+ */
+static bool
+DecodeTime(const char *buffer, BrokenTime &time)
+{
+  const int hour = ParseFixedDigits<2>(buffer);
+  const int minute = ParseFixedDigits<2>(buffer + 2);
+  const int second = ParseFixedDigits<2>(buffer + 4);
+  if ((hour | minute | second) < 0)
     return false;
 
-  BrokenTime time;
-  if (!IGCParseTime(buffer + 1, time))
+  time = BrokenTime(hour, minute, second);
+  return time.IsPlausible();
+}
+
+/**
+ * Decode a location in IGC file format (DDMMmmm[N/S]DDDMMmmm[E/W]).
+ * The caller must ensure that 17 characters are readable.
+ */
+static bool
+DecodeLocation(const char *buffer, GeoPoint &location)
+{
+  const int lat_degrees = ParseFixedDigits<2>(buffer);
+  const int lat_minutes = ParseFixedDigits<5>(buffer + 2);
+  const char lat_char = buffer[7];
+  const int lon_degrees = ParseFixedDigits<3>(buffer + 8);
+  const int lon_minutes = ParseFixedDigits<5>(buffer + 11);
+  const char lon_char = buffer[16];
+
+  if ((lat_degrees | lat_minutes | lon_degrees | lon_minutes) < 0)
     return false;
 
-  char valid_char;
-  int gps_altitude, pressure_altitude;
+  if (lat_degrees >= 90 || lat_minutes >= 60000 ||
+      (lat_char != 'N' && lat_char != 'S'))
+    return false;
+
+  if (lon_degrees >= 180 || lon_minutes >= 60000 ||
+      (lon_char != 'E' && lon_char != 'W'))
+    return false;
+
+  location.latitude = Angle::Degrees(lat_degrees +
+                                     lat_minutes / 60000.);
+  if (lat_char == 'S')
+    location.latitude.Flip();
+
+  location.longitude = Angle::Degrees(lon_degrees +
+                                      lon_minutes / 60000.);
+  if (lon_char == 'W')
+    location.longitude.Flip();
+
+  return true;
+}
+
+static void
+ParseExtension(const IGCExtension &extension,
+               const char *start, const char *finish, IGCFix &fix)
+{
+  switch (extension.type) {
+  case IGCExtension::Type::UNKNOWN:
+    break;
+
+  case IGCExtension::Type::ENL:
+    ParseExtensionValue(start, finish, fix.enl);
+    break;
+
+  case IGCExtension::Type::RPM:
+    ParseExtensionValue(start, finish, fix.rpm);
+    break;
+
+  case IGCExtension::Type::HDM:
+    ParseExtensionValue(start, finish, fix.hdm);
+    break;
+
+  case IGCExtension::Type::HDT:
+    ParseExtensionValue(start, finish, fix.hdt);
+    break;
 
-  if (sscanf(buffer + 24, "%c%05d%05d",
-             &valid_char, &pressure_altitude, &gps_altitude) != 3)
+  case IGCExtension::Type::TRM:
+    ParseExtensionValue(start, finish, fix.trm);
+    break;
+
+  case IGCExtension::Type::TRT:
+    ParseExtensionValue(start, finish, fix.trt);
+    break;
+
+  case IGCExtension::Type::GSP:
+    ParseExtensionValueN(start, finish, 3, fix.gsp);
+    break;
+
+  case IGCExtension::Type::IAS:
+    ParseExtensionValueN(start, finish, 3, fix.ias);
+    break;
+
+  case IGCExtension::Type::TAS:
+    ParseExtensionValueN(start, finish, 3, fix.tas);
+    break;
+
+  case IGCExtension::Type::SIU:
+    ParseExtensionValue(start, finish, fix.siu);
+    break;
+
+  case IGCExtension::Type::TDS:
+    ParseExtensionValue(start, finish, fix.tds);
+    break;
+
+  case IGCExtension::Type::VAT:
+    ParseExtensionSigned(start, finish, fix.vat);
+    break;
+  }
+}
+
+bool
+IGCParseFix(const char *buffer, size_t length,
+            const IGCExtensions &extensions, IGCFix &fix)
+{
+  /* the B record has a fixed layout:
+     B HHMMSS DDMMmmmN DDDMMmmmE V PPPPP GGGGG */
+  if (length < 35 || *buffer != 'B')
+    return false;
+
+  BrokenTime time;
+  if (!DecodeTime(buffer + 1, time))
     return false;
 
+  const char valid_char = buffer[24];
   if (valid_char == 'A')
     fix.gps_valid = true;
   else if (valid_char == 'V')
@@ -240,96 +454,52 @@ IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
   else
     return false;
 
+  int gps_altitude, pressure_altitude;
+  if (!ParseFixedSigned<5>(buffer + 25, pressure_altitude) ||
+      !ParseFixedSigned<5>(buffer + 30, gps_altitude))
+    return false;
+
   fix.gps_altitude = gps_altitude;
   fix.pressure_altitude = pressure_altitude;
 
-  if (!IGCParseLocation(buffer + 7, fix.location))
+  if (!DecodeLocation(buffer + 7, fix.location))
     return false;
 
   fix.time = time;
 
   fix.ClearExtensions();
 
-  const size_t line_length = strlen(buffer);
-  for (auto i = extensions.begin(), end = extensions.end(); i != end; ++i) {
-    const IGCExtension &extension = *i;
+  for (const IGCExtension &extension : extensions) {
     assert(extension.start > 0);
     assert(extension.finish >= extension.start);
 
-    if (extension.finish > line_length)
+    if (extension.finish > length)
       /* exceeds the input line length */
       continue;
 
-    const char *start = buffer + extension.start - 1;
-    const char *finish = buffer + extension.finish;
-
-    if (StringIsEqual(extension.code, "ENL"))
-      ParseExtensionValue(start, finish, fix.enl);
-    else if (StringIsEqual(extension.code, "RPM"))
-      ParseExtensionValue(start, finish, fix.rpm);
-    else if (StringIsEqual(extension.code, "HDM"))
-      ParseExtensionValue(start, finish, fix.hdm);
-    else if (StringIsEqual(extension.code, "HDT"))
-      ParseExtensionValue(start, finish, fix.hdt);
-    else if (StringIsEqual(extension.code, "TRM"))
-      ParseExtensionValue(start, finish, fix.trm);
-    else if (StringIsEqual(extension.code, "TRT"))
-      ParseExtensionValue(start, finish, fix.trt);
-    else if (StringIsEqual(extension.code, "GSP"))
-      ParseExtensionValueN(start, finish, 3, fix.gsp);
-    else if (StringIsEqual(extension.code, "IAS"))
-      ParseExtensionValueN(start, finish, 3, fix.ias);
-    else if (StringIsEqual(extension.code, "TAS"))
-      ParseExtensionValueN(start, finish, 3, fix.tas);
-    else if (StringIsEqual(extension.code, "SIU"))
-      ParseExtensionValue(start, finish, fix.siu);
+    ParseExtension(extension, buffer + extension.start - 1,
+                   buffer + extension.finish, fix);
   }
 
   return true;
 }
 
 bool
-IGCParseLocation(const char *buffer, GeoPoint &location)
+IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
 {
-  unsigned lat_degrees, lat_minutes, lon_degrees, lon_minutes;
-  char lat_char, lon_char;
-
-  if (sscanf(buffer, "%02u%05u%c%03u%05u%c",
-             &lat_degrees, &lat_minutes, &lat_char,
-             &lon_degrees, &lon_minutes, &lon_char) != 6)
-    return false;
-
-  if (lat_degrees >= 90 || lat_minutes >= 60000 ||
-      (lat_char != 'N' && lat_char != 'S'))
-    return false;
-
-  if (lon_degrees >= 180 || lon_minutes >= 60000 ||
-      (lon_char != 'E' && lon_char != 'W'))
-    return false;
-
-  location.latitude = Angle::Degrees(lat_degrees +
-                                     lat_minutes / 60000.);
-  if (lat_char == 'S')
-    location.latitude.Flip();
-
-  location.longitude = Angle::Degrees(lon_degrees +
-                                      lon_minutes / 60000.);
-  if (lon_char == 'W')
-    location.longitude.Flip();
+  return IGCParseFix(buffer, strlen(buffer), extensions, fix);
+}
 
-  return true;
+bool
+IGCParseLocation(const char *buffer, GeoPoint &location)
+{
+  return HasLength(buffer, 17) && DecodeLocation(buffer, location);
 }
 
 bool
 IGCParseTime(const char *buffer, BrokenTime &time)
 {
-  unsigned hour, minute, second;
-
-  if (sscanf(buffer, "%02u%02u%02u", &hour, &minute, &second) != 3)
-    return false;
-
-  time = BrokenTime(hour, minute, second);
-  return time.IsPlausible();
+  return HasLength(buffer, 6) && DecodeTime(buffer, time);
 }
 
 static bool
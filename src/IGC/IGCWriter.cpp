@@ -24,18 +24,20 @@ Copyright_License {
 #include "IGC/IGCWriter.hpp"
 #include "IGCString.hpp"
 #include "Generator.hpp"
+#include "IGCBRecord.hpp"
 #include "NMEA/Info.hpp"
 #include "Version.hpp"
 #include "OS/Path.hpp"
 
 #include <assert.h>
 
-IGCWriter::IGCWriter(Path path)
+IGCWriter::IGCWriter(Path path, bool _high_rate)
   :file(path,
         /* we use CREATE_VISIBLE here so the user can recover partial
            IGC files after a crash/battery failure/etc. */
         FileOutputStream::Mode::CREATE_VISIBLE),
-   buffered(file)
+   buffered(file),
+   high_rate(_high_rate)
 {
   fix.Clear();
 
@@ -130,7 +132,8 @@ IGCWriter::WriteHeader(const BrokenDateTime &date_time,
 
   WriteLine("HFDTM100DATUM:WGS-1984");
 
-  WriteLine(GetIRecord());
+  FormatIRecord(buffer);
+  WriteLine(buffer);
 }
 
 void
@@ -166,47 +169,21 @@ IGCWriter::LoggerNote(const TCHAR *text)
   WriteLine("LPLT", text);
 }
 
-/**
- * Applies range checks to the specified altitude value and converts
- * it to an integer suitable for printing in the IGC file.
- */
-static int
-NormalizeIGCAltitude(int value)
-{
-  if (value < -9999)
-    /* for negative values, there are only 4 characters left (after
-       the minus sign), and besides that, IGC does not support a
-       journey towards the center of the earth */
-    return -9999;
-
-  if (value >= 99999)
-    /* hooray, new world record! .. or just some invalid value; we
-       have only 5 characters for the altitude, so we must clip it at
-       99999 */
-    return 99999;
-
-  return value;
-}
-
 void
 IGCWriter::LogPoint(const IGCFix &fix, int epe, int satellites)
 {
-  char b_record[128];
-  char *p = b_record;
-
-  sprintf(p, "B%02d%02d%02d", fix.time.hour, fix.time.minute, fix.time.second);
-  p += strlen(p);
-
-  p = FormatIGCLocation(p, fix.location);
+  static_assert(IGCHighRateBRecord::LENGTH < MAX_IGC_BUFF,
+                "Buffer too small");
 
-  sprintf(p, "%c%05d%05d%03d%02d",
-          fix.gps_valid ? 'A' : 'V',
-          NormalizeIGCAltitude(fix.pressure_altitude),
-          NormalizeIGCAltitude(fix.gps_altitude),
-          epe, satellites);
+  char *const b_record = BeginLine();
+  if (high_rate)
+    IGCHighRateBRecord::Format(b_record, fix, epe, satellites);
+  else
+    IGCBasicBRecord::Format(b_record, fix, epe, satellites);
 
-  WriteLine(b_record);
-  Flush();
+  /* the formatter emits plain ASCII only, no need for
+     CopyIGCString() */
+  CommitLine(b_record);
 }
 
 void
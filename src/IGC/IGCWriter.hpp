@@ -49,18 +49,40 @@ class IGCWriter {
 
   IGCFix fix;
 
+  /**
+   * Write the extended B record (#IGCHighRateBRecord) instead of
+   * #IGCBasicBRecord?
+   */
+  const bool high_rate;
+
   char buffer[MAX_IGC_BUFF];
 
 public:
   /**
    * Create a new IGC file.  The caller must check IsOpen().
+   *
+   * @param high_rate write the extended B record suitable for fixes
+   * logged at more than 1 Hz
    */
-  explicit IGCWriter(Path path);
+  explicit IGCWriter(Path path, bool high_rate=false);
 
+  /**
+   * Pass buffered records to the operating system.  This survives a
+   * crash of XCSoar, but not necessarily a power loss.
+   */
   void Flush() {
     buffered.Flush();
   }
 
+  /**
+   * Like Flush(), but wait until the records have reached the
+   * storage device.  This may be very slow (e.g. on SD cards).
+   */
+  void Sync() {
+    buffered.Flush();
+    file.Sync();
+  }
+
   void Sign();
 
 private:
@@ -85,12 +107,18 @@ private:
   void WriteLine(const char *a, const TCHAR *b);
 
   static const char *GetHFFXARecord();
-  static const char *GetIRecord();
+
+  /**
+   * Write the I record matching the B record format to the buffer
+   * (at least 64 bytes).
+   */
+  void FormatIRecord(char *buffer) const;
+
+public:
   static double GetEPE(const GPSState &gps);
   /** Satellites in use if logger fix quality is a valid gps */
   static int GetSIU(const GPSState &gps);
 
-public:
   /**
    * @param logger_id the ID of the logger, consisting of exactly 3
    * alphanumeric characters (plain ASCII)
@@ -109,16 +137,23 @@ public:
 
   void LoggerNote(const TCHAR *text);
 
+  /**
+   * Write a B record.  It is not flushed; that is up to the caller
+   * (see Flush() and Sync()).
+   */
   void LogPoint(const IGCFix &fix, int epe, int satellites);
   void LogPoint(const NMEAInfo &gps_info);
   void LogEvent(const IGCFix &fix, int epe, int satellites, const char *event);
   void LogEvent(const NMEAInfo &gps_info, const char *event);
 
+  /**
+   * Write just the E record, without the B record which must follow
+   * it.
+   */
+  void LogEvent(const BrokenTime &time, const char *event = "");
+
   void LogEmptyFRecord(const BrokenTime &time);
   void LogFRecord(const BrokenTime &time, const int *satellite_ids);
-
-protected:
-  void LogEvent(const BrokenTime &time, const char *event = "");
 };
 
 #endif
@@ -28,6 +28,7 @@ Copyright_License {
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 static const char *
 EndOfLine(const char *line)
@@ -41,10 +42,10 @@ CSVLine::CSVLine(const char *line):
 size_t
 CSVLine::Skip()
 {
-  const char* _seperator = strchr(data, ',');
-  if (_seperator != nullptr && _seperator < end) {
-    size_t length = _seperator - data;
-    data = _seperator + 1;
+  const char *separator = (const char *)memchr(data, ',', end - data);
+  if (separator != nullptr) {
+    size_t length = separator - data;
+    data = separator + 1;
     return length;
   } else {
     size_t length = end - data;
@@ -67,23 +68,31 @@ CSVLine::ReadOneChar()
   return Skip() == 1 ? ch : '\0';
 }
 
-void
-CSVLine::Read(char *dest, size_t size)
+Range<const char *>
+CSVLine::ReadView()
 {
   const char *src = data;
   size_t length = Skip();
+  return Range<const char *>(src, src + length);
+}
+
+void
+CSVLine::Read(char *dest, size_t size)
+{
+  const auto column = ReadView();
+  size_t length = column.end() - column.begin();
   if (length >= size)
     length = size - 1;
-  *std::copy_n(src, length, dest) = '\0';
+  *std::copy_n(column.begin(), length, dest) = '\0';
 }
 
 bool
 CSVLine::ReadCompare(const char *value)
 {
-  size_t length = strlen(value);
-  char buffer[length + 2];
-  Read(buffer, length + 2);
-  return StringIsEqual(buffer, value);
+  const auto column = ReadView();
+  const size_t length = column.end() - column.begin();
+  return length == strlen(value) &&
+    memcmp(column.begin(), value, length) == 0;
 }
 
 long
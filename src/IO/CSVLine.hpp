@@ -69,6 +69,12 @@ public:
    */
   char ReadOneChar();
 
+  /**
+   * Read a column without copying it.  The returned range points
+   * into the line buffer.
+   */
+  Range<const char *> ReadView();
+
   void Read(char *dest, size_t size);
   bool ReadCompare(const char *value);
 
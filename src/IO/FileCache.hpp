@@ -26,9 +26,13 @@ Copyright_License {
 
 #include "OS/Path.hpp"
 
+#include <memory>
+
 #include <stdio.h>
 #include <tchar.h>
 
+class FileMapping;
+
 class FileCache {
   AllocatedPath cache_path;
 
@@ -45,6 +49,17 @@ public:
   void Flush(const TCHAR *name);
   FILE *Load(const TCHAR *name, Path original_path);
 
+  /**
+   * Like Load(), but map the cache file into memory instead of
+   * opening a stream.
+   *
+   * @param offset_r on success, receives the position of the data
+   * within the mapping (after the cache header)
+   * @return the mapping, or nullptr if there is no valid cache file
+   */
+  std::unique_ptr<FileMapping> Map(const TCHAR *name, Path original_path,
+                                   size_t &offset_r);
+
   FILE *Save(const TCHAR *name, Path original_path);
   bool Commit(const TCHAR *name, FILE *file);
   void Cancel(const TCHAR *name, FILE *file);
@@ -109,6 +109,14 @@ public:
 	/* virtual methods from class OutputStream */
 	void Write(const void *data, size_t size) override;
 
+	/**
+	 * Make sure everything written so far has reached the
+	 * storage device, i.e. survives a power loss.
+	 *
+	 * Throws std::runtime_error on error.
+	 */
+	void Sync();
+
 	void Commit();
 	void Cancel();
 
@@ -62,6 +62,8 @@ doc/html/advanced/input/ALL		http://xcsoar.sourceforge.net/advanced/input/
 #include "Dialogs/FileManager.hpp"
 #include "Dialogs/ReplayDialog.hpp"
 #include "Message.hpp"
+#include "FrameProfiler.hpp"
+#include "LocalPath.hpp"
 #include "Markers/Markers.hpp"
 #include "MainWindow.hpp"
 #include "PopupMessage.hpp"
@@ -88,6 +90,7 @@ doc/html/advanced/input/ALL		http://xcsoar.sourceforge.net/advanced/input/
 #include <assert.h>
 #include <tchar.h>
 #include <algorithm>
+#include <stdexcept>
 
 /**
  * Determine the reference location of the current map display.
@@ -446,6 +449,40 @@ InputEvents::eventLogger(const TCHAR *misc)
     logger->LoggerNote(misc + 4);
 }
 
+// FrameProfiler
+// on: enables the map frame profiler (discarding old data)
+// off: disables the frame profiler
+// toggle: toggles the frame profiler
+// show: writes the per-layer statistics to the log file
+// export: writes the recorded frames to frame-profile.json
+void
+InputEvents::eventFrameProfiler(const TCHAR *misc)
+{
+  if (StringIsEqual(misc, _T("on")))
+    FrameProfiler::SetEnabled(true);
+  else if (StringIsEqual(misc, _T("off")))
+    FrameProfiler::SetEnabled(false);
+  else if (StringIsEqual(misc, _T("toggle")))
+    FrameProfiler::SetEnabled(!FrameProfiler::IsEnabled());
+  else if (StringIsEqual(misc, _T("show"))) {
+    FrameProfiler::Log();
+    return;
+  } else if (StringIsEqual(misc, _T("export"))) {
+    try {
+      FrameProfiler::ExportChromeTrace(LocalPath(_T("frame-profile.json")));
+      Message::AddMessage(_("Frame profile saved"));
+    } catch (const std::runtime_error &e) {
+      ShowError(e, _("Frame profiler"));
+    }
+
+    return;
+  }
+
+  Message::AddMessage(FrameProfiler::IsEnabled()
+                      ? _("Frame profiler on")
+                      : _("Frame profiler off"));
+}
+
 // RepeatStatusMessage
 // Repeats the last status message.  If pressed repeatedly, will
 // repeat previous status messages
@@ -186,10 +186,16 @@ namespace CommonInterface {
     Private::blackboard.ReadBlackboardBasic(nmea_info);
   }
 
-  static inline void ReadBlackboardCalculated(const DerivedInfo &derived_info) {
+  static inline void ReadBlackboardCalculated(const CalculatedSnapshot &snapshot) {
     assert(InMainThread());
 
-    Private::blackboard.ReadBlackboardCalculated(derived_info);
+    Private::blackboard.ReadBlackboardCalculated(snapshot);
+  }
+
+  static inline void MarkSkyLinesChanged() {
+    assert(InMainThread());
+
+    Private::blackboard.MarkSkyLinesChanged();
   }
 
   static inline void ReadCommonStats(const CommonStats &common_stats) {
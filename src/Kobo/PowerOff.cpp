@@ -33,8 +33,9 @@ Copyright_License {
 #include "Screen/Layout.hpp"
 #include "Renderer/FlightListRenderer.hpp"
 #include "FlightInfo.hpp"
-#include "Logger/FlightParser.hpp"
-#include "IO/FileLineReader.hpp"
+#include "Logger/FlightDatabase.hpp"
+#include "OS/Path.hpp"
+#include "Util/Macros.hpp"
 #include "Resources.hpp"
 #include "Model.hpp"
 
@@ -95,14 +96,17 @@ DrawBanner(Canvas &canvas, PixelRect &rc)
 static void
 DrawFlights(Canvas &canvas, const PixelRect &rc)
 try {
-  FileLineReaderA file(Path("/mnt/onboard/XCSoarData/flights.log"));
+  FlightDatabase db;
+  OpenFlightDatabase(db, Path("/mnt/onboard/XCSoarData/flights.idx"),
+                     Path("/mnt/onboard/XCSoarData/flights.log"));
 
   FlightListRenderer renderer(normal_font, bold_font);
 
-  FlightParser parser(file);
-  FlightInfo flight;
-  while (parser.Read(flight))
-    renderer.AddFlight(flight);
+  /* only the most recent flights fit on the screen */
+  FlightInfo flights[FlightListRenderer::MAX_FLIGHTS];
+  const unsigned n = db.ReadLast(flights, ARRAY_SIZE(flights));
+  for (unsigned i = 0; i < n; ++i)
+    renderer.AddFlight(flights[i]);
 
   renderer.Draw(canvas, rc);
 } catch (const std::runtime_error &e) {
@@ -0,0 +1,357 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FlightDatabase.hpp"
+#include "FlightParser.hpp"
+#include "IO/FileLineReader.hpp"
+#include "OS/FileUtil.hpp"
+#include "OS/Path.hpp"
+#include "Time/BrokenDateTime.hpp"
+#include "Util/Macros.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <assert.h>
+#include <string.h>
+#include <tchar.h>
+
+bool
+FlightDatabase::Open(Path path)
+{
+  Close();
+
+  file = _tfopen(path.c_str(), _T("r+b"));
+  if (file == nullptr)
+    return false;
+
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      header.magic != MAGIC || header.version != VERSION ||
+      header.record_size != sizeof(Record) ||
+      /* the file must contain all records, nothing more */
+      fseek(file, 0, SEEK_END) != 0 ||
+      ftell(file) != GetRecordOffset(header.n_records) ||
+      (header.n_records > 0 && !ReadRecord(header.n_records - 1, last))) {
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+bool
+FlightDatabase::Create(Path path)
+{
+  Close();
+
+  file = _tfopen(path.c_str(), _T("w+b"));
+  if (file == nullptr)
+    return false;
+
+  memset(&header, 0, sizeof(header));
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.record_size = sizeof(Record);
+  header.flags = SORTED;
+
+  if (!Commit()) {
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+void
+FlightDatabase::Close()
+{
+  if (file != nullptr) {
+    fclose(file);
+    file = nullptr;
+  }
+}
+
+bool
+FlightDatabase::Commit()
+{
+  assert(IsOpen());
+
+  return fseek(file, 0, SEEK_SET) == 0 &&
+    fwrite(&header, sizeof(header), 1, file) == 1 &&
+    fflush(file) == 0;
+}
+
+bool
+FlightDatabase::ReadRecord(unsigned i, Record &record) const
+{
+  assert(IsOpen());
+  assert(i < header.n_records);
+
+  return fseek(file, GetRecordOffset(i), SEEK_SET) == 0 &&
+    fread(&record, sizeof(record), 1, file) == 1;
+}
+
+bool
+FlightDatabase::WriteRecord(unsigned i, const Record &record)
+{
+  assert(IsOpen());
+  assert(i <= header.n_records);
+
+  return fseek(file, GetRecordOffset(i), SEEK_SET) == 0 &&
+    fwrite(&record, sizeof(record), 1, file) == 1;
+}
+
+FlightDatabase::Record
+FlightDatabase::ToRecord(const FlightInfo &flight)
+{
+  Record record;
+  record.year = flight.date.year;
+  record.month = flight.date.month;
+  record.day = flight.date.day;
+  record.start_hour = flight.start_time.hour;
+  record.start_minute = flight.start_time.minute;
+  record.start_second = flight.start_time.second;
+  record.end_hour = flight.end_time.hour;
+  record.end_minute = flight.end_time.minute;
+  record.end_second = flight.end_time.second;
+  record.reserved[0] = record.reserved[1] = 0;
+  return record;
+}
+
+FlightInfo
+FlightDatabase::ToFlightInfo(const Record &record)
+{
+  FlightInfo flight;
+  flight.date = BrokenDate(record.year, record.month, record.day);
+  flight.start_time = BrokenTime(record.start_hour, record.start_minute,
+                                 record.start_second);
+  flight.end_time = BrokenTime(record.end_hour, record.end_minute,
+                               record.end_second);
+  return flight;
+}
+
+void
+FlightDatabase::AddToTotals(const FlightInfo &flight)
+{
+  if (flight.date.year < FIRST_YEAR ||
+      flight.date.year >= FIRST_YEAR + N_YEARS)
+    return;
+
+  YearTotal &total = header.totals[flight.date.year - FIRST_YEAR];
+  ++total.flights;
+
+  const int duration = flight.Duration();
+  if (duration > 0)
+    total.duration += duration;
+}
+
+bool
+FlightDatabase::Append(const FlightInfo &flight)
+{
+  const Record record = ToRecord(flight);
+  if (!WriteRecord(header.n_records, record))
+    return false;
+
+  if (header.n_records > 0 &&
+      BrokenDate(record.year, record.month, record.day) <
+      BrokenDate(last.year, last.month, last.day))
+    header.flags &= ~SORTED;
+
+  ++header.n_records;
+  last = record;
+
+  AddToTotals(flight);
+  return true;
+}
+
+bool
+FlightDatabase::AppendStart(const BrokenDateTime &date_time)
+{
+  FlightInfo flight;
+  flight.date = date_time;
+  flight.start_time = date_time;
+  flight.end_time = BrokenTime::Invalid();
+  return Append(flight);
+}
+
+bool
+FlightDatabase::AppendLanding(const BrokenDateTime &date_time)
+{
+  if (header.n_records > 0) {
+    FlightInfo flight = ToFlightInfo(last);
+    if (flight.date.IsPlausible() && flight.start_time.IsPlausible() &&
+        !flight.end_time.IsPlausible()) {
+      const int duration =
+        date_time - BrokenDateTime(flight.date, flight.start_time);
+      if (duration >= 0 && duration <= 14 * 60 * 60) {
+        /* this landing belongs to the open flight: complete it */
+        flight.end_time = date_time;
+
+        const Record record = ToRecord(flight);
+        if (!WriteRecord(header.n_records - 1, record))
+          return false;
+
+        last = record;
+
+        /* the flight has already been counted; now add its
+           duration */
+        const int flight_duration = flight.Duration();
+        if (flight.date.year >= FIRST_YEAR &&
+            flight.date.year < FIRST_YEAR + N_YEARS &&
+            flight_duration > 0)
+          header.totals[flight.date.year - FIRST_YEAR].duration +=
+            flight_duration;
+
+        return true;
+      }
+    }
+  }
+
+  /* landing without a matching start */
+  FlightInfo flight;
+  flight.date = date_time;
+  flight.start_time = BrokenTime::Invalid();
+  flight.end_time = date_time;
+  return Append(flight);
+}
+
+bool
+FlightDatabase::Read(unsigned i, FlightInfo &flight) const
+{
+  Record record;
+  if (!ReadRecord(i, record))
+    return false;
+
+  flight = ToFlightInfo(record);
+  return true;
+}
+
+unsigned
+FlightDatabase::Read(unsigned first, FlightInfo *flights, unsigned max) const
+{
+  assert(IsOpen());
+
+  if (first >= header.n_records)
+    return 0;
+
+  max = std::min(max, header.n_records - first);
+
+  Record buffer[64];
+  unsigned n = 0;
+  if (fseek(file, GetRecordOffset(first), SEEK_SET) != 0)
+    return 0;
+
+  while (n < max) {
+    const unsigned chunk = std::min(max - n, unsigned(ARRAY_SIZE(buffer)));
+    if (fread(buffer, sizeof(buffer[0]), chunk, file) != chunk)
+      break;
+
+    for (unsigned i = 0; i < chunk; ++i)
+      flights[n++] = ToFlightInfo(buffer[i]);
+  }
+
+  return n;
+}
+
+unsigned
+FlightDatabase::ReadLast(FlightInfo *flights, unsigned max) const
+{
+  const unsigned n = std::min(max, header.n_records);
+  return Read(header.n_records - n, flights, n);
+}
+
+unsigned
+FlightDatabase::LowerBound(const BrokenDate &date) const
+{
+  unsigned low = 0, high = header.n_records;
+  while (low < high) {
+    const unsigned middle = low + (high - low) / 2;
+
+    Record record;
+    if (!ReadRecord(middle, record))
+      return header.n_records;
+
+    if (BrokenDate(record.year, record.month, record.day) < date)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  return low;
+}
+
+unsigned
+FlightDatabase::FindRange(const BrokenDate &from, const BrokenDate &to,
+                          unsigned &first_r) const
+{
+  if (!(header.flags & SORTED)) {
+    first_r = 0;
+    return header.n_records;
+  }
+
+  first_r = LowerBound(from);
+
+  /* the day after #to */
+  const BrokenDate end =
+    BrokenDateTime(to, BrokenTime::Midnight()) + 24 * 60 * 60;
+  const unsigned last_r = std::max(first_r, LowerBound(end));
+  return last_r - first_r;
+}
+
+FlightDatabase::YearTotal
+FlightDatabase::GetYearTotal(unsigned year) const
+{
+  if (year < FIRST_YEAR || year >= FIRST_YEAR + N_YEARS)
+    return YearTotal{0, 0};
+
+  return header.totals[year - FIRST_YEAR];
+}
+
+void
+OpenFlightDatabase(FlightDatabase &db, Path path, Path log_path)
+{
+  const uint64_t log_size = File::Exists(log_path)
+    ? File::GetSize(log_path)
+    : 0;
+
+  if (db.Open(path) && db.GetLogSize() == log_size)
+    return;
+
+  /* missing, incompatible or stale: migrate from the text log */
+
+  if (!db.Create(path))
+    throw std::runtime_error("Failed to create the flight database");
+
+  if (log_size > 0) {
+    FileLineReaderA reader(log_path);
+    FlightParser parser(reader);
+    FlightInfo flight;
+    while (parser.Read(flight))
+      if (!db.Append(flight))
+        throw std::runtime_error("Failed to write the flight database");
+  }
+
+  db.SetLogSize(log_size);
+  if (!db.Commit())
+    throw std::runtime_error("Failed to write the flight database");
+}
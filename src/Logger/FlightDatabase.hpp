@@ -0,0 +1,241 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLIGHT_DATABASE_HPP
+#define XCSOAR_FLIGHT_DATABASE_HPP
+
+#include "FlightInfo.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+
+class Path;
+struct BrokenDateTime;
+
+/**
+ * A binary index of the flights recorded in the #FlightLogger text
+ * file (flights.log).  It is a fixed-size header, followed by one
+ * fixed-size record per flight in the order they were logged.  The
+ * header holds the number of records and the totals per year, so
+ * "the last N flights", "the flights between two dates" and the
+ * yearly summary are answered without reading the whole log.
+ *
+ * The file is append-only, except that a landing completes the last
+ * record in place.  It remembers the size of the text log it was built
+ * from; OpenFlightDatabase() rebuilds it if the text log has changed
+ * behind its back.
+ */
+class FlightDatabase {
+public:
+  static constexpr unsigned FIRST_YEAR = 2000;
+  static constexpr unsigned N_YEARS = 64;
+
+  struct YearTotal {
+    uint32_t flights;
+
+    /**
+     * The sum of all known flight durations [s].
+     */
+    uint32_t duration;
+  };
+
+private:
+  static constexpr uint32_t MAGIC = 0x42444c46; /* "FLDB" */
+  static constexpr uint16_t VERSION = 1;
+
+  enum Flags : uint32_t {
+    /**
+     * All records are ordered by date.  Cleared when a record was
+     * appended out of order (e.g. after the clock was wrong), which
+     * makes date queries fall back to a linear scan.
+     */
+    SORTED = 0x1,
+  };
+
+  struct Record {
+    uint16_t year;
+    uint8_t month, day;
+    uint8_t start_hour, start_minute, start_second;
+    uint8_t end_hour, end_minute, end_second;
+    uint8_t reserved[2];
+  };
+
+  static_assert(sizeof(Record) == 12, "Wrong record size");
+
+  struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t n_records;
+    uint32_t flags;
+
+    /**
+     * The size of the text log at the time of the last update.
+     */
+    uint64_t log_size;
+
+    YearTotal totals[N_YEARS];
+  };
+
+  FILE *file = nullptr;
+
+  Header header;
+
+  /**
+   * The last record, cached for completing it with a landing.  Only
+   * valid if header.n_records > 0.
+   */
+  Record last;
+
+public:
+  FlightDatabase() = default;
+
+  ~FlightDatabase() {
+    Close();
+  }
+
+  FlightDatabase(const FlightDatabase &) = delete;
+  FlightDatabase &operator=(const FlightDatabase &) = delete;
+
+  bool IsOpen() const {
+    return file != nullptr;
+  }
+
+  /**
+   * Open an existing database for reading and writing.
+   *
+   * @return false if the file does not exist or is not compatible
+   */
+  bool Open(Path path);
+
+  /**
+   * Create a new empty database, replacing the existing one.
+   */
+  bool Create(Path path);
+
+  void Close();
+
+  unsigned size() const {
+    return header.n_records;
+  }
+
+  bool empty() const {
+    return header.n_records == 0;
+  }
+
+  uint64_t GetLogSize() const {
+    return header.log_size;
+  }
+
+  void SetLogSize(uint64_t log_size) {
+    header.log_size = log_size;
+  }
+
+  /**
+   * Append a complete flight, as parsed by #FlightParser.
+   */
+  bool Append(const FlightInfo &flight);
+
+  /**
+   * Record a takeoff: this begins a new flight.
+   */
+  bool AppendStart(const BrokenDateTime &date_time);
+
+  /**
+   * Record a landing: this completes the last flight if it is still
+   * open and plausible, and adds a landing-only flight otherwise
+   * (same rules as #FlightParser).
+   */
+  bool AppendLanding(const BrokenDateTime &date_time);
+
+  /**
+   * Write the header.  Call this after modifying the database.
+   */
+  bool Commit();
+
+  /**
+   * Read flight number #i (0 is the oldest).
+   */
+  bool Read(unsigned i, FlightInfo &flight) const;
+
+  /**
+   * Read up to #max flights, starting at flight number #first.
+   *
+   * @return the number of flights read
+   */
+  unsigned Read(unsigned first, FlightInfo *flights, unsigned max) const;
+
+  /**
+   * Read the most recent #max flights (oldest first).
+   *
+   * @return the number of flights read
+   */
+  unsigned ReadLast(FlightInfo *flights, unsigned max) const;
+
+  /**
+   * Find the flights dated between #from and #to (inclusive).
+   *
+   * @param first_r receives the number of the first matching flight
+   * @return the number of matching flights; if the database is not
+   * #SORTED, this is the range of records which needs to be filtered
+   * by the caller
+   */
+  unsigned FindRange(const BrokenDate &from, const BrokenDate &to,
+                     unsigned &first_r) const;
+
+  /**
+   * @return the totals of the given year (all zero if no flight
+   * or out of range)
+   */
+  YearTotal GetYearTotal(unsigned year) const;
+
+private:
+  static constexpr long GetRecordOffset(unsigned i) {
+    return long(sizeof(Header) + i * sizeof(Record));
+  }
+
+  bool ReadRecord(unsigned i, Record &record) const;
+  bool WriteRecord(unsigned i, const Record &record);
+
+  /**
+   * Find the first flight dated on or after #date.
+   */
+  unsigned LowerBound(const BrokenDate &date) const;
+
+  static Record ToRecord(const FlightInfo &flight);
+  static FlightInfo ToFlightInfo(const Record &record);
+
+  void AddToTotals(const FlightInfo &flight);
+};
+
+/**
+ * Open the flight database at #path and bring it up to date with the
+ * text log at #log_path, rebuilding it from the text log if it is
+ * missing, incompatible or stale.
+ *
+ * Throws std::runtime_error on I/O error.
+ */
+void
+OpenFlightDatabase(FlightDatabase &db, Path path, Path log_path);
+
+#endif
@@ -22,11 +22,16 @@ Copyright_License {
 */
 
 #include "FlightLogger.hpp"
+#include "FlightDatabase.hpp"
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 #include "IO/FileOutputStream.hxx"
 #include "IO/BufferedOutputStream.hxx"
 #include "LogFile.hpp"
+#include "Util/StringAPI.hxx"
+
+#include <stdio.h>
+#include <string.h>
 
 void
 FlightLogger::Reset()
@@ -37,21 +42,46 @@ FlightLogger::Reset()
   landing_time.Clear();
 }
 
+void
+FlightLogger::UpdateIndex(const BrokenDateTime &date_time, bool landing,
+                          size_t line_length)
+try {
+  if (index_path.IsNull())
+    return;
+
+  /* this is called before the line is appended to the text log, so a
+     stale index gets rebuilt first */
+  FlightDatabase db;
+  OpenFlightDatabase(db, index_path, path);
+
+  if (!(landing ? db.AppendLanding(date_time) : db.AppendStart(date_time)))
+    throw std::runtime_error("Failed to update the flight database");
+
+  db.SetLogSize(db.GetLogSize() + line_length);
+  if (!db.Commit())
+    throw std::runtime_error("Failed to update the flight database");
+} catch (const std::runtime_error &e) {
+  LogError(e);
+}
+
 void
 FlightLogger::LogEvent(const BrokenDateTime &date_time, const char *type)
 try {
   assert(type != nullptr);
 
-  FileOutputStream file(path, FileOutputStream::Mode::APPEND_OR_CREATE);
-  BufferedOutputStream writer(file);
-
   /* XXX log pilot name, glider, airfield name */
 
-  writer.Format("%04u-%02u-%02uT%02u:%02u:%02u %s\n",
-                date_time.year, date_time.month, date_time.day,
-                date_time.hour, date_time.minute, date_time.second,
-                type);
+  char line[64];
+  snprintf(line, sizeof(line), "%04u-%02u-%02uT%02u:%02u:%02u %s\n",
+           date_time.year, date_time.month, date_time.day,
+           date_time.hour, date_time.minute, date_time.second,
+           type);
+
+  UpdateIndex(date_time, StringIsEqual(type, "landing"), strlen(line));
 
+  FileOutputStream file(path, FileOutputStream::Mode::APPEND_OR_CREATE);
+  BufferedOutputStream writer(file);
+  writer.Write(line);
   writer.Flush();
   file.Commit();
 } catch (const std::runtime_error &e) {
@@ -27,6 +27,8 @@ Copyright_License {
 #include "Time/BrokenDateTime.hpp"
 #include "OS/Path.hpp"
 
+#include <stddef.h>
+
 struct MoreData;
 struct DerivedInfo;
 
@@ -42,6 +44,12 @@ struct DerivedInfo;
 class FlightLogger {
   AllocatedPath path = nullptr;
 
+  /**
+   * The #FlightDatabase which is kept up to date with the text log.
+   * Optional.
+   */
+  AllocatedPath index_path = nullptr;
+
   double last_time;
   bool seen_on_ground, seen_flying;
 
@@ -65,6 +73,14 @@ public:
     path = _path;
   }
 
+  /**
+   * Maintain a #FlightDatabase at the given path.  It is created
+   * from the text log if it does not exist yet.
+   */
+  void SetIndexPath(Path _path) {
+    index_path = _path;
+  }
+
   void Reset();
 
   /**
@@ -75,6 +91,13 @@ public:
 private:
   void LogEvent(const BrokenDateTime &date_time, const char *type);
 
+  /**
+   * Add the event to the #FlightDatabase (if enabled), just before
+   * the line is appended to the text log.
+   */
+  void UpdateIndex(const BrokenDateTime &date_time, bool landing,
+                   size_t line_length);
+
   void TickInternal(const MoreData &basic, const DerivedInfo &calculated);
 };
 
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "IGC/IGCWriter.hpp"
+#include "IGC/IGCBRecord.hpp"
 #include "NMEA/GPSState.hpp"
 
 /*
@@ -64,8 +65,8 @@ IGCWriter::GetHFFXARecord()
   return "HFFXA050";
 }
 
-const char *
-IGCWriter::GetIRecord()
+void
+IGCWriter::FormatIRecord(char *buffer) const
 {
   /*
    * I Record
@@ -88,8 +89,18 @@ IGCWriter::GetIRecord()
    *    Param 2 = SIU from bytes 39-40
    *
    * ---> I023638FXA3940SIU  (no spaces)
+   *
+   * When logging at high rate, the engine noise level, the tenths of
+   * the second, the true airspeed and the total energy vario follow:
+   *
+   * ---> I063638FXA3940SIU4143ENL4444TDS4547TAS4851VAT
+   *
+   * Both are generated from the B record format (IGCBRecord.hpp).
    */
-  return "I023638FXA3940SIU";
+  if (high_rate)
+    IGCHighRateBRecord::FormatIRecord(buffer);
+  else
+    IGCBasicBRecord::FormatIRecord(buffer);
 }
 
 double
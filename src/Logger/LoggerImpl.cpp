@@ -32,12 +32,15 @@
 #include "Formatter/IGCFilenameFormatter.hpp"
 #include "Interface.hpp"
 #include "IGCFileCleanup.hpp"
-#include "IGC/IGCWriter.hpp"
+#include "IGC/AsyncIGCWriter.hpp"
 #include "Util/CharUtil.hxx"
 
 #include <tchar.h>
 #include <algorithm>
 
+static_assert(AsyncIGCWriter::QUEUE_SIZE > LoggerImpl::PRETAKEOFF_BUFFER_MAX,
+              "The IGC writer queue must take the whole pre-takeoff buffer");
+
 const struct LoggerImpl::PreTakeoffBuffer &
 LoggerImpl::PreTakeoffBuffer::operator=(const NMEAInfo &src)
 {
@@ -69,6 +72,19 @@ LoggerImpl::PreTakeoffBuffer::operator=(const NMEAInfo &src)
   hdop = src.gps.hdop;
   real = src.gps.real;
 
+  /* the extensions of the high-rate B record */
+  airspeed_available = src.airspeed_available;
+  if (airspeed_available)
+    true_airspeed = src.true_airspeed;
+
+  total_energy_vario_available = src.total_energy_vario_available;
+  if (total_energy_vario_available)
+    total_energy_vario = src.total_energy_vario;
+
+  engine_noise_level_available = src.engine_noise_level_available;
+  if (engine_noise_level_available)
+    engine_noise_level = src.engine_noise_level;
+
   satellite_ids_available = src.gps.satellite_ids_available;
   if (satellite_ids_available)
     std::copy_n(src.gps.satellite_ids, GPSState::MAXSATELLITES, satellite_ids);
@@ -83,7 +99,10 @@ LoggerImpl::LoggerImpl()
 
 LoggerImpl::~LoggerImpl()
 {
-  delete writer;
+  if (writer != nullptr) {
+    writer->Stop(false);
+    delete writer;
+  }
 }
 
 void
@@ -93,12 +112,10 @@ LoggerImpl::StopLogger(const NMEAInfo &gps_info)
   if (writer == nullptr)
     return;
 
-  writer->Flush();
-
-  if (!simulator)
-    writer->Sign();
+  writer->Stop(!simulator);
 
-  writer->Flush();
+  if (writer->GetDroppedCount() > 0)
+    LogFormat("Logger dropped %u records", writer->GetDroppedCount());
 
   LogFormat(_T("Logger stopped: %s"), filename.c_str());
 
@@ -122,6 +139,11 @@ LoggerImpl::LogPointToBuffer(const NMEAInfo &gps_info)
   PreTakeoffBuffer item;
   item = gps_info;
   pre_takeoff_buffer.push(item);
+
+  /* the buffer is sized for high-rate logging; at lower rates, limit
+     it by age instead */
+  while (pre_takeoff_buffer.peek().time + PRETAKEOFF_DURATION < item.time)
+    pre_takeoff_buffer.shift();
 }
 
 void
@@ -190,6 +212,17 @@ LoggerImpl::LogPoint(const NMEAInfo &gps_info)
     tmp_info.gps.hdop = src.hdop;
     tmp_info.gps.real = src.real;
 
+    if (src.airspeed_available)
+      tmp_info.ProvideTrueAirspeed(src.true_airspeed);
+
+    if (src.total_energy_vario_available)
+      tmp_info.ProvideTotalEnergyVario(src.total_energy_vario);
+
+    if (src.engine_noise_level_available) {
+      tmp_info.engine_noise_level = src.engine_noise_level;
+      tmp_info.engine_noise_level_available.Update(tmp_info.clock);
+    }
+
     if (src.satellite_ids_available) {
       tmp_info.gps.satellite_ids_available.Update(tmp_info.clock);
       for (unsigned i = 0; i < GPSState::MAXSATELLITES; i++)
@@ -253,7 +286,7 @@ LoggerImpl::StartLogger(const NMEAInfo &gps_info,
   frecord.Reset();
 
   try {
-    writer = new IGCWriter(filename);
+    writer = new AsyncIGCWriter(filename, settings.high_rate);
   } catch (const std::runtime_error &e) {
     LogError(e);
     return false;
@@ -307,22 +340,28 @@ LoggerImpl::StartLogger(const NMEAInfo &gps_info,
     return;
 
   simulator = gps_info.location_available && !gps_info.gps.real;
-  writer->WriteHeader(gps_info.date_time_utc, decl.pilot_name,
-                      decl.aircraft_type, decl.aircraft_registration,
-                      decl.competition_id,
-                      logger_id, GetGPSDeviceName(), simulator);
+
+  IGCWriter &igc = writer->GetWriter();
+  igc.WriteHeader(gps_info.date_time_utc, decl.pilot_name,
+                  decl.aircraft_type, decl.aircraft_registration,
+                  decl.competition_id,
+                  logger_id, GetGPSDeviceName(), simulator);
 
   if (decl.Size()) {
     BrokenDateTime FirstDateTime = !pre_takeoff_buffer.empty()
       ? pre_takeoff_buffer.peek().date_time_utc
       : gps_info.date_time_utc;
-    writer->StartDeclaration(FirstDateTime, decl.Size());
+    igc.StartDeclaration(FirstDateTime, decl.Size());
 
     for (unsigned i = 0; i< decl.Size(); ++i)
-      writer->AddDeclaration(decl.GetLocation(i), decl.GetName(i));
+      igc.AddDeclaration(decl.GetLocation(i), decl.GetName(i));
 
-    writer->EndDeclaration();
+    igc.EndDeclaration();
   }
+
+  if (!writer->Start())
+    /* no thread: AsyncIGCWriter writes each record synchronously */
+    LogFormat("Failed to launch the IGC writer thread");
 }
 
 void
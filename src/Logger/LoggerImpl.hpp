@@ -35,7 +35,7 @@ Copyright_License {
 struct NMEAInfo;
 struct LoggerSettings;
 struct Declaration;
-class IGCWriter;
+class AsyncIGCWriter;
 
 /**
  * Implementation of logger
@@ -44,8 +44,14 @@ class LoggerImpl
 {
 public:
   enum {
-    /** Buffer size (s) of points recorded before takeoff */
-    PRETAKEOFF_BUFFER_MAX = 60,
+    /**
+     * Buffer size (number of points) recorded before takeoff; this
+     * is one minute at the highest logging rate.
+     */
+    PRETAKEOFF_BUFFER_MAX = 600,
+
+    /** Points older than this (s) are dropped from the buffer */
+    PRETAKEOFF_DURATION = 300,
   };
 
   /** Buffer for points recorded before takeoff */
@@ -72,6 +78,13 @@ public:
     /** GPS Horizontal Dilution of precision */
     double hdop;
 
+    /** True airspeed (m/s) */
+    double true_airspeed;
+    /** Total energy vario (m/s) */
+    double total_energy_vario;
+    /** Engine noise level */
+    unsigned engine_noise_level;
+
     /**
      * Is the fix real? (no replay, no simulator)
      */
@@ -79,6 +92,9 @@ public:
 
     bool pressure_altitude_available;
     bool gps_altitude_available;
+    bool airspeed_available;
+    bool total_energy_vario_available;
+    bool engine_noise_level_available;
 
     /** 
      * Set buffer value from NMEA_INFO structure
@@ -92,7 +108,7 @@ public:
 
 private:
   AllocatedPath filename;
-  IGCWriter *writer;
+  AsyncIGCWriter *writer;
 
   OverwritingRingBuffer<PreTakeoffBuffer, PRETAKEOFF_BUFFER_MAX> pre_takeoff_buffer;
 
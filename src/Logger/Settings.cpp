@@ -28,6 +28,7 @@ LoggerSettings::SetDefaults()
 {
   time_step_cruise = 5;
   time_step_circling = 1;
+  high_rate = false;
   auto_logger = AutoLogger::ON;
   logger_id.clear();
   pilot_name.clear();
@@ -48,6 +48,12 @@ struct LoggerSettings {
   /** Logger interval in circling mode */
   uint16_t time_step_circling;
 
+  /**
+   * Log every GPS fix (up to 10 Hz) with the extended B record,
+   * ignoring the time steps?
+   */
+  bool high_rate;
+
   enum class AutoLogger: uint8_t {
     ON,
     START_ONLY,
@@ -88,6 +88,15 @@ GlueMapWindow::SetTerrain(RasterTerrain *_terrain)
                         });
 }
 
+void
+GlueMapWindow::SetRasp(const std::shared_ptr<RaspStore> &_rasp_store)
+{
+  MapWindow::SetRasp(_rasp_store,
+                     [this](){
+                       SendUser(unsigned(Command::INVALIDATE));
+                     });
+}
+
 void
 GlueMapWindow::SetMapSettings(const MapSettings &new_value)
 {
@@ -135,7 +144,7 @@ GlueMapWindow::ExchangeBlackboard()
   {
     const ScopeLock lock(device_blackboard->mutex);
     ReadBlackboard(device_blackboard->Basic(),
-                   device_blackboard->Calculated());
+                   device_blackboard->GetCalculatedSnapshot());
   }
 
 #ifndef ENABLE_OPENGL
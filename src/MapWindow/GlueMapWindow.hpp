@@ -143,6 +143,7 @@ public:
 
   void SetTopography(TopographyStore *_topography);
   void SetTerrain(RasterTerrain *_terrain);
+  void SetRasp(const std::shared_ptr<RaspStore> &_rasp_store);
 
   void SetMapSettings(const MapSettings &new_value);
   void SetComputerSettings(const ComputerSettings &new_value);
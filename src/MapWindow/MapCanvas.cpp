@@ -79,6 +79,26 @@ MapCanvas::PreparePolygon(const SearchPointVector &points)
   for (unsigned i = 0; i < num_points; ++i)
     geo_points[i] = points[i].GetLocation();
 
+  return PrepareGeoPoints(num_points);
+}
+
+bool
+MapCanvas::PreparePolygon(const SearchPointVector &points,
+                          const uint16_t *indices, unsigned num_indices)
+{
+  if (num_indices < 3)
+    return false;
+
+  geo_points.GrowDiscard(num_indices * 3);
+  for (unsigned i = 0; i < num_indices; ++i)
+    geo_points[i] = points[indices[i]].GetLocation();
+
+  return PrepareGeoPoints(num_indices);
+}
+
+bool
+MapCanvas::PrepareGeoPoints(unsigned num_points)
+{
   /* clip them */
   num_raster_points = clip.ClipPolygon(geo_points.begin(),
                                        geo_points.begin(), num_points);
@@ -28,6 +28,8 @@ Copyright_License {
 #include "Geo/GeoClip.hpp"
 #include "Util/AllocatedArray.hxx"
 
+#include <stdint.h>
+
 class Canvas;
 class Projection;
 struct GeoPoint;
@@ -86,7 +88,22 @@ public:
   }
 
   bool PreparePolygon(const SearchPointVector &points);
+
+  /**
+   * Like PreparePolygon(), but use only the vertices listed in
+   * #indices, e.g. a simplified outline.
+   */
+  bool PreparePolygon(const SearchPointVector &points,
+                      const uint16_t *indices, unsigned num_indices);
+
   void DrawPrepared();
+
+private:
+  /**
+   * Clip the first #num_points elements of #geo_points and project
+   * them to #raster_points.
+   */
+  bool PrepareGeoPoints(unsigned num_points);
 };
 
 #endif
@@ -27,12 +27,34 @@ Copyright_License {
 #include "Topography/CachedTopographyRenderer.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "Weather/Rasp/RaspRenderer.hpp"
+#include "Weather/Rasp/RaspThread.hpp"
 #include "Computer/GlideComputer.hpp"
+#include "PipelineLatency.hpp"
+#include "OS/Clock.hpp"
+#include "Asset.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/Scissor.hpp"
 #endif
 
+/**
+ * Choose frame pacing parameters which suit the device: e-paper
+ * displays refresh slowly, and old hardware cannot keep up with a
+ * high frame rate anyway.
+ */
+static FrameScheduler
+MakeFrameScheduler()
+{
+  if (HasEPaper())
+    return FrameScheduler(500, 400);
+  else if (IsAncientHardware())
+    return FrameScheduler(200, 150);
+  else if (IsEmbedded())
+    return FrameScheduler(50, 50);
+  else
+    return FrameScheduler(20, 50);
+}
+
 /**
  * Constructor of the MapWindow class
  */
@@ -43,7 +65,8 @@ MapWindow::MapWindow(const MapLook &_look,
    waypoint_renderer(nullptr, look.waypoint),
    airspace_renderer(look.airspace),
    airspace_label_renderer(look.airspace),
-   trail_renderer(look.trail) {}
+   trail_renderer(look.trail),
+   frame_scheduler(MakeFrameScheduler()) {}
 
 MapWindow::~MapWindow()
 {
@@ -78,6 +101,7 @@ MapWindow::FlushCaches()
   if (rasp_renderer)
     rasp_renderer->Flush();
   airspace_renderer.Flush();
+  background_cache.Invalidate();
 }
 
 /**
@@ -136,10 +160,18 @@ MapWindow::OnPaintBuffer(Canvas &canvas)
   GLCanvasScissor scissor(canvas);
 #endif
 
+  frame_scheduler.BeginFrame(MonotonicClockMS());
+  ApplyRenderQuality();
+
   // Render the moving map
   Render(canvas, GetClientRect());
   draw_sw.Finish();
 
+  frame_scheduler.EndFrame(MonotonicClockMS());
+
+  PipelineLatency::Record(PipelineLatency::Stage::DRAW,
+                          Basic().receive_clock_us);
+
 #ifndef ENABLE_OPENGL
   /* save the generation number which was active when rendering had
      begun */
@@ -157,6 +189,8 @@ MapWindow::SetTopography(TopographyStore *_topography)
   topography_renderer = topography != nullptr
     ? new CachedTopographyRenderer(*topography, look.topography)
     : nullptr;
+
+  background_cache.Invalidate();
 }
 
 void
@@ -164,11 +198,24 @@ MapWindow::SetTerrain(RasterTerrain *_terrain)
 {
   terrain = _terrain;
   background.SetTerrain(_terrain);
+  background_cache.Invalidate();
 }
 
 void
-MapWindow::SetRasp(const std::shared_ptr<RaspStore> &_rasp_store)
+MapWindow::SetRasp(const std::shared_ptr<RaspStore> &_rasp_store,
+                   std::function<void()> &&callback)
 {
   rasp_renderer.reset();
+
+  if (rasp_thread) {
+    rasp_thread->LockStop();
+    rasp_thread.reset();
+  }
+
   rasp_store = _rasp_store;
+
+  if (rasp_store)
+    rasp_thread.reset(new RaspThread(*rasp_store, std::move(callback)));
+
+  background_cache.Invalidate();
 }
@@ -37,11 +37,16 @@ Copyright_License {
 #include "Renderer/BackgroundRenderer.hpp"
 #include "Renderer/WaypointRenderer.hpp"
 #include "Renderer/TrailRenderer.hpp"
+#include "Renderer/LayerCache.hpp"
+#include "Terrain/TerrainSettings.hpp"
+#include "Util/Serial.hpp"
+#include "FrameScheduler.hpp"
 #include "Compiler.h"
 #include "Weather/Features.hpp"
 #include "Tracking/SkyLines/Features.hpp"
 
 #include <memory>
+#include <functional>
 
 struct MapLook;
 struct TrafficLook;
@@ -49,6 +54,7 @@ class TopographyStore;
 class CachedTopographyRenderer;
 class RasterTerrain;
 class RaspStore;
+class RaspThread;
 class RaspRenderer;
 class MapOverlay;
 class Waypoints;
@@ -125,6 +131,11 @@ protected:
 
   std::shared_ptr<RaspStore> rasp_store;
 
+  /**
+   * Decodes RASP maps from #rasp_store in background.
+   */
+  std::unique_ptr<RaspThread> rasp_thread;
+
   /**
    * The current RASP renderer.  Modifications to this pointer (but
    * not to the #RaspRenderer instance) are protected by
@@ -146,6 +157,50 @@ protected:
 
   TrailRenderer trail_renderer;
 
+  /**
+   * The inputs of the background layers (terrain, RASP and
+   * topography) which were rendered into #background_cache.  If
+   * anything differs from the current state, the cache is stale.
+   */
+  struct BackgroundState {
+    Serial terrain_serial;
+    Angle shading_angle;
+    TerrainRendererSettings terrain_settings;
+
+    unsigned topography_serial;
+    bool topography_enabled;
+
+    int rasp_map;
+    unsigned rasp_serial;
+
+    unsigned quality_level;
+
+    gcc_pure
+    bool operator==(const BackgroundState &other) const {
+      return terrain_serial == other.terrain_serial &&
+        shading_angle.CompareRoughly(other.shading_angle) &&
+        terrain_settings == other.terrain_settings &&
+        topography_serial == other.topography_serial &&
+        topography_enabled == other.topography_enabled &&
+        rasp_map == other.rasp_map &&
+        rasp_serial == other.rasp_serial &&
+        quality_level == other.quality_level;
+    }
+
+    bool operator!=(const BackgroundState &other) const {
+      return !(*this == other);
+    }
+  };
+
+  BackgroundState background_state;
+
+  /**
+   * Composites the background layers, so they need to be rendered
+   * only if the projection or their data changes, and not each time
+   * the aircraft or traffic moves.
+   */
+  LayerCache background_cache;
+
   ProtectedTaskManager *task = nullptr;
   const ProtectedRoutePlanner *route_planner = nullptr;
   GlideComputer *glide_computer = nullptr;
@@ -182,6 +237,12 @@ protected:
    */
   ScreenStopWatch draw_sw;
 
+  /**
+   * Limits the frame rate and reduces the rendering quality when
+   * frames take too long, see OnPaintBuffer().
+   */
+  FrameScheduler frame_scheduler;
+
   friend class DrawThread;
 
 public:
@@ -227,7 +288,12 @@ public:
     return rasp_store;
   }
 
-  void SetRasp(const std::shared_ptr<RaspStore> &_rasp_store);
+  /**
+   * @param callback invoked in the #RaspThread after a requested
+   * RASP map has been decoded
+   */
+  void SetRasp(const std::shared_ptr<RaspStore> &_rasp_store,
+               std::function<void()> &&callback=nullptr);
 
 #ifdef ENABLE_OPENGL
   void SetOverlay(std::unique_ptr<MapOverlay> &&_overlay);
@@ -277,6 +343,10 @@ public:
     visible_projection.UpdateScreenBounds();
   }
 
+  const FrameScheduler &GetFrameScheduler() const {
+    return frame_scheduler;
+  }
+
 protected:
   void DrawBestCruiseTrack(Canvas &canvas, PixelPoint aircraft_pos) const;
   void DrawTrackBearing(Canvas &canvas,
@@ -338,15 +408,38 @@ protected:
   virtual void OnPaintBuffer(Canvas& canvas) override;
 
 private:
+  /**
+   * Configure the renderers for the current
+   * FrameScheduler::GetLevel().
+   */
+  void ApplyRenderQuality();
+
+  gcc_pure
+  BackgroundState GetBackgroundState() const;
+
+  /**
+   * Renders terrain, RASP and topography, or copies them from
+   * #background_cache if nothing has changed.
+   * @param canvas The drawing canvas
+   */
+  void RenderBackground(Canvas &canvas);
+
   /**
    * Renders the terrain background
    * @param canvas The drawing canvas
    */
   void RenderTerrain(Canvas &canvas);
 
+  /**
+   * Create or replace #rasp_renderer according to the #WeatherUIState
+   * and load the current RASP map.
+   */
+  void UpdateRasp();
+
   void RenderRasp(Canvas &canvas);
 
   void RenderTerrainAbove(Canvas &canvas, bool working);
+  void RenderArrivalShading(Canvas &canvas);
 
   /**
    * Renders the topography
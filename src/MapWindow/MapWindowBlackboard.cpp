@@ -42,6 +42,6 @@ MapWindowBlackboard::ReadBlackboard(const MoreData &nmea_info,
 				    const DerivedInfo &derived_info)
 {
   gps_info = nmea_info;
-  calculated_info = derived_info;
+  calculated = CalculatedSnapshot(derived_info);
 }
 
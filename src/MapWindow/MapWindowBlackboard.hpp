@@ -24,7 +24,7 @@ Copyright_License {
 #ifndef MAP_WINDOW_BLACKBOARD_H
 #define MAP_WINDOW_BLACKBOARD_H
 
-#include "Blackboard/BaseBlackboard.hpp"
+#include "Blackboard/SnapshotBlackboard.hpp"
 #include "Blackboard/ComputerSettingsBlackboard.hpp"
 #include "Blackboard/MapSettingsBlackboard.hpp"
 #include "Thread/Debug.hpp"
@@ -36,7 +36,7 @@ Copyright_License {
  * 
  */
 class MapWindowBlackboard:
-  public BaseBlackboard,
+  public SnapshotBlackboard,
   public ComputerSettingsBlackboard,
   public MapSettingsBlackboard
 {
@@ -47,14 +47,14 @@ protected:
   const MoreData &Basic() const {
     assert(InDrawThread());
 
-    return BaseBlackboard::Basic();
+    return SnapshotBlackboard::Basic();
   }
 
   gcc_const
   const DerivedInfo &Calculated() const {
     assert(InDrawThread());
 
-    return BaseBlackboard::Calculated();
+    return SnapshotBlackboard::Calculated();
   }
 
   gcc_const
@@ -80,6 +80,16 @@ protected:
 
   void ReadBlackboard(const MoreData &nmea_info,
                       const DerivedInfo &derived_info);
+
+  /**
+   * Like ReadBlackboard(), but shares the calculated data instead of
+   * copying it.
+   */
+  void ReadBlackboard(const MoreData &nmea_info,
+                      const CalculatedSnapshot &snapshot) {
+    gps_info = nmea_info;
+    calculated = snapshot;
+  }
   void ReadComputerSettings(const ComputerSettings &settings);
   void ReadMapSettings(const MapSettings &settings);
 
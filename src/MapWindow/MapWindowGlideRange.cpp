@@ -25,6 +25,8 @@ Copyright_License {
 #include "Look/MapLook.hpp"
 #include "Geo/GeoClip.hpp"
 #include "Task/ProtectedRoutePlanner.hpp"
+#include "Screen/Features.hpp"
+#include "Util/Macros.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/Scope.hpp"
@@ -248,6 +250,9 @@ MapWindow::DrawTerrainAbove(Canvas &canvas)
     RenderTerrainAbove(canvas, true);
   }
 
+  if (GetComputerSettings().features.final_glide_terrain == FeaturesSettings::FinalGlideTerrain::TERRAIN_ARRIVAL)
+    RenderArrivalShading(canvas);
+
   if ((GetComputerSettings().features.final_glide_terrain != FeaturesSettings::FinalGlideTerrain::OFF) &&
       (GetComputerSettings().features.final_glide_terrain != FeaturesSettings::FinalGlideTerrain::WORKING)) {
     RenderTerrainAbove(canvas, false);
@@ -444,6 +449,152 @@ MapWindow::RenderTerrainAbove(Canvas &canvas, bool working)
   }
 }
 
+/**
+ * The arrival height bands of the arrival shading, from low to high.
+ */
+static constexpr struct ArrivalBand {
+  int min_height;
+  uint8_t r, g, b;
+} arrival_bands[] = {
+  { 0, 0xff, 0x80, 0x00 },
+  { 250, 0xff, 0xe0, 0x00 },
+  { 500, 0x9c, 0xdc, 0x28 },
+  { 1000, 0x28, 0xb4, 0x28 },
+};
+
+static constexpr unsigned NUM_ARRIVAL_BANDS = ARRAY_SIZE(arrival_bands);
+
+static constexpr uint8_t ARRIVAL_ALPHA = 0x60;
+
+/**
+ * @return the index in #arrival_bands, or -1 if the cell is not
+ * reachable
+ */
+gcc_const
+static int
+GetArrivalBand(int16_t height)
+{
+  if (height == ArrivalRaster::UNREACHABLE)
+    return -1;
+
+  int band = 0;
+  while (band + 1 < (int)NUM_ARRIVAL_BANDS &&
+         height >= arrival_bands[band + 1].min_height)
+    ++band;
+
+  return band;
+}
+
+/**
+ * Blend the #ArrivalRaster calculated by #RouteComputer over the
+ * map, coloured by arrival height band.
+ */
+void
+MapWindow::RenderArrivalShading(Canvas &canvas)
+{
+  ArrivalRaster raster;
+
+  {
+    const ProtectedRoutePlanner::Lease lease(*route_planner);
+    raster = lease->GetArrivalRaster();
+  }
+
+  if (!raster.IsDefined() ||
+      !raster.GetBounds().Overlaps(render_projection.GetScreenBounds()))
+    return;
+
+  const unsigned width = raster.GetWidth(), height = raster.GetHeight();
+  const unsigned pitch = width + 1;
+
+  /* project the cell corners once; adjacent cells share them */
+  BulkPixelPointVector corners;
+  corners.reserve(pitch * (height + 1));
+  for (unsigned y = 0; y <= height; ++y)
+    for (unsigned x = 0; x <= width; ++x)
+      corners.push_back(render_projection.GeoToScreen(raster.GetCorner(x, y)));
+
+  /* merge horizontal runs of cells in the same band into one quad;
+     the quad's corners are stored as north-west, north-east,
+     south-east, south-west */
+  std::vector<unsigned> quads[NUM_ARRIVAL_BANDS];
+  for (unsigned y = 0; y < height; ++y) {
+    for (unsigned x = 0; x < width;) {
+      const int band = GetArrivalBand(raster.Get(x, y));
+      unsigned end = x + 1;
+      while (end < width && GetArrivalBand(raster.Get(end, y)) == band)
+        ++end;
+
+      if (band >= 0) {
+        auto &q = quads[band];
+        q.push_back(y * pitch + x);
+        q.push_back(y * pitch + end);
+        q.push_back((y + 1) * pitch + end);
+        q.push_back((y + 1) * pitch + x);
+      }
+
+      x = end;
+    }
+  }
+
+#ifdef ENABLE_OPENGL
+  const ScopeVertexPointer vp(&corners[0]);
+  const ScopeAlphaBlend alpha_blend;
+
+  std::vector<GLushort> triangles;
+  for (unsigned band = 0; band < NUM_ARRIVAL_BANDS; ++band) {
+    const auto &q = quads[band];
+    if (q.empty())
+      continue;
+
+    triangles.clear();
+    for (auto i = q.begin(), end = q.end(); i != end; i += 4) {
+      triangles.insert(triangles.end(), { GLushort(i[0]), GLushort(i[1]),
+                                          GLushort(i[2]), GLushort(i[0]),
+                                          GLushort(i[2]), GLushort(i[3]) });
+    }
+
+    const auto &b = arrival_bands[band];
+    ColorWithAlpha(Color(b.r, b.g, b.b), ARRIVAL_ALPHA).Bind();
+    glDrawElements(GL_TRIANGLES, triangles.size(), GL_UNSIGNED_SHORT,
+                   &triangles[0]);
+  }
+#else
+  Canvas &buffer = buffer_canvas;
+  buffer.ClearWhite();
+  buffer.SelectNullPen();
+
+  for (unsigned band = 0; band < NUM_ARRIVAL_BANDS; ++band) {
+    const auto &q = quads[band];
+    if (q.empty())
+      continue;
+
+    const auto &b = arrival_bands[band];
+    const Brush brush(Color(b.r, b.g, b.b));
+    buffer.Select(brush);
+
+    for (auto i = q.begin(), end = q.end(); i != end; i += 4) {
+      const BulkPixelPoint points[4] = {
+        corners[i[0]], corners[i[1]], corners[i[2]], corners[i[3]],
+      };
+      buffer.DrawPolygon(points, 4);
+    }
+
+    buffer.SelectHollowBrush();
+  }
+
+  const unsigned screen_width = render_projection.GetScreenWidth();
+  const unsigned screen_height = render_projection.GetScreenHeight();
+
+#if defined(HAVE_ALPHA_BLEND) && defined(USE_MEMORY_CANVAS)
+  canvas.AlphaBlendNotWhite(0, 0, screen_width, screen_height,
+                            buffer, 0, 0, screen_width, screen_height,
+                            ARRIVAL_ALPHA);
+#else
+  canvas.CopyTransparentWhite(0, 0, screen_width, screen_height,
+                              buffer, 0, 0);
+#endif
+#endif
+}
 
 void
 MapWindow::DrawGlideThroughTerrain(Canvas &canvas) const
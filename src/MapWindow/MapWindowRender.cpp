@@ -27,9 +27,10 @@ Copyright_License {
 #include "Weather/Rasp/RaspRenderer.hpp"
 #include "Weather/Rasp/RaspCache.hpp"
 #include "Topography/CachedTopographyRenderer.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Terrain/RasterTerrain.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
-#include "Operation/Operation.hpp"
 #include "Tracking/SkyLines/Data.hpp"
 
 #ifdef HAVE_NOAA
@@ -44,15 +45,87 @@ MapWindow::RenderTrackBearing(Canvas &canvas, const PixelPoint aircraft_pos)
 }
 
 void
-MapWindow::RenderTerrain(Canvas &canvas)
+MapWindow::ApplyRenderQuality()
+{
+  const unsigned level = frame_scheduler.GetLevel();
+
+  /* level 1: coarser terrain; level 2: skip detailed topography
+     layers and labels; level 3: even coarser */
+  background.SetQualityShift(level >= 3 ? 2 : (level >= 1 ? 1 : 0));
+
+  if (topography_renderer != nullptr)
+    topography_renderer->SetDetailFactor(level >= 3 ? 4 : (level >= 2 ? 2 : 1));
+}
+
+MapWindow::BackgroundState
+MapWindow::GetBackgroundState() const
+{
+  const MapSettings &settings = GetMapSettings();
+
+  BackgroundState state;
+
+  if (terrain != nullptr)
+    state.terrain_serial = terrain->GetSerial();
+  state.shading_angle = background.GetShadingAngle();
+  state.terrain_settings = settings.terrain;
+
+  state.topography_serial = topography != nullptr
+    ? topography->GetSerial()
+    : 0;
+  state.topography_enabled = settings.topography_enabled;
+
+  if (rasp_renderer) {
+    state.rasp_map = rasp_renderer->GetParameter();
+    state.rasp_serial = rasp_renderer->GetSerial();
+  } else {
+    state.rasp_map = -1;
+    state.rasp_serial = 0;
+  }
+
+  state.quality_level = frame_scheduler.GetLevel();
+
+  return state;
+}
+
+void
+MapWindow::RenderBackground(Canvas &canvas)
 {
   background.SetShadingAngle(render_projection, GetMapSettings().terrain,
                              Calculated());
+  UpdateRasp();
+
+  const BackgroundState state = GetBackgroundState();
+  if (background_cache.Check(render_projection) &&
+      state == background_state) {
+    draw_sw.Mark("CopyBackground");
+    background_cache.CopyTo(canvas);
+    return;
+  }
+
+  background_state = state;
+
+  Canvas &buffer = background_cache.Begin(canvas, render_projection);
+
+  draw_sw.Mark("RenderTerrain");
+  RenderTerrain(buffer);
+
+  draw_sw.Mark("RenderRasp");
+  RenderRasp(buffer);
+
+  draw_sw.Mark("RenderTopography");
+  RenderTopography(buffer);
+
+  background_cache.Commit(canvas, render_projection);
+}
+
+void
+MapWindow::RenderTerrain(Canvas &canvas)
+{
   background.Draw(canvas, render_projection, GetMapSettings().terrain);
 }
 
 inline void
-MapWindow::RenderRasp(Canvas &canvas)
+MapWindow::UpdateRasp()
 {
   if (rasp_store == nullptr)
     return;
@@ -73,15 +146,18 @@ MapWindow::RenderRasp(Canvas &canvas)
 #ifndef ENABLE_OPENGL
     const ScopeLock protect(mutex);
 #endif
-    rasp_renderer.reset(new RaspRenderer(*rasp_store, state.map));
+    rasp_renderer.reset(new RaspRenderer(*rasp_thread, state.map));
   }
 
   rasp_renderer->SetTime(state.time);
+  rasp_renderer->Update(Calculated().date_time_local);
+}
 
-  {
-    QuietOperationEnvironment operation;
-    rasp_renderer->Update(Calculated().date_time_local, operation);
-  }
+inline void
+MapWindow::RenderRasp(Canvas &canvas)
+{
+  if (!rasp_renderer)
+    return;
 
   const auto &terrain_settings = GetMapSettings().terrain;
   if (rasp_renderer->Generate(render_projection, terrain_settings))
@@ -98,7 +174,8 @@ MapWindow::RenderTopography(Canvas &canvas)
 void
 MapWindow::RenderTopographyLabels(Canvas &canvas)
 {
-  if (topography_renderer != nullptr && GetMapSettings().topography_enabled)
+  if (topography_renderer != nullptr && GetMapSettings().topography_enabled &&
+      frame_scheduler.GetLevel() < 2)
     topography_renderer->DrawLabels(canvas, render_projection, label_block);
 }
 
@@ -210,14 +287,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   //////////////////////////////////////////////// items on ground
 
   // Render terrain, groundline and topography
-  draw_sw.Mark("RenderTerrain");
-  RenderTerrain(canvas);
-
-  draw_sw.Mark("RenderRasp");
-  RenderRasp(canvas);
-
-  draw_sw.Mark("RenderTopography");
-  RenderTopography(canvas);
+  RenderBackground(canvas);
 
   draw_sw.Mark("RenderOverlays");
   RenderOverlays(canvas);
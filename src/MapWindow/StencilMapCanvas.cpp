@@ -65,6 +65,27 @@ StencilMapCanvas::DrawSearchPointVector(const SearchPointVector &points)
   for (unsigned i = 0; i < size; ++i)
     geo_points[i] = points[i].GetLocation();
 
+  DrawGeoPoints(size);
+}
+
+void
+StencilMapCanvas::DrawSearchPointVector(const SearchPointVector &points,
+                                        const uint16_t *indices,
+                                        unsigned num_indices)
+{
+  if (num_indices < 3)
+    return;
+
+  geo_points.GrowDiscard(num_indices * 3);
+  for (unsigned i = 0; i < num_indices; ++i)
+    geo_points[i] = points[indices[i]].GetLocation();
+
+  DrawGeoPoints(num_indices);
+}
+
+void
+StencilMapCanvas::DrawGeoPoints(size_t size)
+{
   /* clip them */
   size = clip.ClipPolygon(geo_points.begin(), geo_points.begin(), size);
   if (size < 3)
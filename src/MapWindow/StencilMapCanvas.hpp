@@ -29,6 +29,8 @@ Copyright_License {
 #include "Geo/GeoClip.hpp"
 #include "Util/AllocatedArray.hxx"
 
+#include <stdint.h>
+
 struct PixelPoint;
 class Canvas;
 class Projection;
@@ -67,10 +69,25 @@ public:
 
   void DrawSearchPointVector(const SearchPointVector &points);
 
+  /**
+   * Like DrawSearchPointVector(), but use only the vertices listed
+   * in #indices, e.g. a simplified outline.
+   */
+  void DrawSearchPointVector(const SearchPointVector &points,
+                             const uint16_t *indices, unsigned num_indices);
+
   void DrawCircle(const PixelPoint &center, unsigned radius);
 
   void Begin();
 
+private:
+  /**
+   * Clip and draw the first #size elements of #geo_points.
+   */
+  void DrawGeoPoints(size_t size);
+
+public:
+
   /**
    * Commits the calculated results
    *
@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "Audio/VarioGlue.hpp"
 #include "Device/MultipleDevices.hpp"
+#include "PipelineLatency.hpp"
 
 MergeThread::MergeThread(DeviceBlackboard &_device_blackboard)
   :WorkerThread("MergeThread", 50, 20, 10),
@@ -54,6 +55,9 @@ MergeThread::Process()
 
   flarm_computer.Process(device_blackboard.SetBasic().flarm,
                          last_fix.flarm, basic);
+
+  PipelineLatency::Record(PipelineLatency::Stage::MERGE,
+                          basic.receive_clock_us);
 }
 
 void
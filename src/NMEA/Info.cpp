@@ -141,6 +141,7 @@ void
 NMEAInfo::Reset()
 {
   UpdateClock();
+  receive_clock_us = 0;
 
   alive.Clear();
 
@@ -275,6 +276,9 @@ NMEAInfo::Complement(const NMEAInfo &add)
 
   alive.Complement(add.alive);
 
+  if (add.receive_clock_us > receive_clock_us)
+    receive_clock_us = add.receive_clock_us;
+
   if (time_available.Complement(add.time_available)) {
     time = add.time;
     date_time_utc = add.date_time_utc;
@@ -40,6 +40,8 @@ Copyright_License {
 
 #include <type_traits>
 
+#include <stdint.h>
+
 /**
  * A struct that holds all the parsed data read from the connected devices
  */
@@ -52,6 +54,14 @@ struct NMEAInfo {
    */
   double clock;
 
+  /**
+   * The MonotonicClockUS() time stamp when the most recent data
+   * which was merged into this object arrived at the device port.
+   * Zero if unknown.  This is used to measure the latency of the
+   * processing pipeline, see #PipelineLatency.
+   */
+  uint64_t receive_clock_us;
+
   /**
    * Is the device alive?  This attribute gets updated each time a
    * NMEA line was successfully parsed.
@@ -0,0 +1,73 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_NMEA_SENTENCE_KEY_HPP
+#define XCSOAR_NMEA_SENTENCE_KEY_HPP
+
+#include "Util/Range.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Pack up to eight characters of a NMEA sentence identifier into an
+ * integer.  This allows dispatching on the sentence type with a
+ * "switch" statement (which the compiler turns into a jump table or
+ * a binary search) instead of a chain of string comparisons.
+ */
+static constexpr uint64_t
+NMEASentenceKey(const char *p, size_t length)
+{
+  return length == 0
+    ? 0
+    : uint64_t(uint8_t(*p)) | (NMEASentenceKey(p + 1, length - 1) << 8);
+}
+
+/**
+ * Pack a whole column, e.g. the sentence identifier returned by
+ * CSVLine::ReadView().
+ *
+ * @return the key, or 0 if the column is empty or longer than eight
+ * characters (which matches no "case" label)
+ */
+static inline uint64_t
+NMEASentenceKey(Range<const char *> column)
+{
+  const size_t length = column.end() - column.begin();
+  return length <= 8
+    ? NMEASentenceKey(column.begin(), length)
+    : 0;
+}
+
+/**
+ * Overload for string literals, to be used in "case" labels.
+ */
+template<size_t N>
+static constexpr uint64_t
+NMEASentenceKey(const char (&s)[N])
+{
+  static_assert(N >= 1 && N <= 9, "Sentence key too long");
+  return NMEASentenceKey(s, N - 1);
+}
+
+#endif
@@ -0,0 +1,147 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "PipelineLatency.hpp"
+#include "Thread/Mutex.hpp"
+#include "OS/Clock.hpp"
+#include "Util/StaticString.hxx"
+#include "LogFile.hpp"
+
+#include <assert.h>
+
+namespace PipelineLatency {
+  struct StageData {
+    LatencyHistogram histogram;
+
+    /**
+     * The time stamp of the last recorded sample; used to avoid
+     * recording the same data twice when a stage runs repeatedly
+     * without new input.
+     */
+    uint64_t last_receive_clock_us = 0;
+  };
+
+  static Mutex mutex;
+  static StageData stages[N_STAGES];
+}
+
+const char *
+PipelineLatency::GetStageName(Stage stage)
+{
+  switch (stage) {
+  case Stage::PARSE:
+    return "parse";
+
+  case Stage::MERGE:
+    return "merge";
+
+  case Stage::CALCULATE:
+    return "calculate";
+
+  case Stage::DRAW:
+    return "draw";
+
+  case Stage::COUNT:
+    break;
+  }
+
+  assert(false);
+  gcc_unreachable();
+}
+
+void
+PipelineLatency::Record(Stage stage, uint64_t receive_clock_us)
+{
+  assert(stage < Stage::COUNT);
+
+  if (receive_clock_us == 0)
+    return;
+
+  const uint64_t now = MonotonicClockUS();
+  const uint64_t age = now > receive_clock_us
+    ? now - receive_clock_us
+    : 0;
+
+  StageData &data = stages[unsigned(stage)];
+
+  const ScopeLock protect(mutex);
+  if (receive_clock_us == data.last_receive_clock_us)
+    return;
+
+  data.last_receive_clock_us = receive_clock_us;
+  data.histogram.Add(age < UINT32_MAX ? uint32_t(age) : UINT32_MAX);
+}
+
+LatencyHistogram::Summary
+PipelineLatency::GetSummary(Stage stage)
+{
+  assert(stage < Stage::COUNT);
+
+  const ScopeLock protect(mutex);
+  return stages[unsigned(stage)].histogram.GetSummary();
+}
+
+LatencyHistogram
+PipelineLatency::GetHistogram(Stage stage)
+{
+  assert(stage < Stage::COUNT);
+
+  const ScopeLock protect(mutex);
+  return stages[unsigned(stage)].histogram;
+}
+
+void
+PipelineLatency::Log()
+{
+  for (unsigned i = 0; i < N_STAGES; ++i) {
+    const Stage stage = Stage(i);
+    const LatencyHistogram histogram = GetHistogram(stage);
+    if (histogram.IsEmpty())
+      continue;
+
+    const auto summary = histogram.GetSummary();
+    LogFormat("Latency %s: n=%u mean=%u p50=%u p95=%u max=%u us",
+              GetStageName(stage), summary.n,
+              (unsigned)summary.mean_us, (unsigned)summary.p50_us,
+              (unsigned)summary.p95_us, (unsigned)summary.max_us);
+
+    NarrowString<256> buffer;
+    buffer.clear();
+    for (unsigned j = 0; j < LatencyHistogram::N_BUCKETS; ++j)
+      buffer.AppendFormat(" %u", histogram.GetBucket(j));
+
+    LogFormat("Latency %s histogram (from %u us, doubling):%s",
+              GetStageName(stage),
+              (unsigned)LatencyHistogram::BUCKET0_US, buffer.c_str());
+  }
+}
+
+void
+PipelineLatency::Clear()
+{
+  const ScopeLock protect(mutex);
+  for (auto &i : stages) {
+    i.histogram.Clear();
+    i.last_receive_clock_us = 0;
+  }
+}
@@ -0,0 +1,94 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_PIPELINE_LATENCY_HPP
+#define XCSOAR_PIPELINE_LATENCY_HPP
+
+#include "Time/LatencyHistogram.hpp"
+#include "Compiler.h"
+
+#include <stdint.h>
+
+/**
+ * Measures how long it takes for data received from a device to pass
+ * through the stages of the sensor-to-screen pipeline.  Each stage
+ * reports the #NMEAInfo::receive_clock_us time stamp of the data it
+ * has just processed, and the age of that data is recorded in a
+ * rolling histogram.
+ *
+ * All functions are thread-safe.
+ */
+namespace PipelineLatency {
+  enum class Stage : uint8_t {
+    /**
+     * The device driver has parsed the line.
+     */
+    PARSE,
+
+    /**
+     * #MergeThread has merged the data into the #DeviceBlackboard.
+     */
+    MERGE,
+
+    /**
+     * #CalculationThread has finished GlideComputer::ProcessGPS().
+     */
+    CALCULATE,
+
+    /**
+     * The map has been rendered.
+     */
+    DRAW,
+
+    COUNT
+  };
+
+  static constexpr unsigned N_STAGES = unsigned(Stage::COUNT);
+
+  gcc_const
+  const char *GetStageName(Stage stage);
+
+  /**
+   * Record that the data received at the given time stamp (see
+   * MonotonicClockUS()) has passed the given stage.  Does nothing if
+   * the time stamp is zero or if it has already been recorded for
+   * this stage.
+   */
+  void Record(Stage stage, uint64_t receive_clock_us);
+
+  LatencyHistogram::Summary GetSummary(Stage stage);
+
+  /**
+   * Returns a copy of the histogram of the given stage.
+   */
+  LatencyHistogram GetHistogram(Stage stage);
+
+  /**
+   * Write the statistics of all stages to the log file.
+   */
+  void Log();
+
+  void Clear();
+}
+
+#endif
@@ -30,6 +30,7 @@ Copyright_License {
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Components.hpp"
 #include "Time/PeriodClock.hpp"
+#include "PipelineLatency.hpp"
 #include "MainWindow.hpp"
 #include "PopupMessage.hpp"
 #include "Simulator.hpp"
@@ -181,6 +182,18 @@ SettingsProcessTimer()
   ProcessAutoBugs();
 }
 
+/**
+ * Write the pipeline latency statistics to the log file every few
+ * minutes.
+ */
+static void
+LatencyProcessTimer()
+{
+  static PeriodClock clock;
+  if (clock.CheckUpdate(5 * 60 * 1000))
+    PipelineLatency::Log();
+}
+
 static void
 CommonProcessTimer()
 {
@@ -193,6 +206,7 @@ CommonProcessTimer()
 
   MessageProcessTimer();
   SystemProcessTimer();
+  LatencyProcessTimer();
 }
 
 static void
@@ -171,6 +171,7 @@ const char EnableNavBaroAltitude[] = "EnableNavBaroAltitude";
 
 const char LoggerTimeStepCruise[] = "LoggerTimeStepCruise";
 const char LoggerTimeStepCircling[] = "LoggerTimeStepCircling";
+const char LoggerHighRate[] = "LoggerHighRate";
 
 const char SafetyMacCready[] = "SafetyMacCready";
 const char AbortTaskMode[] = "AbortTaskMode";
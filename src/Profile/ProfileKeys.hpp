@@ -166,6 +166,7 @@ extern const char EnableNavBaroAltitude[];
 
 extern const char LoggerTimeStepCruise[];
 extern const char LoggerTimeStepCircling[];
+extern const char LoggerHighRate[];
 
 extern const char SafetyMacCready[];
 extern const char AbortTaskMode[];
@@ -103,7 +103,8 @@ CreateCalculationThread()
   glide_computer->ProcessGPS(true);
 
   /* copy GlideComputer results to DeviceBlackboard */
-  device_blackboard->ReadBlackboard(glide_computer->Calculated());
+  device_blackboard->ReadBlackboard(CalculatedSnapshot(glide_computer
+                                                       ->Calculated()));
 
   calculation_thread = new CalculationThread(*glide_computer);
   calculation_thread->SetComputerSettings(CommonInterface::GetComputerSettings());
@@ -77,6 +77,8 @@ AirspaceRenderer::Draw(Canvas &canvas,
   if (airspaces == nullptr || airspaces->IsEmpty())
     return;
 
+  shape_cache.Update(*airspaces);
+
   DrawInternal(canvas,
 #ifndef ENABLE_OPENGL
                stencil_canvas,
@@ -24,6 +24,7 @@ Copyright_License {
 #ifndef XCSOAR_AIRSPACE_RENDERER_HPP
 #define XCSOAR_AIRSPACE_RENDERER_HPP
 
+#include "AirspaceShapeCache.hpp"
 #include "Util/StaticArray.hxx"
 #include "Geo/GeoPoint.hpp"
 
@@ -52,6 +53,12 @@ class AirspaceRenderer
 
   StaticArray<GeoPoint,32> intersections;
 
+  /**
+   * Simplified outlines and triangulations of the airspace
+   * polygons, so they don't need to be calculated each frame.
+   */
+  AirspaceShapeCache shape_cache;
+
 #ifndef ENABLE_OPENGL
   /**
    * This object caches the airspace fill.  This avoids drawing it
@@ -93,6 +100,7 @@ public:
   void Clear() {
     airspaces = nullptr;
     warning_manager = nullptr;
+    shape_cache.Clear();
   }
 
   void Flush() {
@@ -119,7 +127,7 @@ private:
   void DrawOutline(Canvas &canvas,
                    const WindowProjection &projection,
                    const AirspaceRendererSettings &settings,
-                   const AirspacePredicate &visible) const;
+                   const AirspacePredicate &visible);
 #endif
 
   void DrawInternal(Canvas &canvas,
@@ -35,9 +35,166 @@ Copyright_License {
 #include "Airspace/AirspaceWarningCopy.hpp"
 #include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
 #include "Screen/OpenGL/Scope.hpp"
+#include "Screen/OpenGL/VertexPointer.hpp"
+#include "Screen/OpenGL/Geo.hpp"
 
-class AirspaceVisitorRenderer final
+#ifdef USE_GLSL
+#include "Screen/OpenGL/Shaders.hpp"
+#include "Screen/OpenGL/Program.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+#endif
+
+/**
+ * Applies the map projection to the flat coordinates of an
+ * #AirspaceShapeCache::Shape while this object exists.
+ */
+class ScopeShapeProjection {
+public:
+  ScopeShapeProjection(const WindowProjection &projection,
+                       const GeoPoint &reference) {
+#ifdef USE_GLSL
+    OpenGL::solid_shader->Use();
+    glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                       glm::value_ptr(ToGLM(projection, reference)));
+#else
+    glPushMatrix();
+    ApplyProjection(projection, reference);
+#endif
+  }
+
+  ~ScopeShapeProjection() {
+#ifdef USE_GLSL
+    glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                       glm::value_ptr(glm::mat4()));
+#else
+    glPopMatrix();
+#endif
+  }
+};
+
+/**
+ * Base class for the airspace renderers below: draws polygons from
+ * the #AirspaceShapeCache.  Fills and thin outlines are drawn from
+ * the cached flat coordinates, with the projection applied by
+ * OpenGL.  Only wide outlines still need to be clipped and
+ * projected, because Canvas triangulates them in screen
+ * coordinates.
+ */
+class CachedAirspaceRenderer
   : protected MapCanvas
+{
+  const WindowProjection &window_projection;
+  const GeoBounds screen_bounds;
+
+  AirspaceShapeCache &shape_cache;
+  const unsigned level;
+
+  /**
+   * The polygon selected by BeginPolygon().  #shape is nullptr if
+   * the polygon cannot be cached; it is then drawn from the raster
+   * points prepared in each frame.
+   */
+  const SearchPointVector *points;
+  const AirspaceShapeCache::Shape *shape;
+  const AirspaceShapeCache::Level *shape_level;
+
+  /**
+   * Have the raster points of the selected polygon been prepared?
+   * Only needed for wide outlines and uncached polygons.
+   */
+  bool prepared, prepared_visible;
+
+protected:
+  const Pen black_pen;
+
+  CachedAirspaceRenderer(Canvas &_canvas, const WindowProjection &_projection,
+                         AirspaceShapeCache &_shape_cache)
+    :MapCanvas(_canvas, _projection,
+               _projection.GetScreenBounds().Scale(1.1)),
+     window_projection(_projection),
+     screen_bounds(_projection.GetScreenBounds()),
+     shape_cache(_shape_cache),
+     level(AirspaceShapeCache::GetLevel(_projection)),
+     black_pen(1, COLOR_BLACK) {}
+
+  /**
+   * Select the polygon for the following FillPolygon() and
+   * DrawOutline() calls.
+   *
+   * @return false if the polygon is not visible
+   */
+  bool BeginPolygon(const AbstractAirspace &airspace) {
+    points = &airspace.GetPoints();
+
+    auto *_shape = shape_cache.Get(airspace);
+    if (_shape == nullptr) {
+      /* too many vertices for 16 bit indices: clip, project and
+         triangulate in each frame */
+      shape = nullptr;
+      prepared = true;
+      prepared_visible = PreparePolygon(*points);
+      return prepared_visible;
+    }
+
+    if (!_shape->bounds.Overlaps(screen_bounds))
+      return false;
+
+    shape = _shape;
+    shape_level = &_shape->GetLevel(level);
+    prepared = false;
+    return true;
+  }
+
+  void FillPolygon(const Brush &brush) {
+    if (shape == nullptr) {
+      canvas.Select(brush);
+      canvas.SelectNullPen();
+      DrawPrepared();
+      return;
+    }
+
+    const auto &triangles = shape_level->triangles;
+    if (triangles.empty())
+      return;
+
+    const ScopeShapeProjection scope(window_projection, shape->reference);
+    const ScopeVertexPointer vp(shape->points.data());
+
+    brush.Bind();
+    glDrawElements(GL_TRIANGLES, triangles.size(), GL_UNSIGNED_SHORT,
+                   triangles.data());
+  }
+
+  void DrawOutline(const Pen &pen) {
+    if (shape != nullptr && pen.GetWidth() <= 2) {
+      const auto &outline = shape_level->outline;
+      const ScopeShapeProjection scope(window_projection, shape->reference);
+      const ScopeVertexPointer vp(shape->points.data());
+
+      pen.Bind();
+      glDrawElements(GL_LINE_LOOP, outline.size(), GL_UNSIGNED_SHORT,
+                     outline.data());
+      pen.Unbind();
+    } else {
+      if (!prepared) {
+        const auto &outline = shape_level->outline;
+        prepared = true;
+        prepared_visible = PreparePolygon(*points, outline.data(),
+                                          outline.size());
+      }
+
+      if (prepared_visible) {
+        canvas.Select(pen);
+        canvas.SelectHollowBrush();
+        DrawPrepared();
+      }
+    }
+  }
+};
+
+class AirspaceVisitorRenderer final
+  : protected CachedAirspaceRenderer
 {
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
@@ -47,9 +204,9 @@ public:
   AirspaceVisitorRenderer(Canvas &_canvas, const WindowProjection &_projection,
                           const AirspaceLook &_look,
                           const AirspaceWarningCopy &_warnings,
-                          const AirspaceRendererSettings &_settings)
-    :MapCanvas(_canvas, _projection,
-               _projection.GetScreenBounds().Scale(1.1)),
+                          const AirspaceRendererSettings &_settings,
+                          AirspaceShapeCache &_shape_cache)
+    :CachedAirspaceRenderer(_canvas, _projection, _shape_cache),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glStencilMask(0xff);
@@ -75,7 +232,8 @@ private:
         AirspaceClassRendererSettings::FillMode::NONE) {
       const GLEnable<GL_STENCIL_TEST> stencil;
       const GLEnable<GL_BLEND> blend;
-      SetupInterior(airspace);
+      canvas.Select(SetupInterior(airspace));
+      canvas.SelectNullPen();
       if (warning_manager.HasWarning(airspace) ||
           warning_manager.IsInside(airspace) ||
           look.thick_pen.GetWidth() >= 2 * screen_radius ||
@@ -95,12 +253,16 @@ private:
     }
 
     // draw outline
-    if (SetupOutline(airspace))
+    const Pen *pen = SetupOutline(airspace);
+    if (pen != nullptr) {
+      canvas.Select(*pen);
+      canvas.SelectHollowBrush();
       canvas.DrawCircle(screen_center.x, screen_center.y, screen_radius);
+    }
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    if (!BeginPolygon(airspace))
       return;
 
     const AirspaceClassRendererSettings &class_settings =
@@ -119,28 +281,29 @@ private:
       if (!fill_airspace) {
         // set stencil for filling (bit 0)
         SetFillStencil();
-        DrawPrepared();
+        DrawOutline(look.thick_pen);
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
 
       // fill interior without overpainting any previous outlines
       {
-        SetupInterior(airspace, !fill_airspace);
+        const Brush brush = SetupInterior(airspace, !fill_airspace);
         const GLEnable<GL_BLEND> blend;
-        DrawPrepared();
+        FillPolygon(brush);
       }
 
       if (!fill_airspace) {
         // clear fill stencil (bit 0)
         ClearFillStencil();
-        DrawPrepared();
+        DrawOutline(look.thick_pen);
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
     }
 
     // draw outline
-    if (SetupOutline(airspace))
-      DrawPrepared();
+    const Pen *pen = SetupOutline(airspace);
+    if (pen != nullptr)
+      DrawOutline(*pen);
   }
 
 public:
@@ -157,29 +320,28 @@ public:
   }
 
 private:
-  bool SetupOutline(const AbstractAirspace &airspace) {
+  const Pen *SetupOutline(const AbstractAirspace &airspace) {
     AirspaceClass type = airspace.GetType();
 
+    const Pen *pen;
     if (settings.black_outline)
-      canvas.SelectBlackPen();
+      pen = &black_pen;
     else if (settings.classes[type].border_width == 0)
       // Don't draw outlines if border_width == 0
-      return false;
+      return nullptr;
     else
-      canvas.Select(look.classes[type].border_pen);
-
-    canvas.SelectHollowBrush();
+      pen = &look.classes[type].border_pen;
 
     // set bit 1 in stencil buffer, where an outline is drawn
     glStencilFunc(GL_ALWAYS, 3, 3);
     glStencilMask(2);
     glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 
-    return true;
+    return pen;
   }
 
-  void SetupInterior(const AbstractAirspace &airspace,
-                     bool check_fillstencil = false) {
+  Brush SetupInterior(const AbstractAirspace &airspace,
+                      bool check_fillstencil = false) {
     const AirspaceClassLook &class_look = look.classes[airspace.GetType()];
 
     // restrict drawing area and don't paint over previously drawn outlines
@@ -189,8 +351,7 @@ private:
       glStencilFunc(GL_EQUAL, 0, 2);
     glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 
-    canvas.Select(Brush(class_look.fill_color.WithAlpha(90)));
-    canvas.SelectNullPen();
+    return Brush(class_look.fill_color.WithAlpha(90));
   }
 
   void SetFillStencil() {
@@ -198,9 +359,6 @@ private:
     glStencilFunc(GL_ALWAYS, 3, 3);
     glStencilMask(1);
     glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
-
-    canvas.SelectHollowBrush();
-    canvas.Select(look.thick_pen);
   }
 
   void ClearFillStencil() {
@@ -208,14 +366,11 @@ private:
     glStencilFunc(GL_ALWAYS, 3, 3);
     glStencilMask(1);
     glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
-
-    canvas.SelectHollowBrush();
-    canvas.Select(look.thick_pen);
   }
 };
 
 class AirspaceFillRenderer final
-  : protected MapCanvas
+  : protected CachedAirspaceRenderer
 {
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
@@ -225,9 +380,9 @@ public:
   AirspaceFillRenderer(Canvas &_canvas, const WindowProjection &_projection,
                        const AirspaceLook &_look,
                        const AirspaceWarningCopy &_warnings,
-                       const AirspaceRendererSettings &_settings)
-    :MapCanvas(_canvas, _projection,
-               _projection.GetScreenBounds().Scale(1.1)),
+                       const AirspaceRendererSettings &_settings,
+                       AirspaceShapeCache &_shape_cache)
+    :CachedAirspaceRenderer(_canvas, _projection, _shape_cache),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -238,29 +393,36 @@ private:
     auto screen_center = projection.GeoToScreen(airspace.GetReferenceLocation());
     unsigned screen_radius = projection.GeoToScreenDistance(airspace.GetRadius());
 
-    if (!warning_manager.IsAcked(airspace) && SetupInterior(airspace)) {
+    if (!warning_manager.IsAcked(airspace) && IsFilled()) {
       const GLEnable<GL_BLEND> blend;
+      canvas.Select(GetInteriorBrush(airspace));
+      canvas.SelectNullPen();
       canvas.DrawCircle(screen_center.x, screen_center.y, screen_radius);
     }
 
     // draw outline
-    if (SetupOutline(airspace))
+    const Pen *pen = GetOutlinePen(airspace);
+    if (pen != nullptr) {
+      canvas.Select(*pen);
+      canvas.SelectHollowBrush();
       canvas.DrawCircle(screen_center.x, screen_center.y, screen_radius);
+    }
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    if (!BeginPolygon(airspace))
       return;
 
-    if (!warning_manager.IsAcked(airspace) && SetupInterior(airspace)) {
+    if (!warning_manager.IsAcked(airspace) && IsFilled()) {
       // fill interior without overpainting any previous outlines
       GLEnable<GL_BLEND> blend;
-      DrawPrepared();
+      FillPolygon(GetInteriorBrush(airspace));
     }
 
     // draw outline
-    if (SetupOutline(airspace))
-      DrawPrepared();
+    const Pen *pen = GetOutlinePen(airspace);
+    if (pen != nullptr)
+      DrawOutline(*pen);
   }
 
 public:
@@ -277,32 +439,25 @@ public:
   }
 
 private:
-  bool SetupOutline(const AbstractAirspace &airspace) {
+  const Pen *GetOutlinePen(const AbstractAirspace &airspace) const {
     AirspaceClass type = airspace.GetType();
 
     if (settings.black_outline)
-      canvas.SelectBlackPen();
+      return &black_pen;
     else if (settings.classes[type].border_width == 0)
       // Don't draw outlines if border_width == 0
-      return false;
+      return nullptr;
     else
-      canvas.Select(look.classes[type].border_pen);
-
-    canvas.SelectHollowBrush();
-
-    return true;
+      return &look.classes[type].border_pen;
   }
 
-  bool SetupInterior(const AbstractAirspace &airspace) {
-    if (settings.fill_mode == AirspaceRendererSettings::FillMode::NONE)
-      return false;
+  bool IsFilled() const {
+    return settings.fill_mode != AirspaceRendererSettings::FillMode::NONE;
+  }
 
+  Brush GetInteriorBrush(const AbstractAirspace &airspace) const {
     const AirspaceClassLook &class_look = look.classes[airspace.GetType()];
-
-    canvas.Select(Brush(class_look.fill_color.WithAlpha(48)));
-    canvas.SelectNullPen();
-
-    return true;
+    return Brush(class_look.fill_color.WithAlpha(48));
   }
 };
 
@@ -319,14 +474,16 @@ AirspaceRenderer::DrawInternal(Canvas &canvas,
 
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL ||
       settings.fill_mode == AirspaceRendererSettings::FillMode::NONE) {
-    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings,
+                                  shape_cache);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
         renderer.Visit(airspace);
     }
   } else {
-    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings,
+                                     shape_cache);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
@@ -51,13 +51,19 @@ class AirspaceVisitorMap final
   const AirspaceLook &look;
   const AirspaceWarningCopy &warnings;
 
+  AirspaceShapeCache &shape_cache;
+  const unsigned level;
+
 public:
   AirspaceVisitorMap(StencilMapCanvas &_helper,
                      const AirspaceWarningCopy &_warnings,
                      const AirspaceRendererSettings &_settings,
-                     const AirspaceLook &_airspace_look)
+                     const AirspaceLook &_airspace_look,
+                     AirspaceShapeCache &_shape_cache)
     :StencilMapCanvas(_helper),
-     look(_airspace_look), warnings(_warnings)
+     look(_airspace_look), warnings(_warnings),
+     shape_cache(_shape_cache),
+     level(AirspaceShapeCache::GetLevel(proj))
   {
     switch (settings.fill_mode) {
     case AirspaceRendererSettings::FillMode::DEFAULT:
@@ -80,7 +86,16 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    DrawSearchPointVector(airspace.GetPoints());
+    auto *shape = shape_cache.Get(airspace);
+    if (shape == nullptr) {
+      /* not cached (too many vertices): draw all of them */
+      DrawSearchPointVector(airspace.GetPoints());
+      return;
+    }
+
+    const auto &outline = shape->GetLevel(level).outline;
+    DrawSearchPointVector(airspace.GetPoints(),
+                          outline.data(), outline.size());
   }
 
 public:
@@ -156,13 +171,19 @@ class AirspaceOutlineRenderer final
   const AirspaceLook &look;
   const AirspaceRendererSettings &settings;
 
+  AirspaceShapeCache &shape_cache;
+  const unsigned level;
+
 public:
   AirspaceOutlineRenderer(Canvas &_canvas, const WindowProjection &_projection,
                           const AirspaceLook &_look,
-                          const AirspaceRendererSettings &_settings)
+                          const AirspaceRendererSettings &_settings,
+                          AirspaceShapeCache &_shape_cache)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
-     look(_look), settings(_settings)
+     look(_look), settings(_settings),
+     shape_cache(_shape_cache),
+     level(AirspaceShapeCache::GetLevel(_projection))
   {
     if (settings.black_outline)
       canvas.SelectBlackPen();
@@ -190,7 +211,17 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    DrawPolygon(airspace.GetPoints());
+    auto *shape = shape_cache.Get(airspace);
+    if (shape == nullptr) {
+      /* not cached (too many vertices): draw all of them */
+      if (PreparePolygon(airspace.GetPoints()))
+        DrawPrepared();
+      return;
+    }
+
+    const auto &outline = shape->GetLevel(level).outline;
+    if (PreparePolygon(airspace.GetPoints(), outline.data(), outline.size()))
+      DrawPrepared();
   }
 
 public:
@@ -220,7 +251,7 @@ AirspaceRenderer::DrawFill(Canvas &buffer_canvas, Canvas &stencil_canvas,
   StencilMapCanvas helper(buffer_canvas, stencil_canvas, projection,
                           settings);
   AirspaceVisitorMap v(helper, awc, settings,
-                       look);
+                       look, shape_cache);
 
   // JMW TODO wasteful to draw twice, can't it be drawn once?
   // we are using two draws so borders go on top of everything
@@ -274,13 +305,14 @@ inline void
 AirspaceRenderer::DrawOutline(Canvas &canvas,
                               const WindowProjection &projection,
                               const AirspaceRendererSettings &settings,
-                              const AirspacePredicate &visible) const
+                              const AirspacePredicate &visible)
 {
   const auto range =
     airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters());
 
-  AirspaceOutlineRenderer outline_renderer(canvas, projection, look, settings);
+  AirspaceOutlineRenderer outline_renderer(canvas, projection, look, settings,
+                                           shape_cache);
   for (const auto &i : range) {
     const AbstractAirspace &airspace = i.GetAirspace();
     if (visible(airspace))
@@ -0,0 +1,147 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspaceShapeCache.hpp"
+#include "Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Projection/Projection.hpp"
+#include "Geo/FAISphere.hpp"
+
+#ifdef ENABLE_OPENGL
+#include "Screen/OpenGL/Triangulate.hpp"
+#endif
+
+#include <assert.h>
+
+void
+AirspaceShapeCache::Update(const Airspaces &_airspaces)
+{
+  if (&_airspaces == airspaces && _airspaces.GetSerial() == serial)
+    return;
+
+  airspaces = &_airspaces;
+  serial = _airspaces.GetSerial();
+  shapes.clear();
+}
+
+float
+AirspaceShapeCache::GetMinDistance(unsigned level)
+{
+  return float((2 << level) / FAISphere::REARTH);
+}
+
+unsigned
+AirspaceShapeCache::GetLevel(const Projection &projection)
+{
+  /* the size of one pixel in radians */
+  const double pixel = 1. / (projection.GetScale() * FAISphere::REARTH);
+
+  unsigned level = 0;
+  while (level + 1 < NUM_LEVELS && GetMinDistance(level + 1) <= pixel)
+    ++level;
+
+  return level;
+}
+
+AirspaceShapeCache::Shape *
+AirspaceShapeCache::Get(const AbstractAirspace &airspace)
+{
+  auto i = shapes.find(&airspace);
+  if (i != shapes.end())
+    return &i->second;
+
+  const SearchPointVector &src = airspace.GetPoints();
+  if (src.size() < 3 || src.size() > 0xffff)
+    return nullptr;
+
+  Shape &shape = shapes[&airspace];
+  shape.bounds = src.CalculateGeoBounds();
+  shape.reference = shape.bounds.GetCenter();
+
+  shape.points.reserve(src.size());
+  for (const auto &p : src) {
+    const GeoPoint relative = p.GetLocation() - shape.reference;
+    shape.points.emplace_back(float(relative.longitude.Native()),
+                              float(relative.latitude.Native()));
+  }
+
+  return &shape;
+}
+
+const AirspaceShapeCache::Level &
+AirspaceShapeCache::Shape::GetLevel(unsigned i)
+{
+  assert(i < NUM_LEVELS);
+
+  Level &level = levels[i];
+  if (level.built)
+    return level;
+
+  level.built = true;
+
+  const float min_distance = GetMinDistance(i);
+  const unsigned n = points.size();
+
+  /* a longitude difference is shorter than the same latitude
+     difference by cos(latitude); scale it, so the tolerance is the
+     same in both directions; the triangulation does not change when
+     one axis is scaled, so it can use these points, too */
+  const float longitude_scale = reference.latitude.fastcosine();
+  std::vector<FloatPoint2D> scaled;
+  scaled.reserve(n);
+  for (const auto &p : points)
+    scaled.emplace_back(p.x * longitude_scale, p.y);
+
+  /* add points if they are not too close to the previous point */
+  auto &outline = level.outline;
+  outline.push_back(0);
+  for (unsigned j = 1; j < n; ++j)
+    if (ManhattanDistance(scaled[outline.back()], scaled[j]) >= min_distance)
+      outline.push_back(j);
+
+  /* the outline is a loop: remove points from behind if they are
+     too close to the first point */
+  while (outline.size() > 1 &&
+         ManhattanDistance(scaled[outline.back()], scaled[0]) < min_distance)
+    outline.pop_back();
+
+  if (outline.size() < 3) {
+    /* smaller than the tolerance; don't let it vanish */
+    outline.resize(n);
+    for (unsigned j = 0; j < n; ++j)
+      outline[j] = j;
+  }
+
+  outline.shrink_to_fit();
+
+#ifdef ENABLE_OPENGL
+  level.triangles.resize(3 * (n - 2));
+  const unsigned count = PolygonToTriangles(scaled.data(), n,
+                                            level.triangles.data(),
+                                            min_distance);
+  level.triangles.resize(count);
+  level.triangles.shrink_to_fit();
+#endif
+
+  return level;
+}
@@ -0,0 +1,144 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_SHAPE_CACHE_HPP
+#define XCSOAR_AIRSPACE_SHAPE_CACHE_HPP
+
+#include "Geo/GeoPoint.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Math/Point2D.hpp"
+#include "Util/Serial.hpp"
+#include "Compiler.h"
+
+#ifdef ENABLE_OPENGL
+#include "Screen/OpenGL/System.hpp"
+#endif
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+
+#include <stdint.h>
+
+class Airspaces;
+class AbstractAirspace;
+class Projection;
+
+/**
+ * Caches the parts of an airspace polygon's geometry which do not
+ * depend on the map position: the vertices in flat coordinates
+ * relative to a reference point, and for each zoom level a
+ * simplified outline (and with OpenGL, its triangulation).  A frame
+ * then only needs to apply the projection, instead of thinning and
+ * triangulating each polygon again.
+ *
+ * The cache is flushed when the #Airspaces object is modified.
+ */
+class AirspaceShapeCache {
+public:
+  /**
+   * The number of zoom levels.  Level 0 removes vertices which are
+   * closer than two metres to their neighbour, and each following
+   * level doubles that distance.  Longitude differences are scaled
+   * by the cosine of the latitude.
+   */
+  static constexpr unsigned NUM_LEVELS = 10;
+
+  struct Level {
+    bool built = false;
+
+    /**
+     * Indices of the vertices remaining in the simplified outline.
+     */
+    std::vector<uint16_t> outline;
+
+#ifdef ENABLE_OPENGL
+    /**
+     * Triangle indices (GL_TRIANGLES) of the simplified polygon.
+     */
+    std::vector<GLushort> triangles;
+#endif
+  };
+
+  struct Shape {
+    GeoBounds bounds;
+
+    GeoPoint reference;
+
+    /**
+     * The vertices relative to #reference: longitude and latitude
+     * in radians, as expected by ToGLM() and ApplyProjection().
+     */
+    std::vector<FloatPoint2D> points;
+
+    std::array<Level, NUM_LEVELS> levels;
+
+    /**
+     * Returns the given zoom level, building it on the first call.
+     */
+    const Level &GetLevel(unsigned level);
+  };
+
+private:
+  const Airspaces *airspaces = nullptr;
+  Serial serial;
+
+  std::unordered_map<const AbstractAirspace *, Shape> shapes;
+
+public:
+  /**
+   * Flush the cache if the #Airspaces object is a different one or
+   * has been modified since the last call.
+   */
+  void Update(const Airspaces &airspaces);
+
+  void Clear() {
+    airspaces = nullptr;
+    shapes.clear();
+  }
+
+  /**
+   * Determine the zoom level for the given projection: the
+   * coarsest one whose simplification stays below one pixel.
+   */
+  gcc_pure
+  static unsigned GetLevel(const Projection &projection);
+
+  /**
+   * @return the minimum vertex distance of the given zoom level in
+   * radians
+   */
+  gcc_const
+  static float GetMinDistance(unsigned level);
+
+  /**
+   * Look up the shape of the given polygon airspace, converting it
+   * on the first call.
+   *
+   * @return nullptr if the polygon has fewer than 3 or more than
+   * 65535 vertices; the caller must then draw it without the cache
+   */
+  Shape *Get(const AbstractAirspace &airspace);
+};
+
+#endif
@@ -61,6 +61,7 @@ BackgroundRenderer::Draw(Canvas& canvas,
       renderer.reset(new TerrainRenderer(*terrain));
 
     renderer->SetSettings(terrain_settings);
+    renderer->SetQualityShift(quality_shift);
     if (renderer->Generate(proj, shading_angle))
       renderer->Draw(canvas, proj);
   }
@@ -45,6 +45,11 @@ class BackgroundRenderer {
   std::unique_ptr<TerrainRenderer> renderer;
   Angle shading_angle = DEFAULT_SHADING_ANGLE;
 
+  /**
+   * @see RasterRenderer::SetQualityShift()
+   */
+  unsigned quality_shift = 0;
+
 public:
   BackgroundRenderer();
 
@@ -62,8 +67,21 @@ public:
   void SetShadingAngle(const WindowProjection &projection,
                        const TerrainRendererSettings &settings,
                        const DerivedInfo &calculated);
+
+  Angle GetShadingAngle() const {
+    return shading_angle;
+  }
+
   void SetTerrain(const RasterTerrain *terrain);
 
+  unsigned GetQualityShift() const {
+    return quality_shift;
+  }
+
+  void SetQualityShift(unsigned _shift) {
+    quality_shift = _shift;
+  }
+
 private:
   void SetShadingAngle(const WindowProjection& proj, Angle angle);
 };
@@ -32,9 +32,16 @@ class Canvas;
 class Font;
 
 class FlightListRenderer {
+public:
+  /**
+   * The number of most recent flights which are kept.
+   */
+  static constexpr unsigned MAX_FLIGHTS = 128;
+
+private:
   const Font &font, &header_font;
 
-  OverwritingRingBuffer<FlightInfo, 128u> flights;
+  OverwritingRingBuffer<FlightInfo, MAX_FLIGHTS> flights;
 
 public:
   FlightListRenderer(const Font &_font, const Font &_header_font)
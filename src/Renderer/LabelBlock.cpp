@@ -23,45 +23,117 @@ Copyright_License {
 
 #include "LabelBlock.hpp"
 
-void
-LabelBlock::Bucket::Clear()
+#include <algorithm>
+
+constexpr uint16_t LabelBlock::NONE;
+
+static constexpr bool
+IsSameRect(const PixelRect a, const PixelRect b)
+{
+  return a.left == b.left && a.top == b.top &&
+    a.right == b.right && a.bottom == b.bottom;
+}
+
+void LabelBlock::reset()
 {
   blocks.clear();
+  entries.clear();
+  std::fill_n(buckets, HASH_SIZE, NONE);
+
+  previous_labels.swap(labels);
+  labels.clear();
+  std::sort(previous_labels.begin(), previous_labels.end());
+
+  only_persistent = true;
 }
 
 bool
-LabelBlock::Bucket::Check(const PixelRect rc) const
+LabelBlock::Check(const PixelRect rc) const
 {
-  for (auto i = blocks.begin(), end = blocks.end(); i != end; ++i)
-    if (i->OverlapsWith(rc))
-      return false;
+  const int x1 = rc.left >> CELL_SHIFT, x2 = rc.right >> CELL_SHIFT;
+  const int y1 = rc.top >> CELL_SHIFT, y2 = rc.bottom >> CELL_SHIFT;
+
+  for (int y = y1; y <= y2; ++y) {
+    for (int x = x1; x <= x2; ++x) {
+      for (unsigned i = buckets[Hash(x, y)]; i != NONE; i = entries[i].next)
+        if (blocks[entries[i].block].OverlapsWith(rc))
+          return false;
+    }
+  }
 
   return true;
 }
 
-void LabelBlock::reset()
+void
+LabelBlock::Add(const PixelRect rc)
 {
-  for (unsigned i = 0; i < BUCKET_COUNT; ++i)
-    buckets[i].Clear();
+  const int x1 = rc.left >> CELL_SHIFT, x2 = rc.right >> CELL_SHIFT;
+  const int y1 = rc.top >> CELL_SHIFT, y2 = rc.bottom >> CELL_SHIFT;
+
+  if (blocks.size() >= NONE ||
+      entries.size() + unsigned((x2 - x1 + 1) * (y2 - y1 + 1)) >= NONE)
+    /* full; the label will be drawn, but not protected */
+    return;
+
+  const uint16_t block = blocks.size();
+  blocks.push_back(rc);
+
+  for (int y = y1; y <= y2; ++y) {
+    for (int x = x1; x <= x2; ++x) {
+      uint16_t &bucket = buckets[Hash(x, y)];
+      entries.push_back({block, bucket});
+      bucket = entries.size() - 1;
+    }
+  }
 }
 
-bool LabelBlock::check(const PixelRect rc)
+inline LabelBlock::Label *
+LabelBlock::FindPrevious(unsigned id)
 {
-  unsigned top = rc.top >> BUCKET_SHIFT;
-  unsigned bottom = rc.bottom >> BUCKET_SHIFT;
+  const Label key{id, PixelRect()};
+  auto i = std::lower_bound(previous_labels.begin(), previous_labels.end(),
+                            key);
+  return i != previous_labels.end() && i->id == id
+    ? &*i
+    : nullptr;
+}
 
-  if (top >= BUCKET_COUNT)
-    top = BUCKET_COUNT - 1;
+bool
+LabelBlock::WasVisible(unsigned id) const
+{
+  const Label key{id, PixelRect()};
+  return std::binary_search(previous_labels.begin(), previous_labels.end(),
+                            key);
+}
+
+bool
+LabelBlock::check(const PixelRect rc, unsigned id)
+{
+  bool persistent = false;
+  if (id != 0 && only_persistent) {
+    /* all blocks so far were placed together in the previous frame;
+       if this label was placed there at the same position, too, it
+       cannot overlap them */
+    Label *previous = FindPrevious(id);
+    if (previous != nullptr && IsSameRect(previous->rc, rc)) {
+      persistent = true;
+
+      /* don't let a duplicate id skip the test */
+      previous->rc = PixelRect(0, 0, -1, -1);
+    }
+  }
+
+  if (!persistent) {
+    if (!Check(rc))
+      return false;
 
-  if (bottom < BUCKET_COUNT && !buckets[bottom].Check(rc))
-    return false;
+    only_persistent = false;
+  }
 
-  if (top < bottom && !buckets[top].Check(rc))
-    return false;
+  Add(rc);
 
-  buckets[top].Add(rc);
-  if (bottom < BUCKET_COUNT && top != bottom)
-    buckets[bottom].Add(rc);
+  if (id != 0)
+    labels.push_back({id, rc});
 
   return true;
 }
@@ -25,51 +25,110 @@ Copyright_License {
 #define SCREEN_LABELBLOCK_HPP
 
 #include "Screen/Point.hpp"
-#include "Util/StaticArray.hxx"
 #include "Compiler.h"
 
+#include <vector>
+
+#include <stdint.h>
+
 /**
  * Simple code to prevent text writing over map city names.
+ *
+ * Placed labels are stored in a uniform grid (a spatial hash of
+ * fixed size cells), so a new label is only tested against the
+ * labels in the cells it covers.
+ *
+ * Labels may be given an id.  The labels with an id which were
+ * placed in the previous frame are remembered, so callers can prefer
+ * them (see WasVisible()) and they can be accepted again without
+ * collision tests.
  */
 class LabelBlock {
-#if defined(HAVE_GLES)
-  /* embedded (Android or Windows CE) */
-  static constexpr unsigned SCREEN_HEIGHT = 2048;
-  static constexpr unsigned BUCKET_SIZE = 64;
-#else
-  /* desktop, screen may be huge, lots of memory */
-  static constexpr unsigned SCREEN_HEIGHT = 4096;
-  static constexpr unsigned BUCKET_SIZE = 64;
-#endif
-  static constexpr unsigned BUCKET_SHIFT = 7;
-  static constexpr unsigned BUCKET_HEIGHT = 1 << BUCKET_SHIFT;
-  static constexpr unsigned BUCKET_COUNT = SCREEN_HEIGHT / BUCKET_HEIGHT;
+  /**
+   * The size of a grid cell is 2^CELL_SHIFT pixels.
+   */
+  static constexpr unsigned CELL_SHIFT = 6;
 
   /**
-   * A bucket is responsible for hit tests in one horizontal section
-   * of the screen.
+   * The number of hash buckets; must be a power of two.
    */
-  class Bucket {
-    typedef StaticArray<PixelRect, BUCKET_SIZE> BlockArray;
-    BlockArray blocks;
+  static constexpr unsigned HASH_SIZE = 512;
+
+  static constexpr uint16_t NONE = 0xffff;
 
-  public:
-    void Clear();
+  /**
+   * A reference from a hash bucket to a block.  The entries of a
+   * bucket form a singly linked list.
+   */
+  struct Entry {
+    uint16_t block, next;
+  };
 
-    gcc_pure
-    bool Check(const PixelRect rc) const;
+  struct Label {
+    unsigned id;
+    PixelRect rc;
 
-    void Add(const PixelRect rc) {
-      if (!blocks.full())
-        blocks.append(rc);
+    bool operator<(const Label &other) const {
+      return id < other.id;
     }
   };
 
-  Bucket buckets[BUCKET_COUNT];
+  std::vector<PixelRect> blocks;
+  std::vector<Entry> entries;
+  uint16_t buckets[HASH_SIZE];
+
+  /**
+   * The labels with an id placed in this frame and in the previous
+   * one.  The latter is sorted by id.
+   */
+  std::vector<Label> labels, previous_labels;
+
+  /**
+   * True while all blocks of this frame are labels placed at the
+   * same position in the previous frame.  These are known not to
+   * overlap each other.
+   */
+  bool only_persistent;
 
 public:
-  bool check(const PixelRect rc);
+  LabelBlock() {
+    reset();
+  }
+
+  /**
+   * Check if the rectangle overlaps a block which was added before;
+   * if not, add it.
+   *
+   * @param id a non-zero id of the label which is unique in this
+   * frame, or 0 if the label shall not be remembered
+   * @return true if the rectangle is free
+   */
+  bool check(const PixelRect rc, unsigned id=0);
+
+  /**
+   * Was the label with the given id placed in the previous frame?
+   */
+  gcc_pure
+  bool WasVisible(unsigned id) const;
+
+  /**
+   * Start a new frame.
+   */
   void reset();
+
+private:
+  gcc_const
+  static unsigned Hash(int x, int y) {
+    return ((unsigned)x * 73856093u ^ (unsigned)y * 19349663u)
+      & (HASH_SIZE - 1);
+  }
+
+  gcc_pure
+  bool Check(const PixelRect rc) const;
+
+  void Add(const PixelRect rc);
+
+  Label *FindPrevious(unsigned id);
 };
 
 #endif
@@ -0,0 +1,91 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LayerCache.hpp"
+#include "Projection/WindowProjection.hpp"
+
+#include <assert.h>
+
+bool
+LayerCache::Check(const WindowProjection &projection) const
+{
+  assert(projection.IsValid());
+
+  return buffer.IsDefined() &&
+    buffer.GetWidth() == projection.GetScreenWidth() &&
+    buffer.GetHeight() == projection.GetScreenHeight() &&
+    compare_projection.Compare(projection);
+}
+
+Canvas &
+LayerCache::Begin(Canvas &canvas, const WindowProjection &projection)
+{
+  assert(canvas.IsDefined());
+  assert(projection.IsValid());
+
+  const PixelSize size(projection.GetScreenWidth(),
+                       projection.GetScreenHeight());
+
+#ifdef ENABLE_OPENGL
+  if (!buffer.IsDefined())
+    buffer.Create(size);
+
+  /* this resizes the texture to the size of the given canvas */
+  buffer.Begin(canvas);
+#else
+  if (buffer.IsDefined())
+    buffer.Resize(size);
+  else
+    buffer.Create(canvas, size);
+#endif
+
+  compare_projection = CompareProjection(projection);
+  return buffer;
+}
+
+void
+LayerCache::Commit(Canvas &canvas, const WindowProjection &projection)
+{
+  assert(canvas.IsDefined());
+  assert(buffer.IsDefined());
+  assert(Check(projection));
+
+#ifdef ENABLE_OPENGL
+  buffer.Commit(canvas);
+#else
+  canvas.Copy(buffer);
+#endif
+}
+
+void
+LayerCache::CopyTo(Canvas &canvas)
+{
+  assert(canvas.IsDefined());
+  assert(buffer.IsDefined());
+
+#ifdef ENABLE_OPENGL
+  buffer.CopyTo(canvas);
+#else
+  canvas.Copy(buffer);
+#endif
+}
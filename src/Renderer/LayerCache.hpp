@@ -0,0 +1,87 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LAYER_CACHE_HPP
+#define XCSOAR_LAYER_CACHE_HPP
+
+#include "Projection/CompareProjection.hpp"
+#include "Screen/BufferCanvas.hpp"
+#include "Compiler.h"
+
+class Canvas;
+class WindowProjection;
+
+/**
+ * An opaque off-screen copy of one or more map layers which change
+ * only rarely (e.g. terrain and topography).  As long as the
+ * projection does not change, the layers can be copied from the cache
+ * instead of being rendered again.
+ *
+ * On OpenGL, the cache is a texture (rendered via frame buffer object
+ * if available); elsewhere, it is a #BufferCanvas.
+ *
+ * The caller is responsible for checking whether the layers' own
+ * data has changed; see Invalidate().
+ */
+class LayerCache {
+  CompareProjection compare_projection;
+  BufferCanvas buffer;
+
+public:
+  void Invalidate() {
+    compare_projection.Clear();
+  }
+
+  /**
+   * Check if the cache can be used.
+   *
+   * @return true if the cache is valid for the given projection; the
+   * caller may skip to CopyTo()
+   */
+  gcc_pure
+  bool Check(const WindowProjection &projection) const;
+
+  /**
+   * Begin drawing to the cache.  Render to the returned #Canvas and
+   * call Commit() when you're done.  Painting to the cache may be
+   * destructive for the specified #Canvas until Commit() is called.
+   *
+   * @param canvas the #Canvas which the layers are going to be
+   * copied to
+   */
+  Canvas &Begin(Canvas &canvas, const WindowProjection &projection);
+
+  /**
+   * Finish drawing to the cache, and copy it to the specified
+   * #Canvas (the same one that was passed to Begin()).
+   */
+  void Commit(Canvas &canvas, const WindowProjection &projection);
+
+  /**
+   * Copy the cache to the specified #Canvas.  Call Check() before
+   * this method.
+   */
+  void CopyTo(Canvas &canvas);
+};
+
+#endif
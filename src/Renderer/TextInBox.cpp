@@ -92,7 +92,8 @@ RenderShadowedText(Canvas &canvas, const TCHAR *text,
 // returns true if really wrote something
 bool
 TextInBox(Canvas &canvas, const TCHAR *text, int x, int y,
-          TextInBoxMode mode, const PixelRect &map_rc, LabelBlock *label_block)
+          TextInBoxMode mode, const PixelRect &map_rc, LabelBlock *label_block,
+          unsigned label_id)
 {
   // landable waypoint label inside white box
 
@@ -121,7 +122,7 @@ TextInBox(Canvas &canvas, const TCHAR *text, int x, int y,
     y += offset.y;
   }
 
-  if (label_block != nullptr && !label_block->check(rc))
+  if (label_block != nullptr && !label_block->check(rc, label_id))
     return false;
 
   if (mode.shape == LabelShape::ROUNDED_BLACK ||
@@ -167,7 +168,7 @@ bool
 TextInBox(Canvas &canvas, const TCHAR *text, int x, int y,
           TextInBoxMode mode,
           unsigned screen_width, unsigned screen_height,
-          LabelBlock *label_block)
+          LabelBlock *label_block, unsigned label_id)
 {
   PixelRect rc;
   rc.left = 0;
@@ -175,5 +176,5 @@ TextInBox(Canvas &canvas, const TCHAR *text, int x, int y,
   rc.right = screen_width;
   rc.bottom = screen_height;
 
-  return TextInBox(canvas, text, x, y, mode, rc, label_block);
+  return TextInBox(canvas, text, x, y, mode, rc, label_block, label_id);
 }
@@ -55,12 +55,12 @@ bool
 TextInBox(Canvas &canvas, const TCHAR *value,
           int x, int y,
           TextInBoxMode mode, const PixelRect &map_rc,
-          LabelBlock *label_block=nullptr);
+          LabelBlock *label_block=nullptr, unsigned label_id=0);
 
 bool
 TextInBox(Canvas &canvas, const TCHAR *value, int x, int y,
           TextInBoxMode mode,
           unsigned screen_width, unsigned screen_height,
-          LabelBlock *label_block=nullptr);
+          LabelBlock *label_block=nullptr, unsigned label_id=0);
 
 #endif
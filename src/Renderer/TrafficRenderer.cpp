@@ -54,7 +54,9 @@ TrafficRenderer::Draw(Canvas &canvas, const TrafficLook &traffic_look,
     canvas.Select(traffic_look.alarm_brush);
     break;
   case FlarmTraffic::AlarmType::NONE:
-    canvas.Select(traffic_look.safe_brush);
+    canvas.Select(traffic.IsPredictedConflict()
+                  ? traffic_look.warning_brush
+                  : traffic_look.safe_brush);
     break;
   }
 
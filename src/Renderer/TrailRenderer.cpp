@@ -35,9 +35,19 @@ Copyright_License {
 
 #include <algorithm>
 
+TrailRenderer::ProjectionKey::ProjectionKey(const WindowProjection &projection)
+  :defined(true),
+   location(projection.GetGeoLocation()),
+   origin(projection.GetScreenOrigin()),
+   scale(projection.GetScale()),
+   angle(projection.GetScreenAngle()) {}
+
 bool
 TrailRenderer::LoadTrace(const TraceComputer &trace_computer)
 {
+  trace_source = nullptr;
+  projected.clear();
+
   trace.clear();
   trace_computer.LockedCopyTo(trace);
   return !trace.empty();
@@ -48,10 +58,35 @@ TrailRenderer::LoadTrace(const TraceComputer &trace_computer,
                          unsigned min_time,
                          const WindowProjection &projection)
 {
-  trace.clear();
-  trace_computer.LockedCopyTo(trace, min_time,
-                              projection.GetGeoScreenCenter(),
-                              projection.DistancePixelsToMeters(3));
+  if (&trace_computer != trace_source || min_time < trace_min_time) {
+    /* can't reuse the old points */
+    trace_source = &trace_computer;
+    trace.clear();
+  }
+
+  trace_min_time = min_time;
+
+  if (trace_computer.LockedSyncTo(trace, min_time,
+                                  projection.GetGeoScreenCenter(),
+                                  projection.DistancePixelsToMeters(3),
+                                  trace_serial, trace_range)) {
+    projected.clear();
+    return !trace.empty();
+  }
+
+  /* remove the points which have become too old */
+  auto first = trace.begin();
+  while (first != trace.end() && first->GetTime() < min_time)
+    ++first;
+
+  const unsigned n_old = std::distance(trace.begin(), first);
+  if (n_old > 0) {
+    trace.erase(trace.begin(), first);
+    projected.erase(projected.begin(),
+                    projected.begin() + std::min<size_t>(n_old,
+                                                         projected.size()));
+  }
+
   return !trace.empty();
 }
 
@@ -140,22 +175,20 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
   bool scaled_trail = settings.scaling_enabled &&
                       projection.GetMapScale() <= 6000;
 
-  const GeoBounds bounds = projection.GetScreenBounds().Scale(4);
+  Project(projection, enable_traildrift, traildrift, basic.time);
+  assert(projected.size() == trace.size());
 
   PixelPoint last_point(0, 0);
   bool last_valid = false;
-  for (auto it = trace.begin(), end = trace.end(); it != end; ++it) {
-    const GeoPoint gp = enable_traildrift
-      ? it->GetLocation().Parametric(traildrift,
-                                     it->CalculateDrift(basic.time))
-      : it->GetLocation();
-    if (!bounds.IsInside(gp)) {
+  auto p = projected.begin();
+  for (auto it = trace.begin(), end = trace.end(); it != end; ++it, ++p) {
+    if (!p->visible) {
       /* the point is outside of the MapWindow; don't paint it */
       last_valid = false;
       continue;
     }
 
-    auto pt = projection.GeoToScreen(gp);
+    const PixelPoint pt = p->point;
 
     if (last_valid) {
       if (settings.type == TrailSettings::Type::ALTITUDE) {
@@ -201,6 +234,46 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
     canvas.DrawLine(last_point, pos);
 }
 
+void
+TrailRenderer::Project(const WindowProjection &projection,
+                       bool enable_traildrift, const GeoPoint &traildrift,
+                       double time)
+{
+  if (enable_traildrift) {
+    /* the drift depends on the time; these can't be reused in the
+       next frame */
+    projected.clear();
+    projection_key = ProjectionKey();
+  } else {
+    const ProjectionKey key(projection);
+    if (!(key == projection_key)) {
+      projected.clear();
+      projection_key = key;
+    }
+  }
+
+  if (projected.size() == trace.size())
+    return;
+
+  const GeoBounds bounds = projection.GetScreenBounds().Scale(4);
+
+  projected.reserve(trace.size());
+  for (auto it = std::next(trace.begin(), projected.size()),
+         end = trace.end(); it != end; ++it) {
+    const GeoPoint gp = enable_traildrift
+      ? it->GetLocation().Parametric(traildrift,
+                                     it->CalculateDrift(time))
+      : it->GetLocation();
+
+    ProjectedPoint p;
+    p.visible = bounds.IsInside(gp);
+    if (p.visible)
+      p.point = projection.GeoToScreen(gp);
+
+    projected.push_back(p);
+  }
+}
+
 void
 TrailRenderer::Draw(Canvas &canvas, const WindowProjection &projection)
 {
@@ -25,10 +25,14 @@ Copyright_License {
 #define XCSOAR_TRAIL_RENDERER_HPP
 
 #include "Util/AllocatedArray.hxx"
+#include "Util/Serial.hpp"
 #include "Engine/Trace/Point.hpp"
 #include "Engine/Trace/Vector.hpp"
+#include "Screen/Point.hpp"
+#include "Math/Angle.hpp"
+
+#include <vector>
 
-struct PixelPoint;
 struct BulkPixelPoint;
 class Canvas;
 class TraceComputer;
@@ -47,11 +51,63 @@ struct TrailSettings;
  * includes filter for coarse-graining trail in LoadTrace
  */
 class TrailRenderer {
+  /**
+   * The parameters of a #Projection which determine the screen
+   * position of a location.
+   */
+  struct ProjectionKey {
+    bool defined = false;
+    GeoPoint location;
+    PixelPoint origin;
+    double scale;
+    Angle angle;
+
+    ProjectionKey() = default;
+    explicit ProjectionKey(const WindowProjection &projection);
+
+    gcc_pure
+    bool operator==(const ProjectionKey &other) const {
+      return defined && other.defined &&
+        location == other.location && origin == other.origin &&
+        scale == other.scale && angle == other.angle;
+    }
+  };
+
+  struct ProjectedPoint {
+    PixelPoint point;
+
+    /**
+     * Is the location within the screen bounds (with some margin)?
+     * If not, #point is undefined.
+     */
+    bool visible;
+  };
+
   const TrailLook &look;
 
   TracePointVector trace;
   AllocatedArray<BulkPixelPoint> points;
 
+  /**
+   * The #TraceComputer which #trace was loaded from with
+   * LoadTrace(trace_computer, min_time, projection).  The following
+   * attributes allow appending new points to #trace instead of
+   * copying the whole trace each frame; see
+   * TraceComputer::LockedSyncTo().
+   */
+  const TraceComputer *trace_source = nullptr;
+  Serial trace_serial;
+  unsigned trace_range;
+  unsigned trace_min_time;
+
+  /**
+   * Screen coordinates of the first elements of #trace, projected
+   * with #projection_key.  New points get appended, and the vector
+   * is only discarded when the projection changes.
+   */
+  std::vector<ProjectedPoint> projected;
+  ProjectionKey projection_key;
+
 public:
   TrailRenderer(const TrailLook &_look):look(_look) {}
 
@@ -105,6 +161,13 @@ public:
 private:
   void DrawTraceVector(Canvas &canvas, const Projection &projection,
                        const TracePointVector &trace);
+
+  /**
+   * Project the points of #trace which are not yet in #projected.
+   */
+  void Project(const WindowProjection &projection,
+               bool enable_traildrift, const GeoPoint &traildrift,
+               double time);
 };
 
 #endif
@@ -58,6 +58,12 @@ MapWaypointLabelListCompare(const WaypointLabelList::Label &e1,
   if (!e1.isWatchedWaypoint && e2.isWatchedWaypoint)
     return false;
 
+  if (e1.persistent && !e2.persistent)
+    return true;
+
+  if (!e1.persistent && e2.persistent)
+    return false;
+
   if (e1.AltArivalAGL > e2.AltArivalAGL)
     return true;
 
@@ -68,7 +74,7 @@ MapWaypointLabelListCompare(const WaypointLabelList::Label &e1,
 }
 
 void
-WaypointLabelList::Add(const TCHAR *Name, int X, int Y,
+WaypointLabelList::Add(unsigned id, const TCHAR *Name, int X, int Y,
                        TextInBoxMode Mode, bool bold,
                        int AltArivalAGL, bool inTask,
                        bool isLandable, bool isAirport, bool isWatchedWaypoint)
@@ -82,6 +88,7 @@ WaypointLabelList::Add(const TCHAR *Name, int X, int Y,
 
   auto &l = labels.append();
 
+  l.id = id;
   CopyString(l.Name, Name, ARRAY_SIZE(l.Name));
   l.Pos.x = X;
   l.Pos.y = Y;
@@ -92,6 +99,7 @@ WaypointLabelList::Add(const TCHAR *Name, int X, int Y,
   l.isLandable = isLandable;
   l.isAirport  = isAirport;
   l.isWatchedWaypoint = isWatchedWaypoint;
+  l.persistent = false;
 }
 
 void
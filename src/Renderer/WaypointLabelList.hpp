@@ -35,6 +35,11 @@ Copyright_License {
 class WaypointLabelList : private NonCopyable {
 public:
   struct Label{
+    /**
+     * The waypoint id, to identify the label in the #LabelBlock.
+     */
+    unsigned id;
+
     TCHAR Name[NAME_SIZE+1];
     PixelPoint Pos;
     TextInBoxMode Mode;
@@ -44,6 +49,13 @@ public:
     bool isAirport;
     bool isWatchedWaypoint;
     bool bold;
+
+    /**
+     * Was this label visible in the previous frame?  It is then
+     * preferred over other labels of the same category, so labels
+     * don't flicker when the arrival altitudes change.
+     */
+    bool persistent;
   };
 
 protected:
@@ -55,13 +67,21 @@ public:
   WaypointLabelList(unsigned _width, unsigned _height)
     :width(_width), height(_height) {}
 
-  void Add(const TCHAR *name, int x, int y,
+  void Add(unsigned id, const TCHAR *name, int x, int y,
            TextInBoxMode Mode, bool bold,
            int AltArivalAGL,
            bool inTask, bool isLandable, bool isAirport,
            bool isWatchedWaypoint);
   void Sort();
 
+  Label *begin() {
+    return labels.begin();
+  }
+
+  Label *end() {
+    return labels.end();
+  }
+
   const Label *begin() const {
     return labels.begin();
   }
@@ -25,6 +25,7 @@ Copyright_License {
 #include "WaypointRendererSettings.hpp"
 #include "WaypointIconRenderer.hpp"
 #include "WaypointLabelList.hpp"
+#include "LabelBlock.hpp"
 #include "Projection/MapWindowProjection.hpp"
 #include "Computer/Settings.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
@@ -344,7 +345,8 @@ protected:
       // make space for the green circle
       sc.x += 5;
 
-    labels.Add(buffer, sc.x + 5, sc.y, text_mode, bold, vwp.reach.direct,
+    labels.Add(way_point.id, buffer, sc.x + 5, sc.y, text_mode, bold,
+               vwp.reach.direct,
                vwp.in_task, way_point.IsLandable(), way_point.IsAirport(),
                watchedWaypoint);
   }
@@ -443,13 +445,16 @@ MapWaypointLabelRender(Canvas &canvas, unsigned width, unsigned height,
                        WaypointLabelList &labels,
                        const WaypointLook &look)
 {
+  for (auto &l : labels)
+    l.persistent = label_block.WasVisible(l.id);
+
   labels.Sort();
 
   for (const auto &l : labels) {
     canvas.Select(l.bold ? *look.bold_font : *look.font);
 
     TextInBox(canvas, l.Name, l.Pos.x, l.Pos.y, l.Mode,
-              width, height, &label_block);
+              width, height, &label_block, l.id);
   }
 }
 
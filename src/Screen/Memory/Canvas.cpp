@@ -25,7 +25,7 @@ Copyright_License {
 #include "Screen/Bitmap.hpp"
 #include "Screen/Util.hpp"
 #include "Optimised.hpp"
-#include "RasterCanvas.hpp"
+#include "SDLRasterCanvas.hpp"
 #include "Screen/Custom/Cache.hpp"
 #include "Math/Angle.hpp"
 
@@ -45,20 +45,6 @@ Copyright_License {
 #include <assert.h>
 #include <string.h>
 
-class SDLRasterCanvas : public RasterCanvas<ActivePixelTraits> {
-public:
-  SDLRasterCanvas(WritableImageBuffer<ActivePixelTraits> buffer)
-    :RasterCanvas<ActivePixelTraits>(buffer) {}
-
-  static constexpr ActivePixelTraits::color_type Import(Color color) {
-#ifdef GREYSCALE
-    return Luminosity8(color.GetLuminosity());
-#else
-    return BGRA8Color(color.Red(), color.Green(), color.Blue(), color.Alpha());
-#endif
-  }
-};
-
 void
 Canvas::DrawOutlineRectangle(int left, int top, int right, int bottom,
                              Color color)
@@ -53,6 +53,7 @@ class Bitmap;
 class Canvas {
   friend class WindowCanvas;
   friend class SubCanvas;
+  friend class TileRasterizer;
 
   using ConstImageBuffer = ::ConstImageBuffer<ActivePixelTraits>;
 
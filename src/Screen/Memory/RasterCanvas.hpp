@@ -509,6 +509,13 @@ public:
     if (n_edges < 2)
       return;
 
+    /* rows outside of the buffer would be clipped anyway; skipping
+       them matters when the buffer is only one tile of a larger
+       polygon (see TileRasterizer); AdvanceTo() catches up with the
+       rows above */
+    miny = std::max(miny, 0);
+    maxy = std::min(maxy, int(buffer.height) - 1);
+
     auto edge_start = edge_buffer.begin();
     auto edge_end = edge_start+n_edges;
 
@@ -0,0 +1,292 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TileRasterizer.hpp"
+#include "SDLRasterCanvas.hpp"
+#include "Optimised.hpp"
+#include "Screen/Canvas.hpp"
+#include "Thread/Thread.hpp"
+
+#ifdef __ARM_NEON__
+#include "NEON.hpp"
+#endif
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+#include <assert.h>
+
+class TileRasterizer::Worker final : public Thread {
+  TileRasterizer &parent;
+
+  /**
+   * The last #TileRasterizer::generation this worker has handled.
+   * Initialised in the constructor (i.e. before the thread is
+   * started), so a Flush() which happens before the thread gets to
+   * run is not missed.
+   */
+  unsigned generation;
+
+public:
+  explicit Worker(TileRasterizer &_parent)
+    :Thread("TileRasterizer"), parent(_parent),
+     generation(_parent.generation) {}
+
+protected:
+  void Run() override;
+};
+
+void
+TileRasterizer::Worker::Run()
+{
+  const ScopeLock lock(parent.mutex);
+
+  while (true) {
+    while (!parent.quit && parent.generation == generation)
+      parent.wake_cond.wait(parent.mutex);
+
+    if (parent.quit)
+      return;
+
+    generation = parent.generation;
+
+    {
+      const ScopeUnlock unlock(parent.mutex);
+      parent.RunTiles();
+    }
+
+    assert(parent.busy > 0);
+    if (--parent.busy == 0)
+      parent.done_cond.signal();
+  }
+}
+
+static unsigned
+GetDefaultWorkers()
+{
+#ifdef HAVE_POSIX
+  const long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n_cpus > 1)
+    return std::min(unsigned(n_cpus - 1),
+                    unsigned(TileRasterizer::MAX_WORKERS));
+#endif
+
+  return 0;
+}
+
+TileRasterizer::TileRasterizer()
+  :TileRasterizer(GetDefaultWorkers()) {}
+
+TileRasterizer::TileRasterizer(unsigned _n_workers)
+  :n_workers(std::min(_n_workers, unsigned(MAX_WORKERS))) {}
+
+TileRasterizer::~TileRasterizer()
+{
+  StopWorkers();
+}
+
+void
+TileRasterizer::StartWorkers()
+{
+  assert(!workers_started);
+  assert(workers.empty());
+
+  workers_started = true;
+
+  for (unsigned i = 0; i < n_workers; ++i) {
+    auto *worker = new Worker(*this);
+    if (!worker->Start()) {
+      delete worker;
+      break;
+    }
+
+    workers.append(worker);
+  }
+}
+
+void
+TileRasterizer::StopWorkers()
+{
+  if (workers.empty())
+    return;
+
+  {
+    const ScopeLock lock(mutex);
+    quit = true;
+    wake_cond.broadcast();
+  }
+
+  for (auto *worker : workers) {
+    worker->Join();
+    delete worker;
+  }
+
+  workers.clear();
+}
+
+void
+TileRasterizer::AddPolygon(const BulkPixelPoint *_points, unsigned n,
+                           Color color)
+{
+  assert(_points != nullptr);
+
+  if (n < 3)
+    return;
+
+  Command c;
+  c.color = color;
+  c.first_point = points.size();
+  c.n_points = n;
+  c.top = c.bottom = _points[0].y;
+  for (unsigned i = 1; i < n; ++i) {
+    c.top = std::min(c.top, int(_points[i].y));
+    c.bottom = std::max(c.bottom, int(_points[i].y));
+  }
+
+  points.insert(points.end(), _points, _points + n);
+  commands.push_back(c);
+}
+
+void
+TileRasterizer::Bin(unsigned n_tiles)
+{
+  assert(n_tiles > 0);
+
+  tile_height = (target.height + n_tiles - 1) / n_tiles;
+  tiles.resize(n_tiles);
+  for (auto &tile : tiles)
+    tile.clear();
+
+  const int height = target.height;
+  for (unsigned i = 0, n = commands.size(); i < n; ++i) {
+    const Command &c = commands[i];
+    if (c.bottom < 0 || c.top >= height)
+      continue;
+
+    const unsigned first = std::max(c.top, 0) / tile_height;
+    const unsigned last = std::min(c.bottom, height - 1) / tile_height;
+    for (unsigned t = first; t <= last; ++t)
+      tiles[t].push_back(i);
+  }
+}
+
+void
+TileRasterizer::RunTile(unsigned tile, std::vector<BulkPixelPoint> &scratch)
+{
+  const unsigned top = tile * tile_height;
+  assert(top < target.height);
+
+  /* a canvas which covers just this tile; RasterCanvas clips
+     everything else */
+  WritableImageBuffer<ActivePixelTraits> strip = target;
+  strip.data = target.At(0, top);
+  strip.height = std::min(tile_height, target.height - top);
+
+  SDLRasterCanvas canvas(strip);
+
+  for (const unsigned i : tiles[tile]) {
+    const Command &c = commands[i];
+
+    scratch.resize(c.n_points);
+    const BulkPixelPoint *src = points.data() + c.first_point;
+    for (unsigned j = 0; j < c.n_points; ++j) {
+      scratch[j].x = src[j].x;
+      scratch[j].y = src[j].y - int(top);
+    }
+
+    const auto color = canvas.Import(c.color);
+    if (c.color.IsOpaque())
+      canvas.FillPolygon(scratch.data(), c.n_points, color);
+    else
+      canvas.FillPolygon(scratch.data(), c.n_points, color,
+                         AlphaPixelOperations<ActivePixelTraits>(c.color.Alpha()));
+  }
+}
+
+void
+TileRasterizer::RunTiles()
+{
+  std::vector<BulkPixelPoint> scratch;
+
+  const unsigned n_tiles = tiles.size();
+  unsigned tile;
+  while ((tile = next_tile.fetch_add(1, std::memory_order_relaxed)) < n_tiles)
+    if (!tiles[tile].empty())
+      RunTile(tile, scratch);
+}
+
+void
+TileRasterizer::Flush(Canvas &canvas)
+{
+  Flush(canvas.buffer);
+}
+
+void
+TileRasterizer::Flush(WritableImageBuffer<ActivePixelTraits> buffer)
+{
+  if (commands.empty())
+    return;
+
+  if (!workers_started)
+    StartWorkers();
+
+  /* without workers, a single tile covering the whole canvas draws
+     the polygons directly, without any overhead */
+  const unsigned n_threads = workers.size() + 1;
+  const unsigned n_tiles = workers.empty()
+    ? 1
+    : n_threads * TILES_PER_THREAD;
+
+  target = buffer;
+  if (target.height == 0) {
+    points.clear();
+    commands.clear();
+    return;
+  }
+
+  Bin(n_tiles);
+
+  next_tile.store(0, std::memory_order_relaxed);
+
+  const bool parallel = !workers.empty();
+  if (parallel) {
+    const ScopeLock lock(mutex);
+    busy = workers.size();
+    ++generation;
+    wake_cond.broadcast();
+  }
+
+  RunTiles();
+
+  if (parallel) {
+    const ScopeLock lock(mutex);
+    while (busy > 0)
+      done_cond.wait(mutex);
+  }
+
+  points.clear();
+  commands.clear();
+}
@@ -0,0 +1,186 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_MEMORY_TILE_RASTERIZER_HPP
+#define XCSOAR_SCREEN_MEMORY_TILE_RASTERIZER_HPP
+
+#include "Buffer.hpp"
+#include "ActivePixelTraits.hpp"
+#include "Screen/BulkPoint.hpp"
+#include "Screen/Color.hpp"
+#include "Thread/Mutex.hpp"
+#include "Thread/Cond.hxx"
+#include "Util/StaticArray.hxx"
+
+#include <vector>
+#include <atomic>
+
+class Canvas;
+
+/**
+ * A command buffer for the memory canvas.  Polygon fills are recorded
+ * instead of being drawn immediately; Flush() bins them into
+ * horizontal screen tiles and rasterises the tiles on several threads
+ * in parallel.  Within each tile, the polygons are drawn in the
+ * order they were recorded, so the result is the same as drawing
+ * them one after another.
+ *
+ * The caller must Flush() before drawing anything else on the
+ * #Canvas, or else the recorded commands will end up on top of it.
+ */
+class TileRasterizer {
+public:
+  /**
+   * The maximum number of worker threads in addition to the calling
+   * thread.
+   */
+  static constexpr unsigned MAX_WORKERS = 3;
+
+  /**
+   * The number of tiles per thread.  Each tile costs a polygon setup
+   * for every polygon touching it, so there should be few of them;
+   * more than one per thread balances the load when the polygons are
+   * not evenly distributed.
+   */
+  static constexpr unsigned TILES_PER_THREAD = 2;
+
+private:
+  struct Command {
+    Color color;
+
+    /**
+     * The range within #points.
+     */
+    unsigned first_point, n_points;
+
+    /**
+     * The vertical extent of the polygon.
+     */
+    int top, bottom;
+  };
+
+  class Worker;
+
+  std::vector<BulkPixelPoint> points;
+  std::vector<Command> commands;
+
+  /**
+   * For each tile, the indexes of all #commands which touch it.
+   * Tiles always span the whole width of the canvas, because the
+   * scanline rasteriser works on complete rows anyway.
+   */
+  std::vector<std::vector<unsigned>> tiles;
+
+  /**
+   * The height of each tile [pixels].
+   */
+  unsigned tile_height;
+
+  WritableImageBuffer<ActivePixelTraits> target;
+
+  /**
+   * The number of worker threads to be started by the first Flush().
+   */
+  const unsigned n_workers;
+
+  /**
+   * The next tile to be claimed by RunTiles().
+   */
+  std::atomic<unsigned> next_tile;
+
+  StaticArray<Worker *, MAX_WORKERS> workers;
+
+  /**
+   * Protects #generation, #busy and #quit.
+   */
+  Mutex mutex;
+  Cond wake_cond, done_cond;
+
+  /**
+   * Incremented by Flush() to wake up the workers.
+   */
+  unsigned generation = 0;
+
+  /**
+   * The number of workers which have not yet finished the current
+   * generation.
+   */
+  unsigned busy = 0;
+
+  bool quit = false;
+
+  bool workers_started = false;
+
+public:
+  /**
+   * Start one worker less than the number of CPUs (the calling
+   * thread rasterises tiles, too), but at most #MAX_WORKERS.
+   */
+  TileRasterizer();
+
+  /**
+   * Start the given number of workers, regardless of the number of
+   * CPUs.  Zero means Flush() draws everything as a single tile in
+   * the calling thread.
+   */
+  explicit TileRasterizer(unsigned _n_workers);
+
+  ~TileRasterizer();
+
+  TileRasterizer(const TileRasterizer &) = delete;
+  TileRasterizer &operator=(const TileRasterizer &) = delete;
+
+  bool IsEmpty() const {
+    return commands.empty();
+  }
+
+  void AddPolygon(const BulkPixelPoint *_points, unsigned n, Color color);
+
+  /**
+   * Rasterise all recorded commands onto the given canvas and clear
+   * the command buffer.
+   */
+  void Flush(Canvas &canvas);
+
+  /**
+   * Rasterise all recorded commands onto the given buffer and clear
+   * the command buffer.
+   */
+  void Flush(WritableImageBuffer<ActivePixelTraits> buffer);
+
+private:
+  void StartWorkers();
+  void StopWorkers();
+
+  void Bin(unsigned n_tiles);
+
+  /**
+   * Claim tiles and rasterise them until there are none left.  This
+   * is called by the workers and by Flush() itself.
+   */
+  void RunTiles();
+
+  void RunTile(unsigned tile, std::vector<BulkPixelPoint> &scratch);
+};
+
+#endif
@@ -24,47 +24,42 @@ Copyright_License {
 #ifndef XCSOAR_SCREEN_STOP_WATCH_HPP
 #define XCSOAR_SCREEN_STOP_WATCH_HPP
 
-#ifdef STOP_WATCH
-
+#include "FrameProfiler.hpp"
+#include "OS/Clock.hpp"
 #include "Util/StaticArray.hxx"
-#include "LogFile.hpp"
 
 #ifdef HAVE_POSIX
 #include <time.h>
-#include <stdint.h>
 #else /* !HAVE_POSIX */
 #include <windows.h>
 #endif /* !HAVE_POSIX */
 
-#endif /* STOP_WATCH */
+#include <stdint.h>
 
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/System.hpp"
 #endif
 
 /**
- * A stop watch which measures the time needed to perform an
- * operation, and writes it to the log file.  It is a no-op if the
- * macro STOP_WATCH is not defined.
+ * A stop watch which measures the time needed to perform each step
+ * of an operation (e.g. the layers of a map frame), and submits it
+ * to the #FrameProfiler.  It is a cheap no-op while the profiler is
+ * disabled.
  */
 class ScreenStopWatch {
-#ifdef STOP_WATCH
-  typedef uint64_t clock_stamp_t;
-  typedef uint64_t cpu_stamp_t;
-
   struct Marker {
     const char *text;
-    clock_stamp_t clock;
-    cpu_stamp_t cpu;
+    uint64_t clock;
+    uint64_t cpu;
 
     void Set(const char *_text) {
       text = _text;
-      clock = GetCurrentClock();
+      clock = MonotonicClockUS();
       cpu = GetCurrentCPU();
     }
   };
 
-  typedef StaticArray<Marker, 256u> MarkerList;
+  typedef StaticArray<Marker, FrameProfiler::MAX_LAYERS> MarkerList;
   MarkerList markers;
 
 private:
@@ -74,42 +69,25 @@ private:
 #endif
   }
 
-  static clock_stamp_t GetCurrentClock() {
+  /**
+   * Returns the CPU time consumed by the current thread [us].
+   */
+  static uint64_t GetCurrentCPU() {
 #ifdef HAVE_POSIX
+#ifdef CLOCK_THREAD_CPUTIME_ID
     struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
-#else /* !HAVE_POSIX */
-    LARGE_INTEGER l_value, l_frequency;
-
-    if (!::QueryPerformanceCounter(&l_value) ||
-        !::QueryPerformanceFrequency(&l_frequency))
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) < 0)
       return 0;
 
-    uint64_t value = l_value.QuadPart;
-    uint64_t frequency = l_frequency.QuadPart;
-
-    if (frequency > 1000000) {
-      value *= 10000;
-      value /= frequency / 100;
-    } else if (frequency < 1000000) {
-      value *= 10000;
-      value /= frequency;
-      value *= 100;
-    }
-
-    return value;
-#endif /* !HAVE_POSIX */
-  }
-
-  static cpu_stamp_t GetCurrentCPU() {
-#ifdef HAVE_POSIX
-    // XXX
+    return uint64_t(ts.tv_sec) * 1000000 + uint64_t(ts.tv_nsec) / 1000;
+#else
     return 0;
+#endif
 #else /* !HAVE_POSIX */
-    FILETIME f_kernel_time, f_user_time;
+    FILETIME f_creation_time, f_exit_time, f_kernel_time, f_user_time;
 
-    if (!::GetThreadTimes(::GetCurrentThread(), nullptr, nullptr,
+    if (!::GetThreadTimes(::GetCurrentThread(),
+                          &f_creation_time, &f_exit_time,
                           &f_kernel_time, &f_user_time))
       return 0;
 
@@ -123,41 +101,58 @@ private:
   }
 
 public:
+  /**
+   * Begin a new step.  The previous step (if any) ends here.
+   */
   void Mark(const char *text) {
+    if (!FrameProfiler::IsEnabled() || markers.full())
+      return;
+
     FlushScreen();
     markers.append().Set(text);
   }
 
+  /**
+   * End the last step and submit all steps of this operation to the
+   * #FrameProfiler, followed by a "total" step covering all of them.
+   */
   void Finish() {
     if (markers.empty())
       return;
 
+    if (!FrameProfiler::IsEnabled()) {
+      markers.clear();
+      return;
+    }
+
     FlushScreen();
-    markers.append().Set(nullptr);
 
-    for (unsigned i = 0; markers[i + 1].text != nullptr; ++i) {
+    Marker end;
+    end.Set(nullptr);
+
+    StaticArray<FrameProfiler::Sample, FrameProfiler::MAX_LAYERS + 1> samples;
+    for (unsigned i = 0; i < markers.size(); ++i) {
       const Marker &start = markers[i];
-      const Marker &end = markers[i + 1];
+      const Marker &next = i + 1 < markers.size() ? markers[i + 1] : end;
 
-      LogFormat("StopWatch '%s': clock=%lu cpu=%lu", start.text,
-                (unsigned long)(end.clock - start.clock),
-                (unsigned long)(end.cpu - start.cpu));
+      auto &sample = samples.append();
+      sample.name = start.text;
+      sample.start_us = start.clock;
+      sample.wall_us = uint32_t(next.clock - start.clock);
+      sample.cpu_us = uint32_t(next.cpu - start.cpu);
     }
 
     const Marker &start = markers.front();
-    const Marker &end = markers.back();
-    LogFormat("StopWatch total: clock=%lu cpu=%lu",
-              (unsigned long)(end.clock - start.clock),
-              (unsigned long)(end.cpu - start.cpu));
+    auto &total = samples.append();
+    total.name = "total";
+    total.start_us = start.clock;
+    total.wall_us = uint32_t(end.clock - start.clock);
+    total.cpu_us = uint32_t(end.cpu - start.cpu);
+
+    FrameProfiler::SubmitFrame(&samples.front(), samples.size());
 
     markers.clear();
   }
-
-#else /* !STOP_WATCH */
-public:
-  void Mark(const char *text) {}
-  void Finish() {}
-#endif /* !STOP_WATCH */
 };
 
 #endif
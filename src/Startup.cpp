@@ -65,6 +65,8 @@ Copyright_License {
 #include "Monitor/AllMonitors.hpp"
 #include "MergeThread.hpp"
 #include "CalculationThread.hpp"
+#include "PipelineLatency.hpp"
+#include "FrameProfiler.hpp"
 #include "Replay/Replay.hpp"
 #include "LocalPath.hpp"
 #include "IO/FileCache.hpp"
@@ -356,8 +358,8 @@ Startup()
   rasp->ScanAll();
 
   // Reads the airspace files
-  ReadAirspace(airspace_database, terrain, computer_settings.pressure,
-               operation);
+  ReadAirspace(airspace_database, file_cache, terrain,
+               computer_settings.pressure, operation);
 
   {
     const AircraftState aircraft_state =
@@ -439,6 +441,7 @@ Startup()
   if (!is_simulator() && computer_settings.logger.enable_flight_logger) {
     flight_logger = new GlueFlightLogger(live_blackboard);
     flight_logger->SetPath(LocalPath(_T("flights.log")));
+    flight_logger->SetIndexPath(LocalPath(_T("flights.idx")));
   }
 
   if (computer_settings.logger.enable_nmea_logger)
@@ -573,6 +576,10 @@ Shutdown()
   }
 #endif
 
+  PipelineLatency::Log();
+  if (FrameProfiler::IsEnabled())
+    FrameProfiler::Log();
+
   LogFormat("delete MapWindow");
   main_window->Deinitialise();
 
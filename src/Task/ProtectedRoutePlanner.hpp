@@ -59,6 +59,11 @@ public:
     lease->ClearReach();
   }
 
+  void SetArrivalRaster(const ArrivalRaster &arrival_raster) {
+    ExclusiveLease lease(*this);
+    lease->SetArrivalRaster(arrival_raster);
+  }
+
   gcc_pure
   bool IsTerrainReachEmpty() const {
     Lease lease(*this);
@@ -24,6 +24,7 @@
 #define ROUTE_PLANNER_GLUE_HPP
 
 #include "Route/AirspaceRoute.hpp"
+#include "Route/ArrivalRaster.hpp"
 
 struct GlideSettings;
 class RasterTerrain;
@@ -33,6 +34,12 @@ class RoutePlannerGlue {
   const RasterTerrain *terrain;
   AirspaceRoute planner;
 
+  /**
+   * The most recent complete arrival height raster, published by
+   * #RouteComputer.
+   */
+  ArrivalRaster arrival_raster;
+
 public:
   RoutePlannerGlue():terrain(nullptr) {}
 
@@ -59,10 +66,12 @@ public:
 
   void ClearReach() {
     planner.ClearReach();
+    arrival_raster.Clear();
   }
 
   void Reset() {
     planner.Reset();
+    arrival_raster.Clear();
   }
 
   bool Solve(const AGeoPoint &origin, const AGeoPoint &destination,
@@ -82,6 +91,18 @@ public:
     return planner.GetTerrainReachProjection();
   }
 
+  GeoBounds GetTerrainReachBounds() const {
+    return planner.GetTerrainReachBounds();
+  }
+
+  const ArrivalRaster &GetArrivalRaster() const {
+    return arrival_raster;
+  }
+
+  void SetArrivalRaster(const ArrivalRaster &_arrival_raster) {
+    arrival_raster = _arrival_raster;
+  }
+
   void AcceptInRange(const GeoBounds &bounds,
                      FlatTriangleFanVisitor &visitor,
                      bool working) const {
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Terrain/RasterRenderer.hpp"
 #include "Terrain/RasterMap.hpp"
+#include "Terrain/SlopeShading.hpp"
 #include "Math/FastMath.hpp"
 #include "Util/Clamp.hpp"
 #include "Screen/Ramp.hpp"
@@ -113,6 +114,7 @@ RasterRenderer::~RasterRenderer()
   delete[] color_table;
   delete image;
   delete[] contour_column_base;
+  delete[] slope_row;
 }
 
 #ifdef ENABLE_OPENGL
@@ -137,7 +139,7 @@ bool
 RasterRenderer::UpdateQuantisation()
 {
   quantisation_pixels = GetQuantisation();
-  return quantisation_pixels < last_quantisation_pixels;
+  return GetCoarsePixels() < last_quantisation_pixels;
 }
 
 const GLTexture &
@@ -154,11 +156,12 @@ RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection
   // Coordinates of the MapWindow center
   unsigned x = projection.GetScreenWidth() / 2;
   unsigned y = projection.GetScreenHeight() / 2;
+  const unsigned coarse_pixels = GetCoarsePixels();
   // GeoPoint corresponding to the MapWindow center
   GeoPoint center = projection.ScreenToGeo(x, y);
   // GeoPoint "next to" Gmid (depends on terrain resolution)
-  GeoPoint neighbor = projection.ScreenToGeo(x + quantisation_pixels,
-                                             y + quantisation_pixels);
+  GeoPoint neighbor = projection.ScreenToGeo(x + coarse_pixels,
+                                             y + coarse_pixels);
 
   // Geographical edge length of pixel in the MapWindow center in meters
   pixel_size = M_SQRT1_2 * center.DistanceS(neighbor);
@@ -190,13 +193,13 @@ RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection
   bounds.IntersectWith(map.GetBounds());
 
   height_matrix.Fill(map, bounds,
-                     projection.GetScreenWidth() / quantisation_pixels,
-                     projection.GetScreenHeight() / quantisation_pixels,
+                     projection.GetScreenWidth() / coarse_pixels,
+                     projection.GetScreenHeight() / coarse_pixels,
                      true);
 
-  last_quantisation_pixels = quantisation_pixels;
+  last_quantisation_pixels = coarse_pixels;
 #else
-  height_matrix.Fill(map, projection, quantisation_pixels, true);
+  height_matrix.Fill(map, projection, coarse_pixels, true);
 #endif
 }
 
@@ -215,6 +218,9 @@ RasterRenderer::GenerateImage(bool do_shading,
 
     delete[] contour_column_base;
     contour_column_base = new unsigned char[height_matrix.GetWidth()];
+
+    delete[] slope_row;
+    slope_row = new int8_t[height_matrix.GetWidth()];
   }
 
   if (quantisation_effective == 0) {
@@ -280,26 +286,6 @@ RasterRenderer::GenerateUnshadedImage(unsigned height_scale,
   }
 }
 
-/**
- * Clip the difference between two adjacent terrain height values to
- * sane bounds.  This works around integer overflows in the
- * GenerateSlopeImage() formula when the map file is broken, avoiding
- * the sqrt() call with a negative argument.
- */
-gcc_const
-static int
-ClipHeightDelta(int d)
-{
-  return Clamp(d, -512, 512);
-}
-
-gcc_const
-static int
-ClipHeightDelta(TerrainHeight a, TerrainHeight b)
-{
-  return ClipHeightDelta(a.GetValue() - b.GetValue());
-}
-
 // JMW: if zoomed right in (e.g. one unit is larger than terrain
 // grid), then increase the step size to be equal to the terrain
 // grid for purposes of calculating slope, to avoid shading problems
@@ -326,6 +312,16 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
              square will not overflow */
           8192u / (quantisation_effective * quantisation_effective));
 
+  const SlopeShadingParameters params{sx, sy, sz, contrast};
+
+  /* the pixels which are at least quantisation_effective away from
+     the left and right edge are calculated row by row with the
+     (vectorised) CalculateSlopeRow() */
+  const unsigned interior_width =
+    height_matrix.GetWidth() > 2 * quantisation_effective
+    ? height_matrix.GetWidth() - 2 * quantisation_effective
+    : 0;
+
   const auto *src = height_matrix.GetData();
   const RawColor *oColorBuf = color_table + 64 * 256;
 
@@ -343,6 +339,15 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
     const unsigned p31 = row_plus_index + row_minus_index;
 
+    if (interior_width > 0)
+      CalculateSlopeRow(slope_row + quantisation_effective,
+                        src + quantisation_effective, interior_width,
+                        quantisation_effective,
+                        row_minus_offset, row_plus_offset,
+                        p31,
+                        2 * quantisation_effective * p31 * height_slope_factor,
+                        params);
+
     RawColor *p = dest;
     dest = image->GetNextRow(dest);
 
@@ -404,25 +409,22 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
           continue;
         }
 
-        const int p32 = ClipHeightDelta(h_above, h_below);
-        const int p22 = ClipHeightDelta(h_right, h_left);
-
-        const unsigned p20 = column_plus_index + column_minus_index;
-
-        const int dd0 = p22 * int(p31);
-        const int dd1 = int(p20) * p32;
-        const unsigned dd2 = p20 * p31 * height_slope_factor;
-        const int num = (int(dd2) * sz + dd0 * sx + dd1 * sy);
-        const unsigned square_mag = dd0 * dd0 + dd1 * dd1 + dd2 * dd2;
-        const unsigned mag = (unsigned)sqrt(square_mag);
-        /* this is a workaround for a SIGFPE (division by zero)
-           observed by our users on some Android devices (e.g. Nexus
-           7), even though we did our best to make sure that the
-           integer arithmetics above can't overflow */
-        /* TODO: debug this problem and replace this workaround */
-        const int sval = num / int(mag|1);
-        const int sindex = (sval - sz) * contrast / 128;
-        *p++ = oColorBuf[int(h) + 256 * Clamp(sindex, -63, 63)];
+        int sindex;
+        if (x >= quantisation_effective && x < (unsigned)border.right) {
+          sindex = slope_row[x];
+        } else {
+          const int p32 = ClipHeightDelta(h_above, h_below);
+          const int p22 = ClipHeightDelta(h_right, h_left);
+
+          const unsigned p20 = column_plus_index + column_minus_index;
+
+          const int dd0 = p22 * int(p31);
+          const int dd1 = int(p20) * p32;
+          const unsigned dd2 = p20 * p31 * height_slope_factor;
+          sindex = CalculateSlopeIndex(dd0, dd1, dd2, params);
+        }
+
+        *p++ = oColorBuf[int(h) + 256 * sindex];
       } else if (e.IsWater()) {
         // we're in the water, so look up the color for water
         *p++ = oColorBuf[255];
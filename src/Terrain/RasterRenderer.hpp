@@ -30,6 +30,8 @@ Copyright_License {
 #include "Geo/GeoBounds.hpp"
 #endif
 
+#include <stdint.h>
+
 #define NUM_COLOR_RAMP_LEVELS 13
 
 class Angle;
@@ -48,9 +50,15 @@ class RasterRenderer {
   /** screen dimensions in coarse pixels */
   unsigned quantisation_pixels = 2;
 
+  /**
+   * The #quantisation_pixels value is shifted left by this number of
+   * bits to reduce the rendering cost, see SetQualityShift().
+   */
+  unsigned quality_shift = 0;
+
 #ifdef ENABLE_OPENGL
   /**
-   * The value of #quantisation_pixels that was used in the last
+   * The value of GetCoarsePixels() that was used in the last
    * ScanMap() call.
    */
   unsigned last_quantisation_pixels = -1;
@@ -76,6 +84,12 @@ class RasterRenderer {
 
   unsigned char *contour_column_base = nullptr;
 
+  /**
+   * Scratch buffer for the illumination index of one row, see
+   * GenerateSlopeImage().
+   */
+  int8_t *slope_row = nullptr;
+
   double pixel_size;
 
   RawColor *color_table = nullptr;
@@ -99,6 +113,18 @@ public:
     return height_matrix.GetHeight();
   }
 
+  unsigned GetQualityShift() const {
+    return quality_shift;
+  }
+
+  /**
+   * Reduce the resolution by the factor 2^shift, to keep the frame
+   * rate up on slow devices.  0 means full resolution.
+   */
+  void SetQualityShift(unsigned _shift) {
+    quality_shift = _shift;
+  }
+
 #ifdef ENABLE_OPENGL
   void Invalidate() {
     bounds.SetInvalid();
@@ -151,6 +177,10 @@ protected:
   /**
    * Convert the height matrix into the image, without shading.
    */
+  unsigned GetCoarsePixels() const {
+    return quantisation_pixels << quality_shift;
+  }
+
   void GenerateUnshadedImage(unsigned height_scale,
                              const unsigned contour_height_scale);
 
@@ -0,0 +1,77 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "SlopeShading.hpp"
+
+#ifdef __ARM_NEON__
+#include "SlopeShadingNEON.hpp"
+#elif defined(__SSE2__)
+#include "SlopeShadingSSE2.hpp"
+#endif
+
+void
+CalculateSlopeRowScalar(int8_t *gcc_restrict dest,
+                        const TerrainHeight *gcc_restrict src, unsigned n,
+                        unsigned column_distance,
+                        unsigned row_minus_offset, unsigned row_plus_offset,
+                        unsigned p31, unsigned dd2,
+                        const SlopeShadingParameters &p)
+{
+  const unsigned p20 = 2 * column_distance;
+
+  for (unsigned i = 0; i < n; ++i, ++src) {
+    const int p32 = ClipHeightDelta(src[-(int)row_minus_offset],
+                                    src[row_plus_offset]);
+    const int p22 = ClipHeightDelta(src[column_distance],
+                                    src[-(int)column_distance]);
+
+    const int dd0 = p22 * int(p31);
+    const int dd1 = int(p20) * p32;
+    dest[i] = CalculateSlopeIndex(dd0, dd1, dd2, p);
+  }
+}
+
+void
+CalculateSlopeRow(int8_t *gcc_restrict dest,
+                  const TerrainHeight *gcc_restrict src, unsigned n,
+                  unsigned column_distance,
+                  unsigned row_minus_offset, unsigned row_plus_offset,
+                  unsigned p31, unsigned dd2,
+                  const SlopeShadingParameters &p)
+{
+#if defined(__ARM_NEON__) || defined(__SSE2__)
+#ifdef __ARM_NEON__
+  const NEONSlopeShading kernel(column_distance, p31, dd2, p);
+#else
+  const SSE2SlopeShading kernel(column_distance, p31, dd2, p);
+#endif
+
+  for (; n >= 8; n -= 8, dest += 8, src += 8)
+    kernel.Calculate8(dest, src, column_distance,
+                      row_minus_offset, row_plus_offset);
+#endif
+
+  CalculateSlopeRowScalar(dest, src, n, column_distance,
+                          row_minus_offset, row_plus_offset,
+                          p31, dd2, p);
+}
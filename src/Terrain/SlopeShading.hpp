@@ -0,0 +1,123 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_SLOPE_SHADING_HPP
+#define XCSOAR_TERRAIN_SLOPE_SHADING_HPP
+
+#include "Terrain/Height.hpp"
+#include "Util/Clamp.hpp"
+#include "Compiler.h"
+
+#include <math.h>
+#include <stdint.h>
+
+/**
+ * The light source and contrast used for slope shading.
+ */
+struct SlopeShadingParameters {
+  /**
+   * The sun vector, scaled to 255.
+   */
+  int sx, sy, sz;
+
+  int contrast;
+};
+
+/**
+ * Clip the difference between two adjacent terrain height values to
+ * sane bounds.  This works around integer overflows in the
+ * CalculateSlopeIndex() formula when the map file is broken, avoiding
+ * the sqrt() call with a negative argument.
+ */
+gcc_const
+static inline int
+ClipHeightDelta(int d)
+{
+  return Clamp(d, -512, 512);
+}
+
+gcc_const
+static inline int
+ClipHeightDelta(TerrainHeight a, TerrainHeight b)
+{
+  return ClipHeightDelta(a.GetValue() - b.GetValue());
+}
+
+/**
+ * Calculate the illumination index (-63..63) of one pixel from the
+ * (scaled) surface normal.
+ */
+gcc_pure
+static inline int
+CalculateSlopeIndex(int dd0, int dd1, unsigned dd2,
+                    const SlopeShadingParameters &p)
+{
+  const int num = (int(dd2) * p.sz + dd0 * p.sx + dd1 * p.sy);
+  const unsigned square_mag = dd0 * dd0 + dd1 * dd1 + dd2 * dd2;
+  const unsigned mag = (unsigned)sqrt(square_mag);
+  /* this is a workaround for a SIGFPE (division by zero)
+     observed by our users on some Android devices (e.g. Nexus
+     7), even though we did our best to make sure that the
+     integer arithmetics above can't overflow */
+  /* TODO: debug this problem and replace this workaround */
+  const int sval = num / int(mag|1);
+  const int sindex = (sval - p.sz) * p.contrast / 128;
+  return Clamp(sindex, -63, 63);
+}
+
+/**
+ * Calculate the illumination index of a row of pixels which are at
+ * least #column_distance away from the left and right edge of the
+ * height matrix.  The neighbours of src[i] are
+ * src[i-column_distance], src[i+column_distance],
+ * src[i-row_minus_offset] and src[i+row_plus_offset].
+ *
+ * The result for pixels with a "special" neighbour is undefined; the
+ * caller is expected to check for those.
+ *
+ * This uses SSE2 or NEON if available.  The result is identical to
+ * CalculateSlopeRowScalar().
+ *
+ * @param p31 the vertical distance between the two neighbours
+ * @param dd2 the vertical component of the surface normal
+ */
+void
+CalculateSlopeRow(int8_t *gcc_restrict dest,
+                  const TerrainHeight *gcc_restrict src, unsigned n,
+                  unsigned column_distance,
+                  unsigned row_minus_offset, unsigned row_plus_offset,
+                  unsigned p31, unsigned dd2,
+                  const SlopeShadingParameters &p);
+
+/**
+ * The portable implementation of CalculateSlopeRow().
+ */
+void
+CalculateSlopeRowScalar(int8_t *gcc_restrict dest,
+                        const TerrainHeight *gcc_restrict src, unsigned n,
+                        unsigned column_distance,
+                        unsigned row_minus_offset, unsigned row_plus_offset,
+                        unsigned p31, unsigned dd2,
+                        const SlopeShadingParameters &p);
+
+#endif
@@ -0,0 +1,164 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_SLOPE_SHADING_NEON_HPP
+#define XCSOAR_TERRAIN_SLOPE_SHADING_NEON_HPP
+
+#include "SlopeShading.hpp"
+
+#ifndef __ARM_NEON__
+#error ARM NEON required
+#endif
+
+#include <arm_neon.h>
+
+/**
+ * Implementation of CalculateSlopeRow() using ARM NEON instructions,
+ * eight pixels at a time.
+ *
+ * The surface normal is calculated with 32 bit integers, just like
+ * CalculateSlopeIndex().  ARMv7 NEON has neither a square root nor a
+ * division instruction; both are estimated in single precision with
+ * the reciprocal estimates and two Newton-Raphson steps, and then
+ * corrected by one step with exact integer arithmetic.  Therefore,
+ * the result is identical to CalculateSlopeIndex().
+ */
+class NEONSlopeShading {
+  int32x4_t p31, p20;
+  uint32x4_t dd2_square;
+  int32x4_t sx, sy, num2;
+  int32x4_t sz;
+  float32x4_t contrast;
+
+public:
+  NEONSlopeShading(unsigned column_distance, unsigned _p31, unsigned _dd2,
+                   const SlopeShadingParameters &p)
+    :p31(vdupq_n_s32(_p31)),
+     p20(vdupq_n_s32(2 * column_distance)),
+     dd2_square(vdupq_n_u32(_dd2 * _dd2)),
+     sx(vdupq_n_s32(p.sx)), sy(vdupq_n_s32(p.sy)),
+     num2(vdupq_n_s32(int(_dd2) * p.sz)),
+     sz(vdupq_n_s32(p.sz)),
+     contrast(vdupq_n_f32(p.contrast / 128.f)) {}
+
+private:
+  gcc_always_inline
+  static int16x8_t ClipHeightDelta(int16x8_t a, int16x8_t b) {
+    /* saturating subtraction, because the clamp below would clip the
+       overflowed values anyway */
+    int16x8_t d = vqsubq_s16(a, b);
+    d = vminq_s16(d, vdupq_n_s16(512));
+    return vmaxq_s16(d, vdupq_n_s16(-512));
+  }
+
+  /**
+   * Integer square root, like (unsigned)sqrt(x).
+   */
+  gcc_always_inline
+  static uint32x4_t Sqrt(uint32x4_t x) {
+    const float32x4_t f = vcvtq_f32_u32(x);
+    float32x4_t r = vrsqrteq_f32(f);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(f, r), r));
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(f, r), r));
+    uint32x4_t m = vcvtq_u32_f32(vmulq_f32(f, r));
+
+    const uint32x4_t one = vdupq_n_u32(1);
+    const uint32x4_t m1 = vaddq_u32(m, one);
+    m = vbslq_u32(vcleq_u32(vmulq_u32(m1, m1), x), m1, m);
+    return vsubq_u32(m, vandq_u32(vcgtq_u32(vmulq_u32(m, m), x), one));
+  }
+
+  /**
+   * Integer division with truncation towards zero, like the C
+   * operator.
+   */
+  gcc_always_inline
+  static int32x4_t Divide(int32x4_t num, uint32x4_t mag) {
+    const float32x4_t f = vcvtq_f32_u32(mag);
+    float32x4_t r = vrecpeq_f32(f);
+    r = vmulq_f32(r, vrecpsq_f32(f, r));
+    r = vmulq_f32(r, vrecpsq_f32(f, r));
+
+    const uint32x4_t abs_num = vreinterpretq_u32_s32(vabsq_s32(num));
+    uint32x4_t q = vcvtq_u32_f32(vmulq_f32(vcvtq_f32_u32(abs_num), r));
+
+    const uint32x4_t one = vdupq_n_u32(1);
+    const uint32x4_t q1 = vaddq_u32(q, one);
+    q = vbslq_u32(vcleq_u32(vmulq_u32(q1, mag), abs_num), q1, q);
+    q = vsubq_u32(q, vandq_u32(vcgtq_u32(vmulq_u32(q, mag), abs_num), one));
+
+    /* copy the sign of num */
+    const int32x4_t sign = vshrq_n_s32(num, 31);
+    return vsubq_s32(veorq_s32(vreinterpretq_s32_u32(q), sign), sign);
+  }
+
+  gcc_always_inline
+  int32x4_t Calculate4(int16x4_t p22, int16x4_t p32) const {
+    const int32x4_t dd0 = vmulq_s32(vmovl_s16(p22), p31);
+    const int32x4_t dd1 = vmulq_s32(p20, vmovl_s16(p32));
+
+    const int32x4_t num = vmlaq_s32(vmlaq_s32(num2, dd0, sx), dd1, sy);
+
+    const uint32x4_t u0 = vreinterpretq_u32_s32(dd0);
+    const uint32x4_t u1 = vreinterpretq_u32_s32(dd1);
+    const uint32x4_t square_mag =
+      vmlaq_u32(vmlaq_u32(dd2_square, u0, u0), u1, u1);
+
+    /* (unsigned)sqrt(square_mag) | 1 */
+    const uint32x4_t mag = vorrq_u32(Sqrt(square_mag), vdupq_n_u32(1));
+
+    const int32x4_t sval = Divide(num, mag);
+
+    /* (sval - sz) * contrast / 128; the product is small enough to be
+       exact in single precision */
+    return vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(vsubq_s32(sval, sz)),
+                                   contrast));
+  }
+
+public:
+  gcc_always_inline
+  void Calculate8(int8_t *gcc_restrict dest,
+                  const TerrainHeight *gcc_restrict src,
+                  unsigned column_distance,
+                  unsigned row_minus_offset, unsigned row_plus_offset) const {
+    const int16_t *s = (const int16_t *)src;
+    const int16x8_t left = vld1q_s16(s - column_distance);
+    const int16x8_t right = vld1q_s16(s + column_distance);
+    const int16x8_t above = vld1q_s16(s - row_minus_offset);
+    const int16x8_t below = vld1q_s16(s + row_plus_offset);
+
+    const int16x8_t p22 = ClipHeightDelta(right, left);
+    const int16x8_t p32 = ClipHeightDelta(above, below);
+
+    const int32x4_t lo = Calculate4(vget_low_s16(p22), vget_low_s16(p32));
+    const int32x4_t hi = Calculate4(vget_high_s16(p22), vget_high_s16(p32));
+
+    int16x8_t sindex = vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi));
+    sindex = vminq_s16(sindex, vdupq_n_s16(63));
+    sindex = vmaxq_s16(sindex, vdupq_n_s16(-63));
+
+    vst1_s8(dest, vqmovn_s16(sindex));
+  }
+};
+
+#endif
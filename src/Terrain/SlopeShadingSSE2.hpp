@@ -0,0 +1,151 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_SLOPE_SHADING_SSE2_HPP
+#define XCSOAR_TERRAIN_SLOPE_SHADING_SSE2_HPP
+
+#include "SlopeShading.hpp"
+
+#ifndef __SSE2__
+#error SSE2 required
+#endif
+
+#include <emmintrin.h>
+
+/**
+ * Implementation of CalculateSlopeRow() using SSE2 instructions,
+ * eight pixels at a time.
+ *
+ * The formula is evaluated in double precision, two pixels per
+ * instruction.  All intermediate values are integers which double
+ * represents exactly, and sqrt() is correctly rounded, so the result
+ * is identical to CalculateSlopeIndex().
+ */
+class SSE2SlopeShading {
+  __m128d p31, p20, dd2_square;
+  __m128d sx, sy, num2;
+  __m128i sz;
+  __m128 contrast;
+
+public:
+  SSE2SlopeShading(unsigned column_distance, unsigned _p31, unsigned _dd2,
+                   const SlopeShadingParameters &p)
+    :p31(_mm_set1_pd(_p31)),
+     p20(_mm_set1_pd(2 * column_distance)),
+     dd2_square(_mm_set1_pd(double(_dd2) * double(_dd2))),
+     sx(_mm_set1_pd(p.sx)), sy(_mm_set1_pd(p.sy)),
+     num2(_mm_set1_pd(double(_dd2) * double(p.sz))),
+     sz(_mm_set1_epi32(p.sz)),
+     contrast(_mm_set1_ps(p.contrast / 128.f)) {}
+
+private:
+  gcc_always_inline
+  static __m128i ClipHeightDelta(__m128i a, __m128i b) {
+    /* saturating subtraction, because the clamp below would clip the
+       overflowed values anyway */
+    __m128i d = _mm_subs_epi16(a, b);
+    d = _mm_min_epi16(d, _mm_set1_epi16(512));
+    return _mm_max_epi16(d, _mm_set1_epi16(-512));
+  }
+
+  /**
+   * Sign-extend the lower/upper four 16 bit integers to 32 bit.
+   */
+  gcc_always_inline
+  static __m128i Lo(__m128i x) {
+    return _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+  }
+
+  gcc_always_inline
+  static __m128i Hi(__m128i x) {
+    return _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+  }
+
+  /**
+   * Calculate "sval" for the lower two 32 bit integers.
+   */
+  gcc_always_inline
+  __m128d Calculate2(__m128i _p22, __m128i _p32) const {
+    const __m128d dd0 = _mm_mul_pd(_mm_cvtepi32_pd(_p22), p31);
+    const __m128d dd1 = _mm_mul_pd(p20, _mm_cvtepi32_pd(_p32));
+
+    const __m128d num = _mm_add_pd(num2,
+                                   _mm_add_pd(_mm_mul_pd(dd0, sx),
+                                              _mm_mul_pd(dd1, sy)));
+    const __m128d square_mag = _mm_add_pd(dd2_square,
+                                          _mm_add_pd(_mm_mul_pd(dd0, dd0),
+                                                     _mm_mul_pd(dd1, dd1)));
+
+    /* (unsigned)sqrt(square_mag) | 1 */
+    const __m128i mag = _mm_or_si128(_mm_cvttpd_epi32(_mm_sqrt_pd(square_mag)),
+                                     _mm_set1_epi32(1));
+
+    /* num / mag; the quotient of two integers below 2^32 is never
+       close enough to the next integer to be rounded up */
+    return _mm_div_pd(num, _mm_cvtepi32_pd(mag));
+  }
+
+  gcc_always_inline
+  __m128i Calculate4(__m128i p22, __m128i p32) const {
+    const __m128i lo = _mm_cvttpd_epi32(Calculate2(p22, p32));
+    const __m128i hi =
+      _mm_cvttpd_epi32(Calculate2(_mm_unpackhi_epi64(p22, p22),
+                                  _mm_unpackhi_epi64(p32, p32)));
+    const __m128i sval = _mm_unpacklo_epi64(lo, hi);
+
+    /* (sval - sz) * contrast / 128; the product is small enough to be
+       exact in single precision */
+    return _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(sval, sz)),
+                                       contrast));
+  }
+
+public:
+  gcc_always_inline
+  void Calculate8(int8_t *gcc_restrict dest,
+                  const TerrainHeight *gcc_restrict src,
+                  unsigned column_distance,
+                  unsigned row_minus_offset, unsigned row_plus_offset) const {
+    const __m128i left =
+      _mm_loadu_si128((const __m128i *)(src - column_distance));
+    const __m128i right =
+      _mm_loadu_si128((const __m128i *)(src + column_distance));
+    const __m128i above =
+      _mm_loadu_si128((const __m128i *)(src - row_minus_offset));
+    const __m128i below =
+      _mm_loadu_si128((const __m128i *)(src + row_plus_offset));
+
+    const __m128i p22 = ClipHeightDelta(right, left);
+    const __m128i p32 = ClipHeightDelta(above, below);
+
+    const __m128i lo = Calculate4(Lo(p22), Lo(p32));
+    const __m128i hi = Calculate4(Hi(p22), Hi(p32));
+
+    __m128i sindex = _mm_packs_epi32(lo, hi);
+    sindex = _mm_min_epi16(sindex, _mm_set1_epi16(63));
+    sindex = _mm_max_epi16(sindex, _mm_set1_epi16(-63));
+
+    _mm_storel_epi64((__m128i *)dest, _mm_packs_epi16(sindex, sindex));
+  }
+};
+
+#endif
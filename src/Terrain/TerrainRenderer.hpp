@@ -82,6 +82,21 @@ public:
     settings = _settings;
   }
 
+  /**
+   * @see RasterRenderer::SetQualityShift()
+   */
+  void SetQualityShift(unsigned shift) {
+#ifndef ENABLE_OPENGL
+    if (shift < raster_renderer.GetQualityShift())
+      /* the resolution increases: redraw even if the projection
+         hasn't changed (the OpenGL implementation checks this in
+         RasterRenderer::UpdateQuantisation()) */
+      compare_projection.Clear();
+#endif
+
+    raster_renderer.SetQualityShift(shift);
+  }
+
   /**
    * @return true if an image has been renderered and Draw() may be
    * called
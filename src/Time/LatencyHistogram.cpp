@@ -0,0 +1,91 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+#include <string.h>
+
+void
+LatencyHistogram::Clear()
+{
+  head = size = 0;
+  std::fill_n(buckets, N_BUCKETS, 0u);
+}
+
+unsigned
+LatencyHistogram::FindBucket(uint32_t us)
+{
+  unsigned i = 0;
+  while (i < N_BUCKETS - 1 && us >= GetBucketLimit(i))
+    ++i;
+
+  return i;
+}
+
+void
+LatencyHistogram::Add(uint32_t us)
+{
+  if (size == WINDOW) {
+    /* evict the oldest sample, which is about to be overwritten */
+    unsigned &old = buckets[FindBucket(samples[head])];
+    assert(old > 0);
+    --old;
+  } else
+    ++size;
+
+  samples[head] = us;
+  head = (head + 1) % WINDOW;
+
+  ++buckets[FindBucket(us)];
+}
+
+LatencyHistogram::Summary
+LatencyHistogram::GetSummary() const
+{
+  Summary summary;
+  summary.n = size;
+
+  if (size == 0) {
+    summary.mean_us = summary.p50_us = summary.p95_us = summary.max_us = 0;
+    return summary;
+  }
+
+  /* the window is filled from index 0, so the first "size" elements
+     are valid, regardless of "head" */
+  uint32_t sorted[WINDOW];
+  memcpy(sorted, samples, size * sizeof(sorted[0]));
+  std::sort(sorted, sorted + size);
+
+  uint64_t sum = 0;
+  for (unsigned i = 0; i < size; ++i)
+    sum += sorted[i];
+
+  summary.mean_us = uint32_t(sum / size);
+  summary.p50_us = sorted[(size - 1) / 2];
+  summary.p95_us = sorted[(size - 1) * 95 / 100];
+  summary.max_us = sorted[size - 1];
+  return summary;
+}
@@ -0,0 +1,105 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LATENCY_HISTOGRAM_HPP
+#define XCSOAR_LATENCY_HISTOGRAM_HPP
+
+#include "Compiler.h"
+
+#include <stdint.h>
+
+/**
+ * Collects the most recent latency samples in a ring buffer and
+ * maintains a logarithmic histogram over them.  Old samples drop out
+ * of the histogram as new ones arrive, so it always describes the
+ * last #WINDOW samples.
+ *
+ * This class is not thread-safe.
+ */
+class LatencyHistogram {
+public:
+  static constexpr unsigned WINDOW = 256;
+
+  /**
+   * Bucket #i counts the samples below (#BUCKET0_US << i)
+   * microseconds, the last bucket collects everything above.
+   */
+  static constexpr unsigned N_BUCKETS = 12;
+  static constexpr uint32_t BUCKET0_US = 250;
+
+  struct Summary {
+    unsigned n;
+    uint32_t mean_us, p50_us, p95_us, max_us;
+  };
+
+private:
+  uint32_t samples[WINDOW];
+  unsigned head, size;
+
+  unsigned buckets[N_BUCKETS];
+
+public:
+  LatencyHistogram() {
+    Clear();
+  }
+
+  void Clear();
+
+  bool IsEmpty() const {
+    return size == 0;
+  }
+
+  unsigned GetSize() const {
+    return size;
+  }
+
+  void Add(uint32_t us);
+
+  unsigned GetBucket(unsigned i) const {
+    return buckets[i];
+  }
+
+  /**
+   * Returns the upper bound [us] of the specified bucket.  The last
+   * bucket has no upper bound; this returns UINT32_MAX.
+   */
+  gcc_const
+  static uint32_t GetBucketLimit(unsigned i) {
+    return i < N_BUCKETS - 1
+      ? BUCKET0_US << i
+      : UINT32_MAX;
+  }
+
+  gcc_const
+  static unsigned FindBucket(uint32_t us);
+
+  /**
+   * Calculate mean, median, 95th percentile and maximum of the
+   * samples currently in the window.  Returns all zeroes if the
+   * window is empty.
+   */
+  gcc_pure
+  Summary GetSummary() const;
+};
+
+#endif
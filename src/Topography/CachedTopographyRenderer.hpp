@@ -54,6 +54,21 @@ public:
 #endif
   }
 
+  unsigned GetDetailFactor() const {
+    return renderer.GetDetailFactor();
+  }
+
+  /**
+   * @see TopographyRenderer::SetDetailFactor()
+   */
+  void SetDetailFactor(unsigned factor) {
+    if (factor == renderer.GetDetailFactor())
+      return;
+
+    renderer.SetDetailFactor(factor);
+    Flush();
+  }
+
 #ifdef ENABLE_OPENGL
   void Draw(Canvas &canvas, const WindowProjection &projection) {
     renderer.Draw(canvas, projection);
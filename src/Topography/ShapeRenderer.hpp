@@ -30,6 +30,11 @@ Copyright_License {
 #include "Util/AllocatedArray.hxx"
 #include "Screen/Canvas.hpp"
 #include "Screen/Brush.hpp"
+#include "Compiler.h"
+
+#ifdef USE_MEMORY_CANVAS
+#include "Screen/Memory/TileRasterizer.hpp"
+#endif
 
 #include <assert.h>
 
@@ -43,6 +48,14 @@ class ShapeRenderer : private NonCopyable {
   const Pen *pen;
   const Brush *brush;
 
+#ifdef USE_MEMORY_CANVAS
+  /**
+   * If set, polygons are recorded here instead of being drawn
+   * directly.
+   */
+  TileRasterizer *tiles;
+#endif
+
   enum { NONE, OUTLINE, SOLID } mode;
 
 public:
@@ -51,9 +64,21 @@ public:
     brush = _brush;
     mode = NONE;
 
+#ifdef USE_MEMORY_CANVAS
+    tiles = nullptr;
+#endif
+
     num_points = 0;
   }
 
+#ifdef USE_MEMORY_CANVAS
+  void Configure(const Pen *_pen, const Brush *_brush,
+                 TileRasterizer &_tiles) {
+    Configure(_pen, _brush);
+    tiles = &_tiles;
+  }
+#endif
+
   void Begin(unsigned n) {
     assert(num_points == 0);
 
@@ -78,6 +103,10 @@ public:
   }
 
   void FinishPolyline(Canvas &canvas) {
+    /* lines are drawn directly, because clipping them to tiles
+       would move pixels at the tile seams */
+    Flush(canvas);
+
     if (mode != OUTLINE) {
       canvas.Select(*pen);
       mode = OUTLINE;
@@ -89,6 +118,15 @@ public:
   }
 
   void FinishPolygon(Canvas &canvas) {
+#ifdef USE_MEMORY_CANVAS
+    if (tiles != nullptr) {
+      if (!brush->IsHollow())
+        tiles->AddPolygon(points.begin(), num_points, brush->GetColor());
+      num_points = 0;
+      return;
+    }
+#endif
+
     if (mode != SOLID) {
       canvas.SelectNullPen();
       canvas.Select(*brush);
@@ -100,6 +138,17 @@ public:
     num_points = 0;
   }
 
+  /**
+   * Draw everything which has been recorded in the #TileRasterizer.
+   * Call this before drawing anything else on the #Canvas.
+   */
+  void Flush(gcc_unused Canvas &canvas) {
+#ifdef USE_MEMORY_CANVAS
+    if (tiles != nullptr)
+      tiles->Flush(canvas);
+#endif
+  }
+
   void Commit() {
     assert(num_points == 0);
   }
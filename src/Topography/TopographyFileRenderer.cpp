@@ -196,8 +196,14 @@ TopographyFileRenderer::PaintPoint(Canvas &canvas,
 #endif
 
 void
+#ifdef USE_MEMORY_CANVAS
+TopographyFileRenderer::Paint(Canvas &canvas,
+                              const WindowProjection &projection,
+                              TileRasterizer &tiles)
+#else
 TopographyFileRenderer::Paint(Canvas &canvas,
                               const WindowProjection &projection)
+#endif
 {
   const ScopeLock protect(file.mutex);
 
@@ -228,6 +234,8 @@ TopographyFileRenderer::Paint(Canvas &canvas,
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
   }
+#elif defined(USE_MEMORY_CANVAS)
+  shape_renderer.Configure(&pen, &brush, tiles);
 #else
   shape_renderer.Configure(&pen, &brush);
 #endif
@@ -300,6 +308,8 @@ TopographyFileRenderer::Paint(Canvas &canvas,
       glEnableVertexAttribArray(OpenGL::Attribute::POSITION);
 #endif
 #else // !ENABLE_OPENGL
+      /* icons are drawn directly; draw all recorded shapes first */
+      shape_renderer.Flush(canvas);
       PaintPoint(canvas, projection, lines.begin(), lines.end(), points);
 #endif
       break;
@@ -41,6 +41,7 @@ Copyright_License {
 class TopographyFile;
 class Canvas;
 class GLFallbackArrayBuffer;
+class TileRasterizer;
 class WindowProjection;
 class LabelBlock;
 class XShape;
@@ -89,13 +90,25 @@ public:
 
   ~TopographyFileRenderer();
 
+  const TopographyFile &GetFile() const {
+    return file;
+  }
+
   /**
    * Paints the polygons, lines and points/icons in the TopographyFile
    * @param canvas The canvas to paint on
    * @param bitmap_canvas Temporary canvas for the icon
    * @param projection
+   * @param tiles (memory canvas only) polygons are recorded here, and
+   * the caller must flush it; lines and icons flush it first and are
+   * then drawn directly
    */
+#ifdef USE_MEMORY_CANVAS
+  void Paint(Canvas &canvas, const WindowProjection &projection,
+             TileRasterizer &tiles);
+#else
   void Paint(Canvas &canvas, const WindowProjection &projection);
+#endif
 
   /**
    * Paints a topography label if the space is available in the LabelBlock
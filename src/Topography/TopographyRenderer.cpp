@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "Topography/TopographyRenderer.hpp"
 #include "Topography/TopographyFileRenderer.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Projection/WindowProjection.hpp"
 
 TopographyRenderer::TopographyRenderer(const TopographyStore &_store,
                                        const TopographyLook &look)
@@ -42,8 +44,19 @@ void
 TopographyRenderer::Draw(Canvas &canvas,
                          const WindowProjection &projection) const
 {
+  const double detail_scale = projection.GetMapScale() * detail_factor;
+
+#ifdef USE_MEMORY_CANVAS
+  for (auto it = files.begin(), end = files.end(); it != end; ++it)
+    if ((*it)->GetFile().IsVisible(detail_scale))
+      (*it)->Paint(canvas, projection, tiles);
+
+  tiles.Flush(canvas);
+#else
   for (auto it = files.begin(), end = files.end(); it != end; ++it)
-    (*it)->Paint(canvas, projection);
+    if ((*it)->GetFile().IsVisible(detail_scale))
+      (*it)->Paint(canvas, projection);
+#endif
 }
 
 void
@@ -27,6 +27,10 @@ Copyright_License {
 #include "Topography/TopographyStore.hpp"
 #include "Util/StaticArray.hxx"
 
+#ifdef USE_MEMORY_CANVAS
+#include "Screen/Memory/TileRasterizer.hpp"
+#endif
+
 class Canvas;
 class WindowProjection;
 class LabelBlock;
@@ -40,6 +44,21 @@ class TopographyRenderer : private NonCopyable {
   const TopographyStore &store;
   StaticArray<TopographyFileRenderer *, TopographyStore::MAXTOPOGRAPHY> files;
 
+#ifdef USE_MEMORY_CANVAS
+  /**
+   * Collects the polygons of all files, to rasterise them in
+   * parallel.  Lines are drawn directly.
+   */
+  mutable TileRasterizer tiles;
+#endif
+
+  /**
+   * Files which would be invisible at the map scale multiplied by
+   * this factor are skipped by Draw().  This is used to reduce the
+   * rendering cost on slow devices; 1 means full detail.
+   */
+  unsigned detail_factor = 1;
+
 public:
   TopographyRenderer(const TopographyStore &store, const TopographyLook &look);
 
@@ -51,6 +70,14 @@ public:
     return store;
   }
 
+  unsigned GetDetailFactor() const {
+    return detail_factor;
+  }
+
+  void SetDetailFactor(unsigned _factor) {
+    detail_factor = _factor;
+  }
+
   /**
    * Draws the topography to the given canvas
    * @param canvas The drawing canvas
@@ -26,6 +26,7 @@ Copyright_License {
 
 #include "Geo/GeoPoint.hpp"
 #include "Thread/Mutex.hpp"
+#include "Util/Serial.hpp"
 #include "Util/tstring.hpp"
 #include "Compiler.h"
 
@@ -102,6 +103,12 @@ struct Data {
 
   std::list<Thermal> thermals;
 
+  /**
+   * Incremented each time #traffic or #user_names is modified, to
+   * allow the UI thread to notice changes.
+   */
+  Serial serial;
+
   gcc_pure
   bool IsUserKnown(uint32_t id) const {
     return user_names.find(id) != user_names.end();
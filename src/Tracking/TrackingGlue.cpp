@@ -217,6 +217,7 @@ TrackingGlue::OnTraffic(uint32_t pilot_id, unsigned time_of_day_ms,
     const SkyLinesTracking::Data::Traffic traffic(time_of_day_ms,
                                                   location, altitude);
     skylines_data.traffic[pilot_id] = traffic;
+    ++skylines_data.serial;
 
     user_known = skylines_data.IsUserKnown(pilot_id);
   }
@@ -232,6 +233,7 @@ TrackingGlue::OnUserName(uint32_t user_id, const TCHAR *name)
 {
   const ScopeLock protect(skylines_data.mutex);
   skylines_data.user_names[user_id] = name;
+  ++skylines_data.serial;
 }
 
 void
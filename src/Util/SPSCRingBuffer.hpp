@@ -0,0 +1,119 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SPSC_RING_BUFFER_HPP
+#define XCSOAR_SPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cassert>
+
+/**
+ * A fixed-size lock-free ring buffer for passing items from exactly
+ * one producer thread to exactly one consumer thread.  It stores up
+ * to "size-1" items (for the full/empty distinction).
+ *
+ * The producer obtains a slot with Write(), fills it in place and
+ * publishes it with Append(); the consumer looks at the oldest item
+ * with Read() and releases it with Shift().  Neither side ever
+ * blocks.
+ */
+template<class T, unsigned size>
+class SPSCRingBuffer {
+  static_assert(size >= 2, "Buffer too small");
+
+  T data[size];
+
+  /**
+   * The next item to be read; only modified by the consumer.
+   */
+  std::atomic<unsigned> head;
+
+  /**
+   * The next slot to be written; only modified by the producer.
+   */
+  std::atomic<unsigned> tail;
+
+  static constexpr unsigned Next(unsigned i) {
+    return i + 1 < size ? i + 1 : 0;
+  }
+
+public:
+  SPSCRingBuffer():head(0), tail(0) {}
+
+  SPSCRingBuffer(const SPSCRingBuffer &) = delete;
+  SPSCRingBuffer &operator=(const SPSCRingBuffer &) = delete;
+
+  static constexpr unsigned capacity() {
+    return size - 1;
+  }
+
+  bool empty() const {
+    return head.load(std::memory_order_acquire) ==
+      tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Producer: return the next free slot, or nullptr if the buffer is
+   * full.  The slot becomes visible to the consumer only after
+   * Append().
+   */
+  T *Write() {
+    const unsigned t = tail.load(std::memory_order_relaxed);
+    if (Next(t) == head.load(std::memory_order_acquire))
+      return nullptr;
+
+    return &data[t];
+  }
+
+  /**
+   * Producer: publish the slot returned by Write().
+   */
+  void Append() {
+    const unsigned t = tail.load(std::memory_order_relaxed);
+    assert(Next(t) != head.load(std::memory_order_acquire));
+    tail.store(Next(t), std::memory_order_release);
+  }
+
+  /**
+   * Consumer: return the oldest item, or nullptr if the buffer is
+   * empty.
+   */
+  const T *Read() const {
+    const unsigned h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire))
+      return nullptr;
+
+    return &data[h];
+  }
+
+  /**
+   * Consumer: release the item returned by Read().
+   */
+  void Shift() {
+    const unsigned h = head.load(std::memory_order_relaxed);
+    assert(h != tail.load(std::memory_order_acquire));
+    head.store(Next(h), std::memory_order_release);
+  }
+};
+
+#endif
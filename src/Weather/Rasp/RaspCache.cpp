@@ -23,14 +23,11 @@ Copyright_License {
 
 #include "RaspCache.hpp"
 #include "RaspStore.hpp"
+#include "RaspThread.hpp"
 #include "Terrain/RasterMap.hpp"
-#include "Terrain/Loader.hpp"
 #include "Language/Language.hpp"
-#include "OS/Path.hpp"
-#include "IO/ZipArchive.hpp"
 
 #include <assert.h>
-#include <windef.h> // for MAX_PATH
 
 static inline constexpr unsigned
 ToHalfHours(BrokenTime t)
@@ -38,6 +35,9 @@ ToHalfHours(BrokenTime t)
   return t.hour * 2u + t.minute / 30;
 }
 
+RaspCache::RaspCache(RaspThread &_thread, unsigned _parameter)
+  :thread(_thread), store(_thread.GetStore()), parameter(_parameter) {}
+
 const TCHAR *
 RaspCache::GetMapName() const
 {
@@ -75,7 +75,7 @@ RaspCache::IsInside(GeoPoint p) const
 }
 
 void
-RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
+RaspCache::Reload(BrokenTime time_local)
 {
   unsigned effective_time = time;
   if (effective_time == 0) {
@@ -93,38 +93,23 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
     // no change, quick exit.
     return;
 
-  last_time = effective_time;
-
-  effective_time = store.GetNearestTime(parameter, effective_time);
-  if (effective_time == RaspStore::MAX_WEATHER_TIMES)
+  const unsigned nearest_time =
+    store.GetNearestTime(parameter, effective_time);
+  if (nearest_time == RaspStore::MAX_WEATHER_TIMES) {
+    last_time = effective_time;
     return;
+  }
 
-  Close();
-
-  auto archive = store.OpenArchive();
-  if (!archive)
+  std::shared_ptr<const RasterMap> new_map;
+  if (!thread.Lookup(parameter, nearest_time, new_map))
+    /* still being decoded; keep showing the previous map and try
+       again when the thread is done */
     return;
 
-  char new_name[MAX_PATH];
-  store.NarrowWeatherFilename(new_name, Path(store.GetItemInfo(parameter).name),
-                              effective_time);
+  last_time = effective_time;
 
-  RasterMap *new_map = new RasterMap();
-  if (!LoadTerrainOverview(archive->get(), new_name, nullptr,
-                           new_map->GetTileCache(),
-                           true, operation)) {
-    delete new_map;
-    return;
+  if (new_map != map) {
+    map = std::move(new_map);
+    ++serial;
   }
-
-  new_map->UpdateProjection();
-
-  map = new_map;
-}
-
-void
-RaspCache::Close()
-{
-  delete map;
-  map = nullptr;
 }
@@ -26,19 +26,24 @@ Copyright_License {
 
 #include "Compiler.h"
 
+#include <memory>
+
 #include <tchar.h>
 
 struct BrokenTime;
 struct GeoPoint;
 class RaspStore;
+class RaspThread;
 class RasterMap;
-class OperationEnvironment;
 
 /**
- * Class to manage the raster weather map, to be loaded/selected from
- * a #RaspStore instance.
+ * Class to manage the raster weather map, to be selected from a
+ * #RaspStore instance.  Maps are decoded by a #RaspThread; until the
+ * selected one becomes available, the previous one remains visible.
  */
 class RaspCache {
+  RaspThread &thread;
+
   const RaspStore &store;
 
   const unsigned parameter;
@@ -46,18 +51,19 @@ class RaspCache {
   unsigned time = 0;
   unsigned last_time = 0;
 
-  RasterMap *map = nullptr;
+  /**
+   * Incremented each time a different map is loaded.
+   */
+  unsigned serial = 0;
 
-public:
-  /** 
-   * Default constructor
+  /**
+   * The current map.  It is shared with the #RaspThread cache, which
+   * may evict it while it is still being displayed here.
    */
-  RaspCache(const RaspStore &_store, unsigned _parameter)
-    :store(_store), parameter(_parameter) {}
+  std::shared_ptr<const RasterMap> map;
 
-  ~RaspCache() {
-    Close();
-  }
+public:
+  RaspCache(RaspThread &_thread, unsigned _parameter);
 
   const RaspStore &GetStore() const {
     return store;
@@ -65,7 +71,15 @@ public:
 
   gcc_pure
   const RasterMap *GetMap() const {
-    return map;
+    return map.get();
+  }
+
+  /**
+   * Returns a number which changes each time a different map is
+   * loaded.
+   */
+  unsigned GetSerial() const {
+    return serial;
   }
 
   /**
@@ -93,9 +107,14 @@ public:
   bool IsInside(GeoPoint p) const;
 
   /**
-   * @param day_time the local time, in seconds since midnight
+   * Select the map for the current time index, or for the given
+   * local time if "now" is selected.  This does not block; if the map
+   * has not been decoded yet, this method needs to be called again
+   * after the #RaspThread has finished.
+   *
+   * @param time_local the current local time
    */
-  void Reload(BrokenTime time_local, OperationEnvironment &operation);
+  void Reload(BrokenTime time_local);
 
   /**
    * Returns the current time index.
@@ -107,9 +126,6 @@ public:
    * Sets the current time index.
    */
   void SetTime(BrokenTime t);
-
-private:
-  void Close();
 };
 
 #endif
@@ -46,8 +46,8 @@ class RaspRenderer {
   const ColorRamp *last_color_ramp = nullptr;
 
 public:
-  RaspRenderer(const RaspStore &_store, unsigned parameter)
-    :cache(_store, parameter) {}
+  RaspRenderer(RaspThread &thread, unsigned parameter)
+    :cache(thread, parameter) {}
 
   /**
    * Flush the cache.
@@ -64,6 +64,13 @@ public:
     return cache.GetParameter();
   }
 
+  /**
+   * @see RaspCache::GetSerial()
+   */
+  unsigned GetSerial() const {
+    return cache.GetSerial();
+  }
+
   /**
    * Returns the human-readable name for the current RASP map, or
    * nullptr if no RASP map is enabled.
@@ -82,8 +89,8 @@ public:
     cache.SetTime(t);
   }
 
-  void Update(BrokenTime time_local, OperationEnvironment &operation) {
-    cache.Reload(time_local, operation);
+  void Update(BrokenTime time_local) {
+    cache.Reload(time_local);
   }
 
   /**
@@ -0,0 +1,198 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RaspThread.hpp"
+#include "RaspStore.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/Operation.hpp"
+#include "IO/ZipArchive.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <windef.h> // for MAX_PATH
+
+constexpr unsigned RaspThread::MAX_CACHED;
+constexpr unsigned RaspThread::MAX_QUEUED;
+
+RaspThread::RaspThread(const RaspStore &_store,
+                       std::function<void()> &&_callback)
+  :StandbyThread("Rasp"), store(_store),
+   callback(std::move(_callback)) {}
+
+std::list<RaspThread::Item>::iterator
+RaspThread::FindCached(Key key)
+{
+  return std::find_if(cache.begin(), cache.end(),
+                      [key](const Item &item){
+                        return item.key == key;
+                      });
+}
+
+bool
+RaspThread::IsScheduled(Key key) const
+{
+  return std::find(queue.begin(), queue.end(), key) != queue.end();
+}
+
+bool
+RaspThread::Lookup(unsigned parameter, unsigned time,
+                   std::shared_ptr<const RasterMap> &map)
+{
+  assert(parameter < store.GetItemCount());
+  assert(time < RaspStore::MAX_WEATHER_TIMES);
+
+  const Key key{parameter, time};
+
+  const ScopeLock protect(mutex);
+
+  auto i = FindCached(key);
+  if (i != cache.end()) {
+    /* move to the front of the LRU list */
+    cache.splice(cache.begin(), cache, i);
+    map = i->map;
+    PrefetchNeighbours(key);
+    if (!queue.empty())
+      StandbyThread::Trigger();
+    return true;
+  }
+
+  /* decode this one before all prefetch requests */
+  auto q = std::find(queue.begin(), queue.end(), key);
+  if (q != queue.end())
+    queue.erase(q);
+  queue.push_front(key);
+  requested = key;
+
+  PrefetchNeighbours(key);
+  StandbyThread::Trigger();
+  return false;
+}
+
+void
+RaspThread::Prefetch(Key key)
+{
+  if (FindCached(key) != cache.end() || IsScheduled(key))
+    return;
+
+  queue.push_back(key);
+  if (queue.size() > MAX_QUEUED)
+    /* the oldest prefetch request follows the one for the
+       requested map */
+    queue.erase(std::next(queue.begin()));
+}
+
+void
+RaspThread::PrefetchNeighbours(Key key)
+{
+  if (key == last_prefetch)
+    return;
+
+  last_prefetch = key;
+
+  for (unsigned t = key.time + 1; t < RaspStore::MAX_WEATHER_TIMES; ++t) {
+    if (store.IsTimeAvailable(key.parameter, t)) {
+      Prefetch({key.parameter, t});
+      break;
+    }
+  }
+
+  for (unsigned t = key.time; t-- > 0;) {
+    if (store.IsTimeAvailable(key.parameter, t)) {
+      Prefetch({key.parameter, t});
+      break;
+    }
+  }
+
+  const unsigned n_parameters = store.GetItemCount();
+  for (unsigned p : {key.parameter + 1, key.parameter - 1}) {
+    if (p >= n_parameters)
+      continue;
+
+    unsigned t = store.GetNearestTime(p, key.time);
+    if (t < RaspStore::MAX_WEATHER_TIMES)
+      Prefetch({p, t});
+  }
+}
+
+std::shared_ptr<const RasterMap>
+RaspThread::Load(const RaspStore &store, Key key)
+try {
+  auto archive = store.OpenArchive();
+  if (!archive)
+    return nullptr;
+
+  char name[MAX_PATH];
+  if (!store.NarrowWeatherFilename(name,
+                                   Path(store.GetItemInfo(key.parameter).name),
+                                   key.time))
+    return nullptr;
+
+  auto map = std::make_shared<RasterMap>();
+  NullOperationEnvironment operation;
+  if (!LoadTerrainOverview(archive->get(), name, nullptr,
+                           map->GetTileCache(),
+                           true, operation))
+    return nullptr;
+
+  map->UpdateProjection();
+  return map;
+} catch (const std::runtime_error &e) {
+  LogError("Failed to load RASP map", e);
+  return nullptr;
+}
+
+void
+RaspThread::Tick()
+{
+  SetLowPriority(); // TODO: call only once
+
+  while (!queue.empty() && !IsStopped()) {
+    const Key key = queue.front();
+    queue.pop_front();
+
+    if (FindCached(key) != cache.end())
+      continue;
+
+    std::shared_ptr<const RasterMap> map;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      map = Load(store, key);
+    }
+
+    cache.push_front({key, std::move(map)});
+    if (cache.size() > MAX_CACHED)
+      /* evict the least recently used map; the renderer may still
+         own a reference to it */
+      cache.pop_back();
+
+    /* notify the client that the requested map is ready */
+    if (key == requested && callback) {
+      const ScopeUnlock unlock(mutex);
+      callback();
+    }
+  }
+}
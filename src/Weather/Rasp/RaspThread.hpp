@@ -0,0 +1,152 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WEATHER_RASP_THREAD_HPP
+#define XCSOAR_WEATHER_RASP_THREAD_HPP
+
+#include "Thread/StandbyThread.hpp"
+
+#include <functional>
+#include <memory>
+#include <list>
+#include <deque>
+
+class RaspStore;
+class RasterMap;
+
+/**
+ * A thread that decodes RASP maps asynchronously.  Decoded maps are
+ * kept in a small LRU cache, and after each request, the adjacent
+ * time slots and parameters are prefetched, so stepping through the
+ * forecast does not block the map.
+ */
+class RaspThread final : private StandbyThread {
+public:
+  /**
+   * The maximum number of decoded maps kept in memory.
+   */
+  static constexpr unsigned MAX_CACHED = 12;
+
+  /**
+   * The maximum number of maps waiting to be decoded.  Older
+   * prefetch requests are discarded.
+   */
+  static constexpr unsigned MAX_QUEUED = 8;
+
+private:
+  struct Key {
+    unsigned parameter, time;
+
+    constexpr bool operator==(const Key &other) const {
+      return parameter == other.parameter && time == other.time;
+    }
+  };
+
+  struct Item {
+    Key key;
+
+    /**
+     * The decoded map, or nullptr if decoding has failed.
+     */
+    std::shared_ptr<const RasterMap> map;
+  };
+
+  const RaspStore &store;
+
+  const std::function<void()> callback;
+
+  /**
+   * The decoded maps, most recently used first.  Protected by
+   * #mutex.
+   */
+  std::list<Item> cache;
+
+  /**
+   * The maps which shall be decoded, in this order.  Protected by
+   * #mutex.
+   */
+  std::deque<Key> queue;
+
+  /**
+   * The last map which was requested but not found in the cache.
+   * The callback is invoked only after this one has been decoded,
+   * not for prefetched maps.
+   */
+  Key requested{~0u, ~0u};
+
+  /**
+   * The map whose neighbours were scheduled last; avoids
+   * re-scheduling them for every lookup.
+   */
+  Key last_prefetch{~0u, ~0u};
+
+public:
+  RaspThread(const RaspStore &_store, std::function<void()> &&_callback);
+
+  using StandbyThread::LockStop;
+
+  const RaspStore &GetStore() const {
+    return store;
+  }
+
+  /**
+   * Look up a decoded map.  If it is not in the cache, it is
+   * scheduled for decoding ahead of all prefetch requests, and the
+   * callback will be invoked as soon as it is available.
+   *
+   * @param time a time index which is available for this parameter
+   * @param map receives the map; nullptr if decoding has failed
+   * @return true if the map has been decoded (successfully or not),
+   * false if it is still pending
+   */
+  bool Lookup(unsigned parameter, unsigned time,
+              std::shared_ptr<const RasterMap> &map);
+
+private:
+  gcc_pure
+  std::list<Item>::iterator FindCached(Key key);
+
+  gcc_pure
+  bool IsScheduled(Key key) const;
+
+  /**
+   * Append a prefetch request unless the map is already cached or
+   * queued.
+   */
+  void Prefetch(Key key);
+
+  /**
+   * Schedule the neighbours of the given map: the previous and next
+   * available time slots of the same parameter, and the adjacent
+   * parameters at the nearest available time.
+   */
+  void PrefetchNeighbours(Key key);
+
+  static std::shared_ptr<const RasterMap> Load(const RaspStore &store,
+                                               Key key);
+
+  /* virtual methods from class StandbyThread*/
+  void Tick() override;
+};
+
+#endif
@@ -0,0 +1,319 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Analyse all IGC files below one or more directories and print the
+ * results as one JSON array.  Each flight is replayed by its own
+ * #FlightAnalysis instance; the files are distributed over a pool of
+ * worker threads, which share only the (read-only) file list and
+ * settings.
+ */
+
+#include "FlightAnalysis.hpp"
+#include "DebugReplayIGC.hpp"
+#include "OS/Args.hpp"
+#include "OS/FileUtil.hpp"
+#include "OS/Path.hpp"
+#include "OS/ConvertPathName.hpp"
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
+#include "IO/StdioOutputStream.hxx"
+#include "IO/BufferedOutputStream.hxx"
+#include "IO/OutputStream.hxx"
+#include "JSON/Writer.hpp"
+#include "Util/StringCompare.hxx"
+#include "Util/PrintException.hxx"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <tchar.h>
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#endif
+
+class IGCFileCollector final : public File::Visitor {
+  std::vector<AllocatedPath> &files;
+
+public:
+  explicit IGCFileCollector(std::vector<AllocatedPath> &_files)
+    :files(_files) {}
+
+  void Visit(Path path, gcc_unused Path filename) override {
+    files.emplace_back(path);
+  }
+};
+
+/**
+ * An #OutputStream which collects everything in a std::string.
+ */
+class StringOutputStream final : public OutputStream {
+  std::string value;
+
+public:
+  std::string Steal() {
+    return std::move(value);
+  }
+
+  void Write(const void *data, size_t size) override {
+    value.append((const char *)data, size);
+  }
+};
+
+/**
+ * The result of one flight: a complete JSON object.
+ */
+struct BatchResult {
+  std::string json;
+
+  bool failed = false;
+};
+
+/**
+ * The state shared by all workers.  The file list and the settings
+ * are read-only while the workers run; each worker writes only the
+ * #results slots of the files it has claimed, and #mutex protects
+ * the queue position.
+ */
+struct BatchJob {
+  const std::vector<AllocatedPath> &files;
+  const FlightAnalysisSettings &settings;
+
+  std::vector<BatchResult> results;
+
+  Mutex mutex;
+  size_t next = 0;
+
+  BatchJob(const std::vector<AllocatedPath> &_files,
+           const FlightAnalysisSettings &_settings)
+    :files(_files), settings(_settings), results(_files.size()) {}
+
+  /**
+   * Claim the next file to be analysed.
+   *
+   * @return false when the queue is empty
+   */
+  bool Pop(size_t &i) {
+    const ScopeLock protect(mutex);
+    if (next >= files.size())
+      return false;
+
+    i = next++;
+    return true;
+  }
+};
+
+static void
+WriteFlight(BufferedOutputStream &writer, Path path,
+            const FlightAnalysis *analysis, const char *error)
+{
+  JSON::ObjectWriter object(writer);
+
+  object.WriteElement("file", JSON::WriteString,
+                      (const char *)NarrowPathName(path));
+
+  if (analysis != nullptr)
+    analysis->WriteAttributes(object);
+  else
+    object.WriteElement("error", JSON::WriteString, error);
+}
+
+/**
+ * Analyse one file and serialise the result (or the error message)
+ * to JSON.
+ */
+static BatchResult
+AnalyseFile(Path path, const FlightAnalysisSettings &settings)
+{
+  BatchResult result;
+
+  try {
+    std::unique_ptr<DebugReplay> replay(DebugReplayIGC::Create(path));
+    std::unique_ptr<FlightAnalysis> analysis(new FlightAnalysis(settings));
+    analysis->Run(*replay);
+
+    StringOutputStream sos;
+    BufferedOutputStream writer(sos);
+    WriteFlight(writer, path, analysis.get(), nullptr);
+    writer.Flush();
+    result.json = sos.Steal();
+  } catch (const std::exception &e) {
+    StringOutputStream sos;
+    BufferedOutputStream writer(sos);
+    WriteFlight(writer, path, nullptr, e.what());
+    writer.Flush();
+    result.json = sos.Steal();
+    result.failed = true;
+  }
+
+  return result;
+}
+
+class BatchWorker final : public Thread {
+  BatchJob &job;
+
+public:
+  explicit BatchWorker(BatchJob &_job)
+    :Thread("BatchAnalyse"), job(_job) {}
+
+protected:
+  void Run() override {
+    size_t i;
+    while (job.Pop(i))
+      job.results[i] = AnalyseFile(job.files[i], job.settings);
+  }
+};
+
+static unsigned
+GetDefaultJobs()
+{
+#ifdef HAVE_POSIX
+  const long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n_cpus > 1)
+    return n_cpus;
+#endif
+
+  return 1;
+}
+
+static unsigned
+ParsePositive(Args &args, const char *value)
+{
+  char *endptr;
+  unsigned long result = strtoul(value, &endptr, 10);
+  if (endptr == value || *endptr != 0 || result == 0) {
+    fprintf(stderr, "Failed to parse '%s'\n", value);
+    args.UsageError();
+  }
+
+  return result;
+}
+
+int main(int argc, char **argv)
+try {
+  FlightAnalysisSettings settings;
+  unsigned n_jobs = GetDefaultJobs();
+
+  Args args(argc, argv,
+            "[options] PATH...\n"
+            "Options:\n"
+            "  --jobs=N                 Number of worker threads (default = number of CPUs)\n"
+            "  --full-points=512        Maximum number of full trace points (default = 512)\n"
+            "  --triangle-points=1024   Maximum number of triangle trace points (default = 1024)\n"
+            "  --sprint-points=64       Maximum number of sprint trace points (default = 64)");
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--jobs=")) != nullptr)
+      n_jobs = ParsePositive(args, value);
+    else if ((value = StringAfterPrefix(arg, "--full-points=")) != nullptr)
+      settings.full_max_points = ParsePositive(args, value);
+    else if ((value = StringAfterPrefix(arg, "--triangle-points=")) != nullptr)
+      settings.triangle_max_points = ParsePositive(args, value);
+    else if ((value = StringAfterPrefix(arg, "--sprint-points=")) != nullptr)
+      settings.sprint_max_points = ParsePositive(args, value);
+    else
+      args.UsageError();
+  }
+
+  if (args.IsEmpty())
+    args.UsageError();
+
+  std::vector<AllocatedPath> files;
+  IGCFileCollector collector(files);
+
+  while (!args.IsEmpty()) {
+    const auto path = args.ExpectNextPath();
+    if (Directory::Exists(path))
+      Directory::VisitSpecificFiles(path, _T("*.igc"), collector, true);
+    else
+      files.emplace_back(path);
+  }
+
+  /* the results are written in this order, regardless of which
+     worker finishes first */
+  std::sort(files.begin(), files.end(), [](Path a, Path b){
+      return _tcscmp(a.c_str(), b.c_str()) < 0;
+    });
+
+  n_jobs = std::max(1u, std::min<unsigned>(n_jobs, files.size()));
+
+  BatchJob job(files, settings);
+
+  {
+    std::vector<std::unique_ptr<BatchWorker>> workers;
+    for (unsigned i = 0; i < n_jobs; ++i) {
+      std::unique_ptr<BatchWorker> worker(new BatchWorker(job));
+      if (!worker->Start())
+        break;
+
+      workers.emplace_back(std::move(worker));
+    }
+
+    if (workers.empty()) {
+      fputs("Failed to start worker threads\n", stderr);
+      return EXIT_FAILURE;
+    }
+
+    for (auto &worker : workers)
+      worker->Join();
+  }
+
+  StdioOutputStream os(stdout);
+  BufferedOutputStream writer(os);
+
+  unsigned n_failed = 0;
+
+  {
+    JSON::ArrayWriter array(writer);
+    for (const auto &result : job.results) {
+      array.BeginElement();
+      writer.Write(result.json.c_str());
+      array.EndElement();
+
+      if (result.failed)
+        ++n_failed;
+    }
+  }
+
+  writer.Write('\n');
+  writer.Flush();
+
+  if (n_failed > 0)
+    fprintf(stderr, "%u of %u files failed\n",
+            n_failed, unsigned(files.size()));
+
+  return n_failed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+} catch (const std::exception &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,112 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Measure the collision prediction for a full traffic list of
+ * synthetic targets, and compare the batch solver with the scalar
+ * reference implementation.
+ */
+
+#include "FLARM/CollisionPredictor.hpp"
+#include "OS/Clock.hpp"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned N_TARGETS = CollisionPredictor::MAX_TARGETS;
+static constexpr unsigned ITERATIONS = 1000;
+
+struct Target {
+  double north, east;
+  CollisionPredictor::Motion motion;
+};
+
+/**
+ * Generate a mix of gliders circling in thermals and faster traffic
+ * flying straight, within 10 km.
+ */
+static void
+GenerateTraffic(Target *targets, unsigned n)
+{
+  for (unsigned i = 0; i < n; ++i) {
+    Target &t = targets[i];
+    t.north = rand() % 20000 - 10000;
+    t.east = rand() % 20000 - 10000;
+
+    if (i % 3 == 0)
+      t.motion = {double(20 + rand() % 10), Angle::Degrees(rand() % 360),
+                  double(rand() % 2 ? 18 : -18)};
+    else
+      t.motion = {double(25 + rand() % 100), Angle::Degrees(rand() % 360),
+                  double(rand() % 5 - 2)};
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  static Target targets[N_TARGETS];
+  GenerateTraffic(targets, N_TARGETS);
+
+  const CollisionPredictor::Motion own{30, Angle::Degrees(120), 3};
+
+  static CollisionPredictor predictor;
+
+  uint64_t start = MonotonicClockUS();
+  for (unsigned i = 0; i < ITERATIONS; ++i) {
+    predictor.Clear();
+    for (const auto &t : targets)
+      predictor.Add(t.north, t.east, t.motion);
+    predictor.Solve(own);
+  }
+  const uint64_t batch_us = MonotonicClockUS() - start;
+
+  static CollisionPredictor::Result scalar[N_TARGETS];
+  start = MonotonicClockUS();
+  for (unsigned i = 0; i < ITERATIONS; ++i)
+    for (unsigned j = 0; j < N_TARGETS; ++j)
+      scalar[j] = CollisionPredictor::SolveScalar(targets[j].north,
+                                                  targets[j].east,
+                                                  targets[j].motion, own);
+  const uint64_t scalar_us = MonotonicClockUS() - start;
+
+  unsigned n_different = 0;
+  double max_difference = 0;
+  for (unsigned j = 0; j < N_TARGETS; ++j) {
+    const double d = fabs(predictor.Get(j).distance - scalar[j].distance);
+    if (d > 0.5)
+      ++n_different;
+    if (d > max_difference)
+      max_difference = d;
+  }
+
+  printf("targets    %8u\n", N_TARGETS);
+  printf("scalar     %8.3f ms/cycle\n", scalar_us / 1000. / ITERATIONS);
+  printf("batch      %8.3f ms/cycle\n", batch_us / 1000. / ITERATIONS);
+  printf("speedup    %8.2f\n", double(scalar_us) / batch_us);
+  printf("different  %8u of %u targets, max %.3f m\n",
+         n_different, N_TARGETS, max_difference);
+
+  return n_different == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
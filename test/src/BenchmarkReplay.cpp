@@ -0,0 +1,252 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Replays a NMEA or IGC file through the whole calculation pipeline
+ * as fast as possible and reports the throughput and the time spent
+ * in each stage: parsing the file, merging the fix into #MoreData,
+ * #BasicComputer, #GlideComputer, #TaskManager, the contest solvers
+ * and the airspace warnings.
+ *
+ * With --min-rate, the program fails if the given throughput
+ * [fixes/s] is not reached; "make benchmark-replay" uses this.
+ */
+
+#include "DebugReplay.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/Settings.hpp"
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Task/TaskFile.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+#include "IO/FileLineReader.hpp"
+#include "Operation/Operation.hpp"
+#include "OS/Args.hpp"
+#include "OS/Clock.hpp"
+#include "Util/PrintException.hxx"
+#include "Util/StringCompare.hxx"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* fake symbols: */
+
+void
+ConditionMonitorsUpdate(const NMEAInfo &basic, const DerivedInfo &calculated,
+                        const ComputerSettings &settings)
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent(const NMEAInfo &gps_info) {}
+void Logger::LogPoint(const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+static void
+PrintStage(const char *name, uint64_t us, unsigned n_fixes, uint64_t all_us)
+{
+  printf("%-16s %10.3f s %8.2f us/fix %5.1f%%\n", name,
+         us / 1000000., n_fixes > 0 ? double(us) / n_fixes : 0.,
+         all_us > 0 ? us * 100. / all_us : 0.);
+}
+
+static void
+LoadAirspace(Airspaces &airspaces, Path path)
+{
+  FileLineReader reader(path, Charset::AUTO);
+  AirspaceParser parser(airspaces);
+  NullOperationEnvironment operation;
+  if (!parser.Parse(reader, operation))
+    fprintf(stderr, "Failed to parse airspace file\n");
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "[options] {DRIVER FILE | FILE.igc}\n"
+            "Options:\n"
+            "  --task=FILE              Load this task before replaying\n"
+            "  --airspace=FILE          Load this airspace file (may be repeated)\n"
+            "  --min-rate=N             Fail if less than N fixes/s are processed");
+
+  Airspaces airspace_database;
+  Path task_path = nullptr;
+  double min_rate = 0;
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--task=")) != nullptr) {
+      task_path = Path(value);
+    } else if ((value = StringAfterPrefix(arg, "--airspace=")) != nullptr) {
+      LoadAirspace(airspace_database, Path(value));
+    } else if ((value = StringAfterPrefix(arg, "--min-rate=")) != nullptr) {
+      char *endptr;
+      min_rate = strtod(value, &endptr);
+      if (endptr == value || *endptr != '\0' || min_rate < 0) {
+        fputs("The min-rate parameter could not be parsed correctly.\n",
+              stderr);
+        args.UsageError();
+      }
+    } else {
+      args.UsageError();
+    }
+  }
+
+  DebugReplay *replay = CreateDebugReplay(args);
+  if (replay == nullptr)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  airspace_database.Optimise();
+
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(1);
+
+  const Waypoints way_points;
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  TaskManager task_manager(task_behaviour, way_points);
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  if (task_path != nullptr) {
+    OrderedTask *task = TaskFile::GetTask(task_path, task_behaviour,
+                                          nullptr, 0);
+    if (task == nullptr) {
+      fprintf(stderr, "Failed to load task\n");
+      return EXIT_FAILURE;
+    }
+
+    task->UpdateGeometry();
+    const bool success = task_manager.Commit(*task);
+    delete task;
+
+    if (!success) {
+      fprintf(stderr, "Failed to activate task\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  ProtectedTaskManager protected_task_manager(task_manager, settings.task);
+
+  GlideComputer glide_computer(settings, way_points, airspace_database,
+                               protected_task_manager, task_events);
+  glide_computer.SetContestIncremental(true);
+  glide_computer.Initialise();
+
+  ComputerStageTimes stage_times;
+  replay->SetStageTimes(&stage_times);
+  glide_computer.SetStageTimes(&stage_times);
+
+  uint64_t replay_us = 0, read_us = 0, gps_us = 0, idle_us = 0;
+
+  unsigned n_fixes = 0;
+  const uint64_t start = MonotonicClockUS();
+
+  while (true) {
+    const uint64_t t0 = MonotonicClockUS();
+    if (!replay->Next())
+      break;
+
+    const uint64_t t1 = MonotonicClockUS();
+    replay_us += t1 - t0;
+
+    glide_computer.ReadBlackboard(replay->Basic());
+
+    const uint64_t t2 = MonotonicClockUS();
+    read_us += t2 - t1;
+
+    const bool idle = glide_computer.ProcessGPS();
+    const uint64_t t3 = MonotonicClockUS();
+    gps_us += t3 - t2;
+
+    if (idle) {
+      glide_computer.ProcessIdle();
+      idle_us += MonotonicClockUS() - t3;
+    }
+
+    ++n_fixes;
+  }
+
+  const uint64_t total_us = MonotonicClockUS() - start;
+  delete replay;
+
+  typedef ComputerStageTimes::Stage Stage;
+  const uint64_t merge_us = stage_times.Get(Stage::MERGE) + read_us;
+  const uint64_t basic_us = stage_times.Get(Stage::BASIC);
+  const uint64_t task_us = stage_times.Get(Stage::TASK);
+  const uint64_t contest_us = stage_times.Get(Stage::CONTEST);
+  const uint64_t airspace_us = stage_times.Get(Stage::AIRSPACE);
+
+  /* DebugReplay::Next() contains the parser and the merge and basic
+     stages; GlideComputer::ReadBlackboard() is part of the merge
+     stage, too; the GlideComputer methods contain the glide
+     computer and the task, contest and airspace stages */
+  const uint64_t parse_us =
+    replay_us - stage_times.Get(Stage::MERGE) - basic_us;
+  const uint64_t glide_us =
+    gps_us + idle_us - task_us - contest_us - airspace_us;
+
+  const double rate = total_us > 0 ? n_fixes * 1000000. / total_us : 0;
+
+  printf("fixes            %10u\n", n_fixes);
+  printf("total            %10.3f s\n", total_us / 1000000.);
+  printf("rate             %10.0f fixes/s\n", rate);
+  PrintStage("parse", parse_us, n_fixes, total_us);
+  PrintStage("merge", merge_us, n_fixes, total_us);
+  PrintStage("basic", basic_us, n_fixes, total_us);
+  PrintStage("glide", glide_us, n_fixes, total_us);
+  PrintStage("task", task_us, n_fixes, total_us);
+  PrintStage("contest", contest_us, n_fixes, total_us);
+  PrintStage("airspace", airspace_us, n_fixes, total_us);
+
+  if (min_rate > 0 && rate < min_rate) {
+    fprintf(stderr, "Throughput below %.0f fixes/s\n", min_rate);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+} catch (const std::exception &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,137 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Compare the speed of the vectorised slope shading kernel with the
+ * scalar one, and count the pixels where they disagree.  Build with
+ * DEBUG=n, or the numbers are meaningless.
+ */
+
+#include "Terrain/SlopeShading.hpp"
+#include "OS/Clock.hpp"
+
+#include <vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned WIDTH = 640, HEIGHT = 480;
+static constexpr unsigned QUANTISATION = 1;
+static constexpr unsigned ITERATIONS = 200;
+
+/**
+ * Generate some hilly terrain with a lake in the middle.
+ */
+static std::vector<TerrainHeight>
+GenerateTerrain()
+{
+  std::vector<TerrainHeight> heights;
+  heights.reserve(WIDTH * HEIGHT);
+
+  for (unsigned y = 0; y < HEIGHT; ++y) {
+    for (unsigned x = 0; x < WIDTH; ++x) {
+      const double h = 1200 + 800 * sin(x / 37.) * cos(y / 23.)
+        + 300 * sin((x + 2 * y) / 11.) + (rand() % 16);
+
+      const int dx = int(x) - int(WIDTH / 2), dy = int(y) - int(HEIGHT / 2);
+      heights.push_back(dx * dx + dy * dy < 400
+                        ? TerrainHeight(-31000)
+                        : TerrainHeight(int16_t(h)));
+    }
+  }
+
+  return heights;
+}
+
+typedef void (*RowFunction)(int8_t *dest, const TerrainHeight *src,
+                            unsigned n, unsigned column_distance,
+                            unsigned row_minus_offset,
+                            unsigned row_plus_offset,
+                            unsigned p31, unsigned dd2,
+                            const SlopeShadingParameters &p);
+
+static uint64_t
+Run(RowFunction f, const std::vector<TerrainHeight> &heights,
+    std::vector<int8_t> &result)
+{
+  const SlopeShadingParameters params{-120, -150, 180, 220};
+  const unsigned q = QUANTISATION;
+  const unsigned row_offset = WIDTH * q;
+  const unsigned p31 = 2 * q;
+  const unsigned dd2 = 2 * q * p31 * 100;
+
+  const uint64_t start = MonotonicClockUS();
+
+  for (unsigned i = 0; i < ITERATIONS; ++i)
+    for (unsigned y = q; y < HEIGHT - q; ++y)
+      f(result.data() + y * WIDTH + q, heights.data() + y * WIDTH + q,
+        WIDTH - 2 * q, q, row_offset, row_offset, p31, dd2, params);
+
+  return MonotonicClockUS() - start;
+}
+
+int
+main(int argc, char **argv)
+{
+  const auto heights = GenerateTerrain();
+
+  std::vector<int8_t> scalar(WIDTH * HEIGHT), vector(WIDTH * HEIGHT);
+
+  const uint64_t scalar_us = Run(CalculateSlopeRowScalar, heights, scalar);
+  const uint64_t vector_us = Run(CalculateSlopeRow, heights, vector);
+
+  const unsigned q = QUANTISATION;
+  unsigned n_pixels = 0, n_different = 0;
+  int max_difference = 0;
+  for (unsigned y = q; y < HEIGHT - q; ++y) {
+    for (unsigned x = q; x < WIDTH - q; ++x) {
+      const unsigned i = y * WIDTH + x;
+
+      /* results next to "special" heights are undefined */
+      if (heights[i - q].IsSpecial() || heights[i + q].IsSpecial() ||
+          heights[i - WIDTH * q].IsSpecial() ||
+          heights[i + WIDTH * q].IsSpecial())
+        continue;
+
+      ++n_pixels;
+      const int d = abs(scalar[i] - vector[i]);
+      if (d > 0) {
+        ++n_different;
+        if (d > max_difference)
+          max_difference = d;
+      }
+    }
+  }
+
+  const double megapixels = double(n_pixels) * ITERATIONS / 1e6;
+  printf("scalar     %8.3f ms %8.1f Mpixel/s\n",
+         scalar_us / 1000., megapixels / (scalar_us / 1e6));
+  printf("vectorised %8.3f ms %8.1f Mpixel/s\n",
+         vector_us / 1000., megapixels / (vector_us / 1e6));
+  printf("speedup    %8.2f\n", double(scalar_us) / vector_us);
+  printf("different  %8u of %u pixels, max %d\n",
+         n_different, n_pixels, max_difference);
+
+  return n_different == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
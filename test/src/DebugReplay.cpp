@@ -49,9 +49,16 @@ DebugReplay::~DebugReplay()
 void
 DebugReplay::Compute()
 {
-  computed_basic.Reset();
-  (NMEAInfo &)computed_basic = raw_basic;
-  wrap_clock.Normalise(computed_basic);
+  {
+    const ScopeStageTimer timer(stage_times,
+                                ComputerStageTimes::Stage::MERGE);
+    computed_basic.Reset();
+    (NMEAInfo &)computed_basic = raw_basic;
+    wrap_clock.Normalise(computed_basic);
+  }
+
+  const ScopeStageTimer timer(stage_times,
+                              ComputerStageTimes::Stage::BASIC);
 
   FeaturesSettings features;
   features.nav_baro_altitude_enabled = true;
@@ -28,6 +28,7 @@ Copyright_License {
 #include "NMEA/Derived.hpp"
 #include "Computer/BasicComputer.hpp"
 #include "Computer/FlyingComputer.hpp"
+#include "Computer/StageTimes.hpp"
 #include "Engine/GlideSolvers/GlidePolar.hpp"
 #include "Time/WrapClock.hpp"
 #include "OS/Args.hpp"
@@ -62,6 +63,8 @@ protected:
 
   AtmosphericPressure qnh;
 
+  ComputerStageTimes *stage_times = nullptr;
+
 public:
   DebugReplay();
   virtual ~DebugReplay();
@@ -99,6 +102,14 @@ public:
     qnh = _qnh;
   }
 
+  /**
+   * Measure the time spent in the merge and basic stages of
+   * Compute().  Pass nullptr to disable.
+   */
+  void SetStageTimes(ComputerStageTimes *_stage_times) {
+    stage_times = _stage_times;
+  }
+
 protected:
   void Compute();
 };
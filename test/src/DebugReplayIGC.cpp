@@ -22,8 +22,6 @@ Copyright_License {
 */
 
 #include "DebugReplayIGC.hpp"
-#include "IO/FileLineReader.hpp"
-#include "IGC/IGCParser.hpp"
 #include "IGC/IGCFix.hpp"
 #include "Units/System.hpp"
 #include "OS/Path.hpp"
@@ -31,8 +29,7 @@ Copyright_License {
 DebugReplay*
 DebugReplayIGC::Create(Path input_file)
 {
-  FileLineReaderA *reader = new FileLineReaderA(input_file);
-  return new DebugReplayIGC(reader);
+  return new DebugReplayIGC(input_file);
 }
 
 bool
@@ -40,26 +37,18 @@ DebugReplayIGC::Next()
 {
   last_basic = computed_basic;
 
-  const char *line;
-  while ((line = reader->ReadLine()) != NULL) {
-    if (line[0] == 'B') {
-      IGCFix fix;
-      if (IGCParseFix(line, extensions, fix)) {
-        CopyFromFix(fix);
-
-        Compute();
-        return true;
-      }
-    } else if (line[0] == 'H') {
-      BrokenDate date;
-      if (memcmp(line, "HFDTE", 5) == 0 &&
-          IGCParseDateRecord(line, date)) {
-        (BrokenDate &)raw_basic.date_time_utc = date;
-        raw_basic.time_available.Clear();
-      }
-    } else if (line[0] == 'I') {
-      IGCParseExtensions(line, extensions);
+  IGCFix fix;
+  if (reader.Next(fix)) {
+    if (!(reader.GetDate() == date)) {
+      date = reader.GetDate();
+      (BrokenDate &)raw_basic.date_time_utc = date;
+      raw_basic.time_available.Clear();
     }
+
+    CopyFromFix(fix);
+
+    Compute();
+    return true;
   }
 
   if (computed_basic.time_available)
@@ -79,7 +68,13 @@ DebugReplayIGC::CopyFromFix(const IGCFix &fix)
     raw_basic.date_time_utc.IncrementDay();
   }
 
-  basic.clock = basic.time = fix.time.GetSecondOfDay();
+  double time = fix.time.GetSecondOfDay();
+  if (fix.tds > 0)
+    /* high-rate logger: tenths of the second from the "TDS"
+       extension */
+    time += fix.tds / 10.;
+
+  basic.clock = basic.time = time;
   basic.time_available.Update(basic.clock);
   basic.date_time_utc.hour = fix.time.hour;
   basic.date_time_utc.minute = fix.time.minute;
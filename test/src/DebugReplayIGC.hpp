@@ -24,23 +24,34 @@ Copyright_License {
 #ifndef XCSOAR_DEBUG_REPLAY_IGC_HPP
 #define XCSOAR_DEBUG_REPLAY_IGC_HPP
 
-#include "DebugReplayFile.hpp"
-#include "IGC/IGCExtensions.hpp"
-#include "IO/FileLineReader.hpp"
+#include "DebugReplay.hpp"
+#include "IGC/IGCFileReader.hpp"
+#include "Time/BrokenDate.hpp"
 
 struct IGCFix;
 
-class DebugReplayIGC : public DebugReplayFile {
-  IGCExtensions extensions;
+class DebugReplayIGC : public DebugReplay {
+  IGCFileReader reader;
+
+  /**
+   * The date which was last copied from the reader.
+   */
+  BrokenDate date;
 
 private:
-  DebugReplayIGC(FileLineReaderA *_reader)
-    : DebugReplayFile(_reader) {
-    extensions.clear();
-  }
+  explicit DebugReplayIGC(Path input_file)
+    :reader(input_file), date(BrokenDate::Invalid()) {}
 
 public:
-  virtual bool Next();
+  long Size() const override {
+    return reader.GetSize();
+  }
+
+  long Tell() const override {
+    return reader.Tell();
+  }
+
+  bool Next() override;
 
   static DebugReplay *Create(Path input_file);
 
@@ -0,0 +1,108 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#ifndef XCSOAR_FLIGHT_ANALYSIS_HPP
+#define XCSOAR_FLIGHT_ANALYSIS_HPP
+
+#include "Engine/Trace/Trace.hpp"
+#include "Contest/ContestStatistics.hpp"
+#include "Computer/CirclingComputer.hpp"
+#include "FlightPhaseDetector.hpp"
+#include "Time/BrokenDateTime.hpp"
+#include "Geo/GeoPoint.hpp"
+
+struct MoreData;
+struct FlyingState;
+struct CirclingSettings;
+class DebugReplay;
+class BufferedOutputStream;
+namespace JSON { class ObjectWriter; }
+
+struct FlightAnalysisSettings {
+  unsigned full_max_points = 512;
+  unsigned triangle_max_points = 1024;
+  unsigned sprint_max_points = 64;
+};
+
+/**
+ * Replays one flight through the #CirclingComputer, the
+ * #FlightPhaseDetector and the contest solvers and collects the
+ * results.  All state lives in this object, which allows analysing
+ * several flights in parallel, one instance per thread.
+ */
+class FlightAnalysis {
+  struct Result {
+    BrokenDateTime takeoff_time, release_time, landing_time;
+    GeoPoint takeoff_location, release_location, landing_location;
+
+    Result() {
+      takeoff_time.Clear();
+      landing_time.Clear();
+      release_time.Clear();
+
+      takeoff_location.SetInvalid();
+      landing_location.SetInvalid();
+      release_location.SetInvalid();
+    }
+  };
+
+  CirclingComputer circling_computer;
+  FlightPhaseDetector flight_phase_detector;
+
+  Trace full_trace, triangle_trace, sprint_trace;
+
+  Result result;
+
+  ContestStatistics olc_plus, dmst;
+
+public:
+  explicit FlightAnalysis(const FlightAnalysisSettings &settings);
+
+  /**
+   * Consume all fixes of the replay and solve the contests.  May be
+   * called only once per instance.
+   */
+  void Run(DebugReplay &replay);
+
+  /**
+   * Write the "events", "phases", "performance" and "contests"
+   * attributes to the given JSON object.
+   */
+  void WriteAttributes(JSON::ObjectWriter &root) const;
+
+  /**
+   * Write the whole analysis as one JSON object.
+   */
+  void Write(BufferedOutputStream &writer) const;
+
+private:
+  void Update(const MoreData &basic, const FlyingState &state);
+  void Finish(const MoreData &basic);
+  void ComputeCircling(DebugReplay &replay,
+                       const CirclingSettings &circling_settings);
+  void Replay(DebugReplay &replay);
+
+  static void WriteEvents(BufferedOutputStream &writer, const Result &result);
+};
+
+#endif
@@ -26,6 +26,7 @@ Copyright_License {
 #include "OS/Args.hpp"
 #include "IO/FileLineReader.hpp"
 #include "Operation/Operation.hpp"
+#include "OS/Clock.hpp"
 #include "Util/PrintException.hxx"
 
 #include <stdio.h>
@@ -42,15 +43,24 @@ try {
   Airspaces airspaces;
   AirspaceParser parser(airspaces);
 
+  const uint64_t start = MonotonicClockUS();
+
   NullOperationEnvironment operation;
   if (!parser.Parse(reader, operation)) {
     fprintf(stderr, "Failed to parse input file\n");
     return 1;
   }
 
+  const uint64_t parsed = MonotonicClockUS();
+
   airspaces.Optimise();
 
+  const uint64_t optimised = MonotonicClockUS();
+
   printf("OK\n");
+  printf("airspaces %u\n", unsigned(airspaces.GetSize()));
+  printf("parse     %8.1f ms\n", (parsed - start) / 1000.);
+  printf("optimise  %8.1f ms\n", (optimised - parsed) / 1000.);
 
   return EXIT_SUCCESS;
 } catch (const std::runtime_error &e) {
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
 #include "Engine/Airspace/AbstractAirspace.hpp"
 #include "Engine/Airspace/AirspaceCircle.hpp"
 #include "Engine/Airspace/AirspacePolygon.hpp"
@@ -57,11 +58,44 @@ ParseFile(Path path, Airspaces &airspaces)
   return true;
 }
 
+/**
+ * Parse the file, write it to a cache file and load the result back
+ * into #airspaces.
+ */
+static bool
+ParseFileViaCache(Path path, Airspaces &airspaces)
+{
+  Airspaces parsed;
+  if (!ParseFile(path, parsed))
+    return false;
+
+  FILE *file = tmpfile();
+  if (file == nullptr)
+    return false;
+
+  bool success = ok1(SaveAirspaceCache(parsed, file));
+  rewind(file);
+  success = success && ok1(LoadAirspaceCache(airspaces, file));
+  fclose(file);
+
+  airspaces.Optimise();
+  return success;
+}
+
+static bool
+ParseFile(Path path, Airspaces &airspaces, bool via_cache)
+{
+  return via_cache
+    ? ParseFileViaCache(path, airspaces)
+    : ParseFile(path, airspaces);
+}
+
 static void
-TestOpenAir()
+TestOpenAir(bool via_cache)
 {
   Airspaces airspaces;
-  if (!ParseFile(Path(_T("test/data/airspace/openair.txt")), airspaces)) {
+  if (!ParseFile(Path(_T("test/data/airspace/openair.txt")), airspaces,
+                 via_cache)) {
     skip(3, 0, "Failed to parse input file");
     return;
   }
@@ -166,10 +200,11 @@ TestOpenAir()
 }
 
 static void
-TestTNP()
+TestTNP(bool via_cache)
 {
   Airspaces airspaces;
-  if (!ParseFile(Path(_T("test/data/airspace/tnp.sua")), airspaces)) {
+  if (!ParseFile(Path(_T("test/data/airspace/tnp.sua")), airspaces,
+                 via_cache)) {
     skip(3, 0, "Failed to parse input file");
     return;
   }
@@ -275,10 +310,13 @@ TestTNP()
 
 int main(int argc, char **argv)
 try {
-  plan_tests(102);
+  plan_tests(208);
+
+  TestOpenAir(false);
+  TestTNP(false);
 
-  TestOpenAir();
-  TestTNP();
+  TestOpenAir(true);
+  TestTNP(true);
 
   return exit_status();
 } catch (const std::runtime_error &e) {
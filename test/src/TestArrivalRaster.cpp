@@ -0,0 +1,197 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Engine/Route/ArrivalRaster.hpp"
+#include "TestUtil.hpp"
+
+static bool
+CheckCover(int west, int north, int east, int south)
+{
+  const ArrivalGrid grid = ArrivalGrid::Cover(west, north, east, south);
+  const int east_edge = grid.x + int(grid.width) * grid.cell;
+  const int south_edge = grid.y + int(grid.height) * grid.cell;
+
+  return grid.cell > 0 &&
+    grid.x % grid.cell == 0 && grid.y % grid.cell == 0 &&
+    grid.x <= west && grid.x > west - grid.cell &&
+    grid.y <= north && grid.y > north - grid.cell &&
+    east_edge > east && east_edge - grid.cell <= east &&
+    south_edge > south && south_edge - grid.cell <= south &&
+    grid.width <= ArrivalGrid::MAX_SIZE &&
+    grid.height <= ArrivalGrid::MAX_SIZE;
+}
+
+static void
+TestFloorDivide()
+{
+  ok1(ArrivalGrid::FloorDivide(0, 4) == 0);
+  ok1(ArrivalGrid::FloorDivide(3, 4) == 0);
+  ok1(ArrivalGrid::FloorDivide(4, 4) == 1);
+  ok1(ArrivalGrid::FloorDivide(-1, 4) == -1);
+  ok1(ArrivalGrid::FloorDivide(-4, 4) == -1);
+  ok1(ArrivalGrid::FloorDivide(-5, 4) == -2);
+  ok1(ArrivalGrid::FloorDivide(-8, 4) == -2);
+}
+
+static void
+TestCover()
+{
+  ok1(CheckCover(0, 0, 0, 0));
+  ok1(CheckCover(10, 20, 30, 25));
+  ok1(CheckCover(-1, -1, 0, 0));
+  ok1(CheckCover(-10, -5, 20, 30));
+  ok1(CheckCover(-2000, -3000, -1000, -2500));
+  ok1(CheckCover(-1000, -700, 1000, 500));
+  ok1(CheckCover(-64, -64, 1900, 0));
+
+  const ArrivalGrid grid = ArrivalGrid::Cover(-1000, -700, 1000, 500);
+  ok1(grid.cell == 32);
+  ok1(grid.x == -1024);
+  ok1(grid.y == -704);
+  ok1(grid.width == 64);
+  ok1(grid.height == 38);
+
+  /* a negative origin which is a multiple of the cell size */
+  ok1(ArrivalGrid::Cover(-64, -64, 1900, 0).x == -64);
+
+  /* moving the range by one pixel keeps the cells in place */
+  ok1(ArrivalGrid::Cover(-999, -699, 1001, 501) == grid);
+}
+
+/**
+ * A deterministic arrival height function which has reachable and
+ * unreachable cells.
+ */
+static int16_t
+CalculateArrival(const GeoPoint &location)
+{
+  const int value = int(location.latitude.Degrees() * 1000) % 500 -
+    int(location.longitude.Degrees() * 1000) % 300;
+  return value >= 0 ? value : ArrivalRaster::UNREACHABLE;
+}
+
+static bool
+Equals(const ArrivalRaster &a, const ArrivalRaster &b)
+{
+  if (a.GetWidth() != b.GetWidth() || a.GetHeight() != b.GetHeight())
+    return false;
+
+  for (unsigned y = 0; y < a.GetHeight(); ++y)
+    for (unsigned x = 0; x < a.GetWidth(); ++x)
+      if (a.Get(x, y) != b.Get(x, y))
+        return false;
+
+  return true;
+}
+
+static unsigned
+CountUnreachable(const ArrivalRaster &raster)
+{
+  unsigned n = 0;
+  for (unsigned y = 0; y < raster.GetHeight(); ++y)
+    for (unsigned x = 0; x < raster.GetWidth(); ++x)
+      if (raster.Get(x, y) == ArrivalRaster::UNREACHABLE)
+        ++n;
+
+  return n;
+}
+
+static const GeoBounds bounds(GeoPoint(Angle::Degrees(7),
+                                       Angle::Degrees(52)),
+                              GeoPoint(Angle::Degrees(8),
+                                       Angle::Degrees(51)));
+
+static void
+TestFill()
+{
+  const ArrivalGrid grid = ArrivalGrid::Cover(-100, -50, 300, 200);
+
+  /* calculate all cells at once */
+  ArrivalRaster a;
+  a.Reset(grid, bounds);
+  ok1(a.IsDefined() && !a.IsComplete());
+  ok1(a.GetSize() == 58 * 37);
+  ok1(a.Fill(a.GetSize(), CalculateArrival));
+
+  const unsigned n_unreachable = CountUnreachable(a);
+  ok1(n_unreachable > 0 && n_unreachable < a.GetSize());
+
+  /* calculate in small steps */
+  ArrivalRaster b;
+  b.Reset(grid, bounds);
+
+  unsigned n_steps = 1;
+  while (!b.Fill(100, CalculateArrival) && n_steps < 1000)
+    ++n_steps;
+
+  ok1(n_steps == (b.GetSize() + 99) / 100);
+  ok1(Equals(a, b));
+}
+
+static void
+TestRestart()
+{
+  const ArrivalGrid grid = ArrivalGrid::Cover(-100, -50, 300, 200);
+  const ArrivalGrid other = ArrivalGrid::Cover(-120, -50, 300, 200);
+
+  ArrivalRaster a, b;
+  ok1(!a.Restart(grid));
+
+  a.Reset(grid, bounds);
+  a.Fill(a.GetSize(), CalculateArrival);
+  b = a;
+
+  /* a different grid cannot be reused */
+  ok1(!a.Restart(other));
+  ok1(a.IsComplete());
+
+  /* the same grid is reused, and the old cells are kept until they
+     are recalculated */
+  ok1(a.Restart(grid));
+  ok1(!a.IsComplete());
+  ok1(Equals(a, b));
+  ok1(!a.Fill(10, CalculateArrival));
+  ok1(a.Fill(a.GetSize(), CalculateArrival));
+  ok1(Equals(a, b));
+
+  /* a new grid starts with unreachable cells */
+  a.Reset(other, bounds);
+  ok1(!a.IsComplete());
+  ok1(CountUnreachable(a) == a.GetSize());
+
+  a.Clear();
+  ok1(!a.IsDefined());
+  ok1(!a.Restart(other));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(7 + 14 + 6 + 13);
+
+  TestFloorDivide();
+  TestCover();
+  TestFill();
+  TestRestart();
+
+  return exit_status();
+}
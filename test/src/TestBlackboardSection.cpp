@@ -0,0 +1,111 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Blackboard/BlackboardSection.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "TestUtil.hpp"
+
+static void
+TestGenerations()
+{
+  BlackboardGenerations a;
+  ok1(a.Get(BlackboardSection::WIND) == 0);
+
+  const BlackboardGenerations b = a;
+  a.Increment(ToMask(BlackboardSection::WIND) |
+              ToMask(BlackboardSection::TASK));
+  ok1(a.Get(BlackboardSection::WIND) == 1);
+  ok1(a.Get(BlackboardSection::TASK) == 1);
+  ok1(a.Get(BlackboardSection::VARIO) == 0);
+  ok1(a.Compare(b) == (ToMask(BlackboardSection::WIND) |
+                       ToMask(BlackboardSection::TASK)));
+  ok1(a.Compare(a) == 0);
+
+  a.Increment(BLACKBOARD_ALL);
+  ok1(a.Get(BlackboardSection::WIND) == 2);
+  ok1(a.Get(BlackboardSection::AIRSPACE_WARNINGS) == 1);
+  ok1(a.Get(BlackboardSection::SKYLINES) == 1);
+  ok1((BLACKBOARD_ALL & ToMask(BlackboardSection::SKYLINES)) != 0);
+  ok1(a.Compare(b) == BLACKBOARD_ALL);
+}
+
+static void
+TestBasic()
+{
+  const MoreData a = MoreData();
+  MoreData b = a;
+  ok1(CompareBasic(a, b) == 0);
+
+  b.location_available.Update(10);
+  ok1(CompareBasic(a, b) == ToMask(BlackboardSection::POSITION));
+
+  b = a;
+  b.brutto_vario_available.Update(10);
+  ok1(CompareBasic(a, b) == ToMask(BlackboardSection::VARIO));
+
+  b = a;
+  b.flarm.traffic.modified.Update(10);
+  b.external_wind_available.Update(10);
+  ok1(CompareBasic(a, b) == (ToMask(BlackboardSection::TRAFFIC) |
+                             ToMask(BlackboardSection::WIND)));
+}
+
+static void
+TestCalculated()
+{
+  const DerivedInfo a = DerivedInfo();
+  DerivedInfo b = a;
+  ok1(CompareCalculated(a, b) == 0);
+
+  b.wind_available.Update(10);
+  ok1(CompareCalculated(a, b) == ToMask(BlackboardSection::WIND));
+
+  b = a;
+  b.task_stats.distance_nominal = 1000;
+  ok1(CompareCalculated(a, b) == ToMask(BlackboardSection::TASK));
+
+  b = a;
+  b.airspace_warnings.latest.Update(10);
+  b.average = 1.5;
+  ok1(CompareCalculated(a, b) ==
+      (ToMask(BlackboardSection::AIRSPACE_WARNINGS) |
+       ToMask(BlackboardSection::VARIO)));
+
+  /* fields outside of the tracked sections are not reported */
+  b = a;
+  b.auto_zoom_distance = 5000;
+  ok1(CompareCalculated(a, b) == 0);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(20);
+
+  TestGenerations();
+  TestBasic();
+  TestCalculated();
+
+  return exit_status();
+}
@@ -21,6 +21,7 @@
 */
 
 #include "IO/CSVLine.hpp"
+#include "NMEA/SentenceKey.hpp"
 #include "TestUtil.hpp"
 
 #include <cstring>
@@ -97,13 +98,55 @@ Test2()
   ok1(!line.ReadChecked(temp_int) && temp_int == 42);
 }
 
+static void
+Test3()
+{
+  CSVLine line("$GPRMC,,abc,9");
+
+  // Test read_view()
+  auto column = line.ReadView();
+  ok1(std::string(column.begin(), column.end()) == "$GPRMC");
+
+  // Test read_view() with an empty column
+  column = line.ReadView();
+  ok1(column.empty());
+
+  // Test read_compare() with a prefix of the column
+  ok1(!line.ReadCompare("ab"));
+
+  // Test read_compare() with a longer value than the column
+  ok1(!line.ReadCompare("99"));
+
+  // Test read_view() at line-end
+  ok1(line.IsEmpty());
+  column = line.ReadView();
+  ok1(column.empty());
+}
+
+static void
+TestSentenceKey()
+{
+  CSVLine line("$LXWP0,$PLXVC,TOOLONGID,,x");
+
+  ok1(NMEASentenceKey(line.ReadView()) == NMEASentenceKey("$LXWP0"));
+  ok1(NMEASentenceKey(line.ReadView()) != NMEASentenceKey("$LXWP0"));
+  ok1(NMEASentenceKey(line.ReadView()) == 0);
+  ok1(NMEASentenceKey(line.ReadView()) == 0);
+  ok1(NMEASentenceKey(line.ReadView()) == NMEASentenceKey("x"));
+
+  static_assert(NMEASentenceKey("GGA") != NMEASentenceKey("GGAX"), "");
+  static_assert(NMEASentenceKey("$PCAIB") != NMEASentenceKey("$PCAID"), "");
+}
+
 int
 main(int argc, char **argv)
 {
-  plan_tests(19);
+  plan_tests(30);
 
   Test1();
   Test2();
+  Test3();
+  TestSentenceKey();
 
   return exit_status();
 }
@@ -0,0 +1,164 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "FLARM/CollisionPredictor.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+typedef CollisionPredictor::Motion Motion;
+typedef CollisionPredictor::Result Result;
+
+static bool
+Check(const Result &result, double time, double distance,
+      double time_tolerance=0.01, double distance_tolerance=0.1)
+{
+  return fabs(result.time - time) <= time_tolerance &&
+    fabs(result.distance - distance) <= distance_tolerance;
+}
+
+/**
+ * Solve one target with both implementations, and verify that both
+ * produce the expected result.
+ */
+static bool
+Check(double north, double east, const Motion &target, const Motion &own,
+      double time, double distance,
+      double time_tolerance=0.01, double distance_tolerance=0.1)
+{
+  CollisionPredictor predictor;
+  predictor.Add(north, east, target);
+  predictor.Solve(own);
+
+  return Check(predictor.Get(0), time, distance,
+               time_tolerance, distance_tolerance) &&
+    Check(CollisionPredictor::SolveScalar(north, east, target, own),
+          time, distance, time_tolerance, distance_tolerance);
+}
+
+static void
+TestStraight()
+{
+  const Motion north{50, Angle::Zero(), 0};
+  const Motion south{50, Angle::Degrees(180), 0};
+  const Motion west{50, Angle::Degrees(270), 0};
+  const Motion fast_north{60, Angle::Zero(), 0};
+
+  /* head-on */
+  ok1(Check(2000, 0, south, north, 20, 0));
+
+  /* head-on with lateral offset */
+  ok1(Check(2000, 100, south, north, 20, 100));
+
+  /* crossing at a right angle */
+  ok1(Check(1000, 1000, west, north, 20, 0));
+
+  /* flying in formation */
+  ok1(Check(0, 500, north, north, 0, 500));
+
+  /* diverging */
+  ok1(Check(1000, 0, fast_north, north, 0, 1000));
+
+  /* the collision is beyond the horizon; report the closest
+     distance within the horizon */
+  ok1(Check(4000, 0, south, north, CollisionPredictor::HORIZON, 1000));
+}
+
+static void
+TestTurning()
+{
+  /* a target circling at 18 deg/s, i.e. one circle in 20 seconds;
+     the radius is 25 / (pi / 10) = 79.6m */
+  const Motion circling{25, Angle::Degrees(90), 18};
+  const Motion stationary{0, Angle::Zero(), 0};
+  const double radius = 25 / (M_PI / 10);
+
+  /* the target starts heading east 300m north of us, and is
+     closest after half a circle */
+  ok1(Check(300, 0, circling, stationary, 10, 300 - 2 * radius, 0.1, 2));
+
+  /* turn rates above the limit are clipped */
+  const Motion spinning{25, Angle::Degrees(90), 90};
+  const Motion clipped{25, Angle::Degrees(90),
+      CollisionPredictor::MAX_TURN_RATE};
+  ok1(Check(CollisionPredictor::SolveScalar(300, 0, spinning, stationary),
+            CollisionPredictor::SolveScalar(300, 0, clipped,
+                                            stationary).time,
+            CollisionPredictor::SolveScalar(300, 0, clipped,
+                                            stationary).distance));
+}
+
+static void
+TestBatch()
+{
+  CollisionPredictor predictor;
+  ok1(predictor.size() == 0);
+
+  struct Target {
+    double north, east;
+    Motion motion;
+  } targets[CollisionPredictor::MAX_TARGETS];
+
+  srand(42);
+  for (auto &target : targets) {
+    target.north = rand() % 10000 - 5000;
+    target.east = rand() % 10000 - 5000;
+    target.motion = Motion{double(rand() % 60),
+                           Angle::Degrees(rand() % 360),
+                           double(rand() % 41 - 20)};
+    predictor.Add(target.north, target.east, target.motion);
+  }
+
+  ok1(predictor.full());
+
+  const Motion own{30, Angle::Degrees(45), 5};
+  predictor.Solve(own);
+
+  /* single precision may differ slightly from the reference */
+  unsigned n_different = 0;
+  for (unsigned i = 0; i < CollisionPredictor::MAX_TARGETS; ++i) {
+    const Target &target = targets[i];
+    const Result expected =
+      CollisionPredictor::SolveScalar(target.north, target.east,
+                                      target.motion, own);
+    if (fabs(predictor.Get(i).distance - expected.distance) > 0.5)
+      ++n_different;
+  }
+
+  ok1(n_different == 0);
+
+  predictor.Clear();
+  ok1(predictor.size() == 0);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(12);
+
+  TestStraight();
+  TestTurning();
+  TestBatch();
+
+  return exit_status();
+}
@@ -24,18 +24,20 @@
 #include "FLARM/FlarmNetReader.hpp"
 #include "FLARM/FlarmNetRecord.hpp"
 #include "FLARM/FlarmId.hpp"
+#include "OS/FileMapping.hpp"
 #include "OS/Path.hpp"
 #include "TestUtil.hpp"
 
-int main(int argc, char **argv)
-{
-  plan_tests(15);
+#include <string>
 
-  FlarmNetDatabase db;
-  int count = FlarmNetReader::LoadFile(Path(_T("test/data/flarmnet/data.fln")),
-                                       db);
-  ok1(count == 6);
+#include <stdio.h>
+#include <string.h>
+
+static const char *cache_path = "output/TestFlarmNet.bin";
 
+static void
+TestLookup(const FlarmNetDatabase &db)
+{
   FlarmId id = FlarmId::Parse("DDA85C", NULL);
 
   const FlarmNetRecord *record = db.FindRecordById(id);
@@ -49,6 +51,8 @@ int main(int argc, char **argv)
   ok1(StringIsEqual(record->callsign, _T("TH")));
   ok1(StringIsEqual(record->frequency, _T("130.625")));
 
+  ok1(db.FindRecordById(FlarmId::Parse("DDA85D", NULL)) == NULL);
+
   const FlarmNetRecord *array[3];
   ok1(db.FindRecordsByCallSign(_T("TH"), array, 3) == 2);
 
@@ -63,6 +67,9 @@ int main(int argc, char **argv)
   ok1(found4449);
   ok1(found5799);
 
+  /* the buffer size is respected */
+  ok1(db.FindRecordsByCallSign(_T("TH"), array, 1) == 1);
+
   FlarmId ids[3];
   ok1(db.FindIdsByCallSign(_T("TH"), ids, 3) == 2);
 
@@ -78,5 +85,135 @@ int main(int argc, char **argv)
   ok1(foundDDA85C);
   ok1(foundDDA896);
 
+  ok1(db.FindFirstRecordByCallSign(_T("XX")) == NULL);
+}
+
+static void
+TestCache(const FlarmNetDatabase &db)
+{
+  FILE *file = fopen(cache_path, "wb");
+  ok1(file != NULL);
+  ok1(db.SaveCache(file));
+  fclose(file);
+
+  const Path path(_T("output/TestFlarmNet.bin"));
+
+  /* data at the wrong offset is rejected */
+  FlarmNetDatabase bad;
+  ok1(!bad.LoadCache(std::unique_ptr<FileMapping>(new FileMapping(path)),
+                     4));
+  ok1(bad.IsEmpty());
+
+  FlarmNetDatabase mapped;
+  ok1(mapped.LoadCache(std::unique_ptr<FileMapping>(new FileMapping(path)),
+                       0));
+  ok1(mapped.size() == db.size());
+
+  TestLookup(mapped);
+
+  remove(cache_path);
+}
+
+static std::string
+SaveCacheToString(const FlarmNetDatabase &db)
+{
+  FILE *file = fopen(cache_path, "w+b");
+  db.SaveCache(file);
+
+  std::string data(ftell(file), '\0');
+  rewind(file);
+  if (fread(&data[0], 1, data.size(), file) != data.size())
+    data.clear();
+
+  fclose(file);
+  return data;
+}
+
+/**
+ * Write the given (manipulated) cache data and try to load it.
+ */
+static bool
+LoadCacheFromString(const std::string &data)
+{
+  FILE *file = fopen(cache_path, "wb");
+  fwrite(data.data(), 1, data.size(), file);
+  fclose(file);
+
+  const Path path(_T("output/TestFlarmNet.bin"));
+  FlarmNetDatabase db;
+  const bool success =
+    db.LoadCache(std::unique_ptr<FileMapping>(new FileMapping(path)), 0);
+  remove(cache_path);
+  return success && !db.IsEmpty();
+}
+
+static uint32_t
+GetHeaderValue(const std::string &data, unsigned i)
+{
+  uint32_t value;
+  memcpy(&value, data.data() + i * sizeof(value), sizeof(value));
+  return value;
+}
+
+static void
+SetHeaderValue(std::string &data, unsigned i, uint32_t value)
+{
+  memcpy(&data[i * sizeof(value)], &value, sizeof(value));
+}
+
+static void
+TestCorruptCache(const FlarmNetDatabase &db)
+{
+  /* header: magic, version, record_size, n_records, n_callsigns */
+  static constexpr unsigned N_RECORDS = 3, N_CALLSIGNS = 4;
+  static constexpr unsigned HEADER_SIZE = 5 * sizeof(uint32_t);
+
+  const std::string good = SaveCacheToString(db);
+  ok1(good.size() > HEADER_SIZE);
+  ok1(LoadCacheFromString(good));
+
+  const uint32_t n_records = GetHeaderValue(good, N_RECORDS);
+  const uint32_t n_callsigns = GetHeaderValue(good, N_CALLSIGNS);
+
+  /* a record count which makes the payload size wrap around to the
+     real one in 32 bit arithmetic */
+  const unsigned per_record = sizeof(FlarmId) + sizeof(FlarmNetRecord);
+  const uint32_t wrap = 1u << (32 - __builtin_ctz(per_record));
+  std::string data = good;
+  SetHeaderValue(data, N_RECORDS, n_records + wrap);
+  ok1(!LoadCacheFromString(data));
+
+  /* more callsigns than records */
+  data = good;
+  SetHeaderValue(data, N_CALLSIGNS, n_records + 1);
+  ok1(!LoadCacheFromString(data));
+
+  /* the last record without string terminators */
+  data = good;
+  memset(&data[data.size() - sizeof(FlarmNetRecord)], 'X',
+         sizeof(FlarmNetRecord));
+  ok1(!LoadCacheFromString(data));
+
+  /* truncated */
+  data = good;
+  data.resize(HEADER_SIZE + n_records * sizeof(FlarmId) +
+              n_callsigns * sizeof(uint32_t));
+  ok1(!LoadCacheFromString(data));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(2 + 17 * 2 + 6 + 6);
+
+  FlarmNetDatabase db;
+  int count = FlarmNetReader::LoadFile(Path(_T("test/data/flarmnet/data.fln")),
+                                       db);
+  ok1(count == 6);
+  ok1(db.size() == 6);
+
+  TestLookup(db);
+  TestCache(db);
+  TestCorruptCache(db);
+
   return exit_status();
 }
@@ -0,0 +1,241 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Logger/FlightDatabase.hpp"
+#include "Logger/FlightParser.hpp"
+#include "IO/FileLineReader.hpp"
+#include "OS/FileUtil.hpp"
+#include "OS/Path.hpp"
+#include "Time/BrokenDateTime.hpp"
+#include "Util/PrintException.hxx"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+static const Path log_path(_T("output/test/flights.log"));
+static const Path db_path(_T("output/test/flights.idx"));
+
+static void
+AppendLog(const char *text)
+{
+  FILE *file = fopen(log_path.c_str(), "ab");
+  assert(file != nullptr);
+  fputs(text, file);
+  fclose(file);
+}
+
+static bool
+operator==(const FlightInfo &a, const FlightInfo &b)
+{
+  return a.date == b.date &&
+    a.start_time == b.start_time && a.end_time == b.end_time;
+}
+
+/**
+ * Compare all records with what #FlightParser sees in the text log.
+ */
+static bool
+MatchesLog(const FlightDatabase &db)
+{
+  FileLineReaderA reader(log_path);
+  FlightParser parser(reader);
+
+  unsigned i = 0;
+  FlightInfo expected, actual;
+  while (parser.Read(expected)) {
+    if (i >= db.size() || !db.Read(i, actual) || !(actual == expected))
+      return false;
+
+    ++i;
+  }
+
+  return i == db.size();
+}
+
+static void
+TestMigrate()
+{
+  File::Delete(log_path);
+  File::Delete(db_path);
+
+  AppendLog("2014-01-05T10:00:00 start\n"
+            "2014-01-05T12:30:00 landing\n"
+            "2015-06-01T09:00:00 start\n"
+            "2015-06-01T09:10:00 start\n"
+            "2015-06-01T11:10:00 landing\n"
+            "2015-06-02T08:00:00 landing\n"
+            "2015-07-01T23:00:00 start\n"
+            "2015-07-02T01:00:00 landing\n");
+
+  FlightDatabase db;
+  OpenFlightDatabase(db, db_path, log_path);
+  ok1(db.IsOpen());
+  ok1(db.size() == 5);
+  ok1(db.GetLogSize() == File::GetSize(log_path));
+  ok1(MatchesLog(db));
+
+  /* the last N flights */
+  FlightInfo flights[8];
+  ok1(db.ReadLast(flights, 2) == 2);
+  ok1(flights[0].date == BrokenDate(2015, 6, 2));
+  ok1(!flights[0].start_time.IsPlausible());
+  ok1(flights[1].date == BrokenDate(2015, 7, 1));
+  ok1(flights[1].Duration() == 2 * 3600);
+  ok1(db.ReadLast(flights, 8) == 5);
+
+  /* date range */
+  unsigned first;
+  ok1(db.FindRange(BrokenDate(2015, 6, 1), BrokenDate(2015, 6, 2),
+                   first) == 3);
+  ok1(first == 1);
+  ok1(db.FindRange(BrokenDate(2015, 1, 1), BrokenDate(2015, 5, 31),
+                   first) == 0);
+  ok1(db.FindRange(BrokenDate(2000, 1, 1), BrokenDate(2030, 1, 1),
+                   first) == 5);
+  ok1(first == 0);
+
+  /* totals per year */
+  ok1(db.GetYearTotal(2014).flights == 1);
+  ok1(db.GetYearTotal(2014).duration == 9000);
+  ok1(db.GetYearTotal(2015).flights == 4);
+  ok1(db.GetYearTotal(2015).duration == 4 * 3600);
+  ok1(db.GetYearTotal(2016).flights == 0);
+  ok1(db.GetYearTotal(1999).flights == 0);
+}
+
+/**
+ * Append events the way #FlightLogger does, and check that the index
+ * is reused (not rebuilt) and still matches the text log.
+ */
+static void
+TestAppend()
+{
+  static constexpr struct {
+    BrokenDateTime date_time;
+    bool landing;
+    const char *line;
+  } events[] = {
+    { BrokenDateTime(2016, 4, 1, 12, 0, 0), false,
+      "2016-04-01T12:00:00 start\n" },
+    { BrokenDateTime(2016, 4, 1, 15, 30, 0), true,
+      "2016-04-01T15:30:00 landing\n" },
+    { BrokenDateTime(2016, 4, 2, 10, 0, 0), true,
+      "2016-04-02T10:00:00 landing\n" },
+    { BrokenDateTime(2016, 4, 3, 10, 0, 0), false,
+      "2016-04-03T10:00:00 start\n" },
+    { BrokenDateTime(2016, 4, 4, 10, 0, 0), true,
+      "2016-04-04T10:00:00 landing\n" },
+  };
+
+  for (const auto &event : events) {
+    FlightDatabase db;
+    OpenFlightDatabase(db, db_path, log_path);
+
+    const unsigned old_size = db.size();
+    ok1(event.landing
+        ? db.AppendLanding(event.date_time)
+        : db.AppendStart(event.date_time));
+    db.SetLogSize(db.GetLogSize() + strlen(event.line));
+    ok1(db.Commit());
+
+    AppendLog(event.line);
+
+    /* reopening must not rebuild */
+    FlightDatabase db2;
+    ok1(db2.Open(db_path));
+    ok1(db2.GetLogSize() == File::GetSize(log_path));
+    ok1(db2.size() >= old_size);
+    ok1(MatchesLog(db2));
+  }
+
+  FlightDatabase db;
+  OpenFlightDatabase(db, db_path, log_path);
+  ok1(db.size() == 9);
+  ok1(db.GetYearTotal(2016).flights == 4);
+  ok1(db.GetYearTotal(2016).duration == 3 * 3600 + 1800);
+}
+
+static void
+TestRebuild()
+{
+  /* an index record which is not in the text log survives as long as
+     the text log is unchanged ... */
+  {
+    FlightDatabase db;
+    OpenFlightDatabase(db, db_path, log_path);
+    ok1(db.AppendStart(BrokenDateTime(2017, 1, 1, 12, 0, 0)));
+    ok1(db.Commit());
+  }
+
+  {
+    FlightDatabase db;
+    OpenFlightDatabase(db, db_path, log_path);
+    ok1(db.size() == 10);
+  }
+
+  /* ... but the index is rebuilt when the text log changes */
+  AppendLog("2017-02-01T12:00:00 start\n");
+
+  {
+    FlightDatabase db;
+    OpenFlightDatabase(db, db_path, log_path);
+    ok1(db.size() == 10);
+    ok1(MatchesLog(db));
+    ok1(db.GetLogSize() == File::GetSize(log_path));
+  }
+
+  /* a truncated index is rebuilt too */
+  {
+    FILE *file = fopen(db_path.c_str(), "r+b");
+    assert(file != nullptr);
+    fseek(file, 0, SEEK_END);
+    fputc(0, file);
+    fclose(file);
+  }
+
+  FlightDatabase db;
+  ok1(!db.Open(db_path));
+  OpenFlightDatabase(db, db_path, log_path);
+  ok1(MatchesLog(db));
+
+  /* no text log at all: empty index */
+  File::Delete(log_path);
+  OpenFlightDatabase(db, db_path, log_path);
+  ok1(db.empty());
+}
+
+int
+main(int argc, char **argv)
+try {
+  plan_tests(20 + 5 * 6 + 3 + 3 + 3 + 3 + 1);
+
+  TestMigrate();
+  TestAppend();
+  TestRebuild();
+
+  return exit_status();
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "FrameProfiler.hpp"
+#include "IO/OutputStream.hxx"
+#include "IO/BufferedOutputStream.hxx"
+#include "TestUtil.hpp"
+
+#include <string>
+
+#include <string.h>
+
+class StringOutputStream final : public OutputStream {
+public:
+  std::string value;
+
+  void Write(const void *data, size_t size) override {
+    value.append((const char *)data, size);
+  }
+};
+
+static void
+SubmitFrame(uint64_t start, uint32_t a, uint32_t b)
+{
+  const FrameProfiler::Sample samples[] = {
+    { "a", start, a, a / 2 },
+    { "b", start + a, b, b / 2 },
+  };
+
+  FrameProfiler::SubmitFrame(samples, 2);
+}
+
+static void
+TestDisabled()
+{
+  FrameProfiler::SetEnabled(false);
+  ok1(!FrameProfiler::IsEnabled());
+
+  SubmitFrame(0, 1, 1);
+
+  FrameProfiler::LayerStatistics statistics[FrameProfiler::MAX_LAYERS];
+  ok1(FrameProfiler::GetStatistics(statistics,
+                                   FrameProfiler::MAX_LAYERS) == 0);
+}
+
+static void
+TestStatistics()
+{
+  FrameProfiler::SetEnabled(true);
+  ok1(FrameProfiler::IsEnabled());
+
+  for (unsigned i = 1; i <= 100; ++i)
+    SubmitFrame(i * 1000, i, 1000 + i);
+
+  FrameProfiler::LayerStatistics statistics[FrameProfiler::MAX_LAYERS];
+  ok1(FrameProfiler::GetStatistics(statistics,
+                                   FrameProfiler::MAX_LAYERS) == 2);
+
+  ok1(strcmp(statistics[0].name, "a") == 0);
+  ok1(statistics[0].n == 100);
+  ok1(statistics[0].wall.p50 == 50);
+  ok1(statistics[0].wall.p95 == 95);
+  ok1(statistics[0].wall.p99 == 99);
+  ok1(statistics[0].cpu.p99 == 49);
+
+  ok1(strcmp(statistics[1].name, "b") == 0);
+  ok1(statistics[1].wall.p50 == 1050);
+
+  /* the window only keeps the most recent frames */
+  for (unsigned i = 0; i < FrameProfiler::WINDOW; ++i)
+    SubmitFrame(0, 7, 7);
+
+  FrameProfiler::GetStatistics(statistics, FrameProfiler::MAX_LAYERS);
+  ok1(statistics[0].n == FrameProfiler::WINDOW);
+  ok1(statistics[0].wall.p99 == 7);
+
+  /* re-enabling discards old data */
+  FrameProfiler::SetEnabled(false);
+  FrameProfiler::SetEnabled(true);
+  ok1(FrameProfiler::GetStatistics(statistics,
+                                   FrameProfiler::MAX_LAYERS) == 0);
+}
+
+static void
+TestChromeTrace()
+{
+  FrameProfiler::SetEnabled(false);
+  FrameProfiler::SetEnabled(true);
+
+  SubmitFrame(1000, 10, 20);
+
+  StringOutputStream sos;
+  BufferedOutputStream bos(sos);
+  FrameProfiler::ExportChromeTrace(bos);
+  bos.Flush();
+
+  ok1(sos.value ==
+      "{\"traceEvents\":["
+      "{\"name\":\"a\",\"cat\":\"map\",\"ph\":\"X\",\"ts\":1000,\"dur\":10,"
+      "\"pid\":1,\"tid\":1,\"args\":{\"cpu_us\":5}},"
+      "{\"name\":\"b\",\"cat\":\"map\",\"ph\":\"X\",\"ts\":1010,\"dur\":20,"
+      "\"pid\":1,\"tid\":1,\"args\":{\"cpu_us\":10}}"
+      "],\"displayTimeUnit\":\"ms\"}");
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(16);
+
+  TestDisabled();
+  TestStatistics();
+  TestChromeTrace();
+
+  return exit_status();
+}
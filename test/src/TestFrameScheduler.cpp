@@ -0,0 +1,145 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "FrameScheduler.hpp"
+#include "TestUtil.hpp"
+
+/**
+ * Draw one frame which starts at the given time and takes the given
+ * number of milliseconds.
+ */
+static unsigned
+Frame(FrameScheduler &scheduler, unsigned now, unsigned cost)
+{
+  scheduler.BeginFrame(now);
+  scheduler.EndFrame(now + cost);
+  return now + cost;
+}
+
+static void
+TestPacing()
+{
+  FrameScheduler scheduler(100, 50);
+  ok1(scheduler.GetDelay(0) == 0);
+
+  Frame(scheduler, 1000, 10);
+  ok1(scheduler.GetDelay(1010) == 90);
+  ok1(scheduler.GetDelay(1099) == 1);
+  ok1(scheduler.GetDelay(1100) == 0);
+  ok1(scheduler.GetDelay(5000) == 0);
+
+  /* the clock wraps around */
+  Frame(scheduler, unsigned(-20), 10);
+  ok1(scheduler.GetDelay(unsigned(-10)) == 90);
+  ok1(scheduler.GetDelay(70) == 10);
+}
+
+static void
+TestDegrade()
+{
+  FrameScheduler scheduler(0, 50);
+  unsigned now = 1000;
+
+  /* one expensive frame is not enough */
+  now = Frame(scheduler, now, 200);
+  ok1(scheduler.GetLevel() == 0);
+  ok1(scheduler.GetAverageCost() == 200);
+
+  now = Frame(scheduler, now, 100);
+  ok1(scheduler.GetLevel() == 1);
+  ok1(scheduler.IsDegraded());
+  ok1(scheduler.GetAverageCost() == 0);
+
+  /* cheap frames mixed with expensive ones keep the average low */
+  now = Frame(scheduler, now, 80);
+  now = Frame(scheduler, now, 10);
+  ok1(scheduler.GetLevel() == 1);
+
+  /* never degrade beyond MAX_LEVEL */
+  for (unsigned i = 0; i < 20; ++i)
+    now = Frame(scheduler, now, 500);
+  ok1(scheduler.GetLevel() == FrameScheduler::MAX_LEVEL);
+}
+
+static void
+TestRestore()
+{
+  FrameScheduler scheduler(0, 50);
+  unsigned now = 1000;
+
+  now = Frame(scheduler, now, 100);
+  now = Frame(scheduler, now, 100);
+  now = Frame(scheduler, now, 100);
+  now = Frame(scheduler, now, 100);
+  ok1(scheduler.GetLevel() == 2);
+
+  /* a full window of cheap frames restores one level */
+  for (unsigned i = 0; i < FrameScheduler::WINDOW - 1; ++i)
+    now = Frame(scheduler, now, 10);
+  ok1(scheduler.GetLevel() == 2);
+  now = Frame(scheduler, now, 10);
+  ok1(scheduler.GetLevel() == 1);
+
+  /* a frame near the budget in the window prevents restoring */
+  now = Frame(scheduler, now, 40);
+  for (unsigned i = 0; i < FrameScheduler::WINDOW - 1; ++i)
+    now = Frame(scheduler, now, 10);
+  ok1(scheduler.GetLevel() == 1);
+
+  /* the window slides; the 40 ms frame has expired now */
+  now = Frame(scheduler, now, 10);
+  ok1(scheduler.GetLevel() == 0);
+  ok1(!scheduler.IsDegraded());
+}
+
+static void
+TestIdle()
+{
+  FrameScheduler scheduler(0, 50);
+  unsigned now = 1000;
+
+  now = Frame(scheduler, now, 100);
+  now = Frame(scheduler, now, 100);
+  ok1(scheduler.GetLevel() == 1);
+
+  /* a short pause doesn't change the level */
+  now = Frame(scheduler, now + 100, 10);
+  ok1(scheduler.GetLevel() == 1);
+
+  /* after a long pause, the next frame is drawn at full quality */
+  scheduler.BeginFrame(now + FrameScheduler::IDLE_TIME);
+  ok1(scheduler.GetLevel() == 0);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(23);
+
+  TestPacing();
+  TestDegrade();
+  TestRestore();
+  TestIdle();
+
+  return exit_status();
+}
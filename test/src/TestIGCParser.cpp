@@ -25,11 +25,15 @@
 #include "IGC/IGCFix.hpp"
 #include "IGC/IGCHeader.hpp"
 #include "IGC/IGCDeclaration.hpp"
+#include "IGC/IGCFileReader.hpp"
+#include "OS/Path.hpp"
 #include "Time/BrokenDate.hpp"
 #include "Time/BrokenTime.hpp"
 #include "TestUtil.hpp"
 
+#include <stdio.h>
 #include <string.h>
+#include <tchar.h>
 
 static void
 TestHeader()
@@ -172,6 +176,127 @@ TestFix()
   ok1(fix.gps_altitude == 7);
 }
 
+static void
+TestFixSigned()
+{
+  IGCExtensions extensions;
+  extensions.clear();
+
+  IGCFix fix;
+  ok1(IGCParseFix("B1122385103117N00742367EA-0012-0007", extensions, fix));
+  ok1(fix.pressure_altitude == -12);
+  ok1(fix.gps_altitude == -7);
+
+  ok1(!IGCParseFix("B1122385103117N00742367EA00-1200007", extensions, fix));
+  ok1(!IGCParseFix("B1122385103117N00742367EA 0012 0007", extensions, fix));
+}
+
+static void
+TestFixExtensions()
+{
+  IGCExtensions extensions;
+  ok1(IGCParseExtensions("I063636TDS3738SIU3941ENL4244GSP4548VAT4951XYZ",
+                         extensions));
+  ok1(extensions.size() == 6);
+  ok1(extensions[0].type == IGCExtension::Type::TDS);
+  ok1(extensions[1].type == IGCExtension::Type::SIU);
+  ok1(extensions[2].type == IGCExtension::Type::ENL);
+  ok1(extensions[3].type == IGCExtension::Type::GSP);
+  ok1(extensions[4].type == IGCExtension::Type::VAT);
+  ok1(extensions[5].type == IGCExtension::Type::UNKNOWN);
+
+  IGCFix fix;
+  ok1(IGCParseFix("B1122385103117N00742367EA0049000487"
+                  "708123054-012999", extensions, fix));
+  ok1(fix.tds == 7);
+  ok1(fix.siu == 8);
+  ok1(fix.enl == 123);
+  ok1(fix.gsp == 54);
+  ok1(fix.vat == -12);
+
+  /* the record does not need to be null-terminated; columns beyond
+     the given length are ignored */
+  static constexpr char buffer[] =
+    "B1122385103117N00742367EA00490004877081230540123999";
+  ok1(IGCParseFix(buffer, 41, extensions, fix));
+  ok1(fix.enl == 123);
+  ok1(fix.gsp < 0);
+  ok1(fix.vat == IGCFix::VAT_UNDEFINED);
+
+  ok1(IGCParseFix(buffer, 48, extensions, fix));
+  ok1(fix.gsp == 54);
+  ok1(fix.vat == 123);
+
+  ok1(!IGCParseFix(buffer, 34, extensions, fix));
+}
+
+static void
+TestFileReader()
+{
+  const Path path(_T("output/test/reader.igc"));
+
+  FILE *file = fopen(path.c_str(), "wb");
+  ok1(file != nullptr);
+  if (file == nullptr) {
+    skip(13, 0, "failed to create file");
+    return;
+  }
+
+  fputs("AXCSfoo\r\n"
+        "HFDTE040910\r\n"
+        "I023636TDS3738SIU\r\n"
+        "B1122385103117N00742367EA0049000487305\r\n"
+        "LXCSnot a fix\r\n"
+        "B11223X5103117N00742367EA0049000487305\r\n"
+        "\r\n"
+        "B1122395103117N00742367EV0049100488006\n"
+        "B1122405103117S00742367WA0049200489907", file);
+  fclose(file);
+
+  IGCFileReader reader(path);
+  ok1(reader.GetSize() > 0);
+  ok1(!reader.GetDate().IsPlausible());
+
+  IGCFix fix;
+  ok1(reader.Next(fix));
+  ok1(reader.GetDate() == BrokenDate(2010, 9, 4));
+  ok1(reader.GetExtensions().size() == 2);
+  ok1(fix.time == BrokenTime(11, 22, 38) && fix.tds == 3 && fix.siu == 5);
+
+  ok1(reader.Next(fix));
+  ok1(fix.time == BrokenTime(11, 22, 39) && !fix.gps_valid &&
+      fix.tds == 0 && fix.siu == 6);
+
+  ok1(reader.Next(fix));
+  ok1(fix.time == BrokenTime(11, 22, 40) && fix.tds == 9 && fix.siu == 7);
+  ok1(equals(fix.location, -51.05195, -7.70611667));
+
+  ok1(!reader.Next(fix));
+  ok1(reader.Tell() == reader.GetSize());
+}
+
+static void
+TestEmptyFileReader()
+{
+  const Path path(_T("output/test/empty.igc"));
+
+  FILE *file = fopen(path.c_str(), "wb");
+  ok1(file != nullptr);
+  if (file == nullptr) {
+    skip(3, 0, "failed to create file");
+    return;
+  }
+
+  fclose(file);
+
+  IGCFileReader reader(path);
+  ok1(reader.GetSize() == 0);
+
+  IGCFix fix;
+  ok1(!reader.Next(fix));
+  ok1(reader.Tell() == 0);
+}
+
 static void
 TestFixTime()
 {
@@ -252,13 +377,17 @@ TestDeclarationTurnpoint()
 
 int main(int argc, char **argv)
 {
-  plan_tests(136);
+  plan_tests(136 + 5 + 22 + 14 + 4);
 
   TestHeader();
   TestDate();
   TestLocation();
   TestExtensions();
   TestFix();
+  TestFixSigned();
+  TestFixExtensions();
+  TestFileReader();
+  TestEmptyFileReader();
   TestFixTime();
   TestDeclarationHeader();
   TestDeclarationTurnpoint();
@@ -0,0 +1,119 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Renderer/LabelBlock.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+#include <stdlib.h>
+
+static PixelRect
+RandomRect()
+{
+  const int x = rand() % 900 - 50, y = rand() % 700 - 50;
+  return PixelRect(x, y, x + 10 + rand() % 120, y + 8 + rand() % 20);
+}
+
+/**
+ * Compare with a brute force implementation.
+ */
+static bool
+TestRandom(LabelBlock &lb)
+{
+  std::vector<PixelRect> placed;
+
+  lb.reset();
+  for (unsigned i = 0; i < 500; ++i) {
+    const PixelRect rc = RandomRect();
+
+    bool expected = true;
+    for (const auto &p : placed)
+      if (p.OverlapsWith(rc))
+        expected = false;
+
+    if (lb.check(rc) != expected)
+      return false;
+
+    if (expected)
+      placed.push_back(rc);
+  }
+
+  return true;
+}
+
+static void
+TestPersistence()
+{
+  LabelBlock lb;
+
+  const PixelRect a(10, 10, 60, 30), b(100, 10, 150, 30);
+  const PixelRect c(40, 20, 120, 40);
+
+  ok1(lb.check(a, 1));
+  ok1(lb.check(b, 2));
+  ok1(!lb.check(c, 3));
+  ok1(!lb.WasVisible(1));
+
+  lb.reset();
+  ok1(lb.WasVisible(1));
+  ok1(lb.WasVisible(2));
+  ok1(!lb.WasVisible(3));
+
+  /* unchanged labels are accepted again */
+  ok1(lb.check(b, 2));
+  ok1(lb.check(a, 1));
+
+  /* a duplicate id must not skip the collision test */
+  ok1(!lb.check(a, 1));
+
+  /* a label which was not visible is tested */
+  ok1(!lb.check(c, 3));
+
+  /* a moved label is tested */
+  lb.reset();
+  ok1(lb.check(c, 3));
+  ok1(!lb.check(a, 1));
+  ok1(!lb.WasVisible(3));
+
+  lb.reset();
+  ok1(lb.WasVisible(3));
+  ok1(!lb.WasVisible(1));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(21);
+
+  LabelBlock lb;
+  ok1(lb.check(PixelRect(0, 0, 10, 10)));
+  ok1(!lb.check(PixelRect(10, 10, 20, 20)));
+  ok1(lb.check(PixelRect(-100, -100, -20, -20)));
+  ok1(!lb.check(PixelRect(-30, -30, 1, 1)));
+
+  ok1(TestRandom(lb));
+
+  TestPersistence();
+
+  return exit_status();
+}
@@ -0,0 +1,97 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Time/LatencyHistogram.hpp"
+#include "TestUtil.hpp"
+
+static void
+TestBuckets()
+{
+  ok1(LatencyHistogram::FindBucket(0) == 0);
+  ok1(LatencyHistogram::FindBucket(249) == 0);
+  ok1(LatencyHistogram::FindBucket(250) == 1);
+  ok1(LatencyHistogram::FindBucket(999) == 2);
+  ok1(LatencyHistogram::FindBucket(1000) == 3);
+  ok1(LatencyHistogram::FindBucket(UINT32_MAX) ==
+      LatencyHistogram::N_BUCKETS - 1);
+}
+
+static void
+TestSummary()
+{
+  LatencyHistogram h;
+  ok1(h.IsEmpty());
+  ok1(h.GetSummary().n == 0);
+  ok1(h.GetSummary().max_us == 0);
+
+  for (unsigned i = 1; i <= 100; ++i)
+    h.Add(i * 100);
+
+  const auto s = h.GetSummary();
+  ok1(s.n == 100);
+  ok1(s.mean_us == 5050);
+  ok1(s.p50_us == 5000);
+  ok1(s.p95_us == 9500);
+  ok1(s.max_us == 10000);
+
+  ok1(h.GetBucket(0) == 2);
+  ok1(h.GetBucket(1) == 2);
+}
+
+static void
+TestWindow()
+{
+  LatencyHistogram h;
+
+  /* fill the window with large samples */
+  for (unsigned i = 0; i < LatencyHistogram::WINDOW; ++i)
+    h.Add(1000000);
+
+  ok1(h.GetSize() == LatencyHistogram::WINDOW);
+  ok1(h.GetBucket(LatencyHistogram::N_BUCKETS - 1) ==
+      LatencyHistogram::WINDOW);
+
+  /* now replace all of them with small ones */
+  for (unsigned i = 0; i < LatencyHistogram::WINDOW; ++i)
+    h.Add(100);
+
+  ok1(h.GetSize() == LatencyHistogram::WINDOW);
+  ok1(h.GetBucket(LatencyHistogram::N_BUCKETS - 1) == 0);
+  ok1(h.GetBucket(0) == LatencyHistogram::WINDOW);
+  ok1(h.GetSummary().max_us == 100);
+
+  h.Clear();
+  ok1(h.IsEmpty());
+  ok1(h.GetBucket(0) == 0);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(24);
+
+  TestBuckets();
+  TestSummary();
+  TestWindow();
+
+  return exit_status();
+}
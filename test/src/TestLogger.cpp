@@ -21,6 +21,8 @@
 */
 
 #include "IGC/IGCWriter.hpp"
+#include "IGC/AsyncIGCWriter.hpp"
+#include "IGC/IGCBRecord.hpp"
 #include "OS/FileUtil.hpp"
 #include "NMEA/Info.hpp"
 #include "IO/FileLineReader.hpp"
@@ -85,15 +87,14 @@ static const char *const expect[] = {
   NULL
 };
 
+static const GeoPoint home(Angle::Degrees(7.7061111111111114),
+                           Angle::Degrees(51.051944444444445));
+static const GeoPoint tp(Angle::Degrees(10.726111111111111),
+                         Angle::Degrees(50.6322));
+
 static void
-Run(IGCWriter &writer)
+MakeFix(NMEAInfo &i)
 {
-  static const GeoPoint home(Angle::Degrees(7.7061111111111114),
-                             Angle::Degrees(51.051944444444445));
-  static const GeoPoint tp(Angle::Degrees(10.726111111111111),
-                           Angle::Degrees(50.6322));
-
-  static NMEAInfo i;
   i.clock = 1;
   i.time = 1;
   i.time_available.Update(i.clock);
@@ -109,7 +110,11 @@ Run(IGCWriter &writer)
   i.gps_altitude_available.Update(i.clock);
   i.ProvidePressureAltitude(490);
   i.ProvideBaroAltitudeTrue(400);
+}
 
+static void
+WriteHeader(IGCWriter &writer, const NMEAInfo &i)
+{
   writer.WriteHeader(i.date_time_utc, _T("Pilot Name"), _T("ASK-21"),
                      _T("D-1234"), _T("34"), "FOO", _T("bar"), false);
   writer.StartDeclaration(i.date_time_utc, 3);
@@ -117,7 +122,12 @@ Run(IGCWriter &writer)
   writer.AddDeclaration(tp, _T("Suhl"));
   writer.AddDeclaration(home, _T("Bergneustadt"));
   writer.EndDeclaration();
+}
 
+template<typename W>
+static void
+WriteRecords(W &writer, NMEAInfo &i)
+{
   writer.LogEmptyFRecord(i.date_time_utc);
 
   i.date_time_utc.second += 5;
@@ -141,6 +151,17 @@ Run(IGCWriter &writer)
   i.location = GeoPoint(Angle::Degrees(-7.7061111111111114),
                         Angle::Degrees(-51.051944444444445));
   writer.LogPoint(i);
+}
+
+static void
+Run(Path path)
+{
+  static NMEAInfo i;
+  MakeFix(i);
+
+  IGCWriter writer(path);
+  WriteHeader(writer, i);
+  WriteRecords(writer, i);
 
   writer.Flush();
   writer.Sign();
@@ -148,26 +169,143 @@ Run(IGCWriter &writer)
 }
 
 static void
-Run(Path path)
+RunAsync(Path path, bool start)
 {
-  IGCWriter writer(path);
-  Run(writer);
+  static NMEAInfo i;
+  MakeFix(i);
+
+  AsyncIGCWriter writer(path);
+  WriteHeader(writer.GetWriter(), i);
+
+  if (start)
+    ok1(writer.Start());
+
+  WriteRecords(writer, i);
+  writer.Stop(true);
+
+  ok1(writer.GetDroppedCount() == 0);
 }
 
-int main(int argc, char **argv)
-try {
-  plan_tests(49);
+static unsigned
+CountBRecords(Path path)
+{
+  FileLineReaderA reader(path);
 
-  const Path path(_T("output/test/test.igc"));
-  File::Delete(path);
+  unsigned n = 0;
+  const char *line;
+  while ((line = reader.ReadLine()) != NULL)
+    if (*line == 'B')
+      ++n;
 
-  Run(path);
+  return n;
+}
+
+/**
+ * Without a writer thread (e.g. because it failed to start), records
+ * must be written right away instead of overflowing the queue.
+ */
+static void
+TestNoThread(Path path)
+{
+  constexpr unsigned n = AsyncIGCWriter::QUEUE_SIZE + 100;
 
+  static NMEAInfo i;
+  MakeFix(i);
+
+  AsyncIGCWriter writer(path);
+  WriteHeader(writer.GetWriter(), i);
+
+  for (unsigned j = 0; j < n; ++j) {
+    i.date_time_utc.second = j % 60;
+    writer.LogPoint(i);
+  }
+
+  ok1(writer.GetDroppedCount() == 0);
+  ok1(CountBRecords(path) == n);
+
+  writer.Stop(false);
+  ok1(CountBRecords(path) == n);
+}
+
+static void
+TestHighRate()
+{
+  char buffer[128];
+
+  IGCHighRateBRecord::FormatIRecord(buffer);
+  ok1(strcmp(buffer, "I063638FXA3940SIU4143ENL4444TDS4547TAS4851VAT") == 0);
+
+  IGCFix fix;
+  fix.Clear();
+  fix.time = BrokenTime(11, 22, 33);
+  fix.location = home;
+  fix.gps_valid = true;
+  fix.gps_altitude = 487;
+  fix.pressure_altitude = -12;
+  fix.enl = 12;
+  fix.tds = 3;
+  fix.tas = 123;
+  fix.vat = -15;
+
+  IGCHighRateBRecord::Format(buffer, fix, 50, 7);
+  ok1(strcmp(buffer, "B1122335103117N00742367EA-001200487"
+             "050" "07" "012" "3" "123" "-015") == 0);
+  ok1(strlen(buffer) == IGCHighRateBRecord::LENGTH);
+
+  /* out-of-range values are clipped, undefined ones are zero */
+  fix.gps_altitude = 123456;
+  fix.enl = -1;
+  fix.tas = -1;
+  fix.vat = IGCFix::VAT_UNDEFINED;
+  IGCHighRateBRecord::Format(buffer, fix, 1234, 7);
+  ok1(strcmp(buffer, "B1122335103117N00742367EA-001299999"
+             "999" "07" "000" "3" "000" "0000") == 0);
+
+  /* tenths of the second come from the fractional time of day */
+  static NMEAInfo i;
+  MakeFix(i);
+
+  i.time = 1.3;
+  ok1(fix.Apply(i) && fix.tds == 3);
+  i.time = 1.96;
+  ok1(fix.Apply(i) && fix.tds == 9);
+  i.time = 2;
+  ok1(fix.Apply(i) && fix.tds == 0);
+}
+
+static void
+Check(Path path)
+{
   CheckTextFile(path, expect);
 
   GRecord grecord;
   grecord.Initialize();
   grecord.VerifyGRecordInFile(path);
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(49 * 3 + 3 + 3 + 7);
+
+  const Path path(_T("output/test/test.igc"));
+  File::Delete(path);
+  Run(path);
+  Check(path);
+
+  /* the same records must come out of the writer thread ... */
+  File::Delete(path);
+  RunAsync(path, true);
+  Check(path);
+
+  /* ... and out of Stop() if there is no thread */
+  File::Delete(path);
+  RunAsync(path, false);
+  Check(path);
+
+  File::Delete(path);
+  TestNoThread(path);
+
+  TestHighRate();
 
   return exit_status();
 } catch (const std::runtime_error &e) {
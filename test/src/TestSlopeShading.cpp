@@ -0,0 +1,195 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Terrain/SlopeShading.hpp"
+#include "Util/Macros.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <assert.h>
+#include <stdlib.h>
+
+/* not a multiple of 8, to exercise the scalar tail of
+   CalculateSlopeRow() */
+static constexpr unsigned WIDTH = 203, HEIGHT = 70;
+
+/**
+ * Random terrain with steep slopes; most height differences are
+ * clipped by ClipHeightDelta().
+ */
+static std::vector<TerrainHeight>
+GenerateRandom()
+{
+  std::vector<TerrainHeight> heights;
+  heights.reserve(WIDTH * HEIGHT);
+  for (unsigned i = 0; i < WIDTH * HEIGHT; ++i)
+    heights.push_back(TerrainHeight(int16_t(rand() % 11000 - 2000)));
+  return heights;
+}
+
+/**
+ * A checkerboard of cliffs, the steepest possible slope in every
+ * pixel.
+ */
+static std::vector<TerrainHeight>
+GenerateCliffs()
+{
+  std::vector<TerrainHeight> heights;
+  heights.reserve(WIDTH * HEIGHT);
+  for (unsigned y = 0; y < HEIGHT; ++y)
+    for (unsigned x = 0; x < WIDTH; ++x)
+      heights.push_back(TerrainHeight(int16_t(((x / 3 + y / 2) % 2) * 9000)));
+  return heights;
+}
+
+/**
+ * Compare CalculateSlopeRow() with CalculateSlopeRowScalar() the way
+ * RasterRenderer::GenerateSlopeImage() calls them.
+ *
+ * @return the number of pixels which differ
+ */
+static unsigned
+Compare(const std::vector<TerrainHeight> &heights, unsigned q,
+        unsigned height_slope_factor, const SlopeShadingParameters &p)
+{
+  std::vector<int8_t> a(WIDTH), b(WIDTH);
+  unsigned n_different = 0;
+
+  for (unsigned y = 0; y < HEIGHT; ++y) {
+    const unsigned row_plus_index = y < HEIGHT - q ? q : HEIGHT - 1 - y;
+    const unsigned row_minus_index = y >= q ? q : y;
+    const unsigned p31 = row_plus_index + row_minus_index;
+    const unsigned dd2 = 2 * q * p31 * height_slope_factor;
+
+    const TerrainHeight *src = heights.data() + y * WIDTH + q;
+    const unsigned n = WIDTH - 2 * q;
+
+    CalculateSlopeRowScalar(a.data(), src, n, q,
+                            WIDTH * row_minus_index, WIDTH * row_plus_index,
+                            p31, dd2, p);
+    CalculateSlopeRow(b.data(), src, n, q,
+                      WIDTH * row_minus_index, WIDTH * row_plus_index,
+                      p31, dd2, p);
+
+    for (unsigned x = 0; x < n; ++x)
+      if (a[x] != b[x])
+        ++n_different;
+  }
+
+  return n_different;
+}
+
+static unsigned
+Compare(const std::vector<TerrainHeight> &heights, unsigned q)
+{
+  static constexpr SlopeShadingParameters parameters[] = {
+    { -120, -150, 180, 220 },
+    { 255, 255, 10, 255 },
+    { -255, 250, 0, 128 },
+    { -255, -250, 10, 255 },
+    { 0, -255, 255, 64 },
+  };
+
+  /* the range of height_slope_factor in GenerateSlopeImage() */
+  const unsigned max_factor = std::max(8192u / (q * q), 1u);
+
+  unsigned n_different = 0;
+  for (const auto &p : parameters)
+    for (unsigned factor : { 1u, (max_factor + 1) / 2, max_factor })
+      n_different += Compare(heights, q, factor, p);
+
+  return n_different;
+}
+
+/**
+ * Compare all combinations of clipped height differences, eight
+ * pixels at a time.  The neighbours of the eight pixels must not
+ * overlap, therefore #q must be at least 4.
+ *
+ * @return the number of pixels which differ
+ */
+static unsigned
+CompareAll(unsigned q, const SlopeShadingParameters &p)
+{
+  assert(q >= 4);
+
+  const unsigned p31 = 2 * q;
+  const unsigned dd2 = 2 * q * p31 * std::max(8192u / (q * q), 1u);
+
+  /* left and right neighbours in row 1, above in row 0, below in
+     row 2 */
+  const unsigned stride = 2 * q + 8;
+  TerrainHeight heights[3 * stride];
+  std::fill_n(heights, 3 * stride, TerrainHeight(0));
+  const TerrainHeight *src = heights + stride + q;
+  TerrainHeight *right = heights + stride + 2 * q;
+  TerrainHeight *above = heights + q;
+
+  int8_t a[8], b[8];
+  unsigned n_different = 0;
+
+  for (int p32 = -520; p32 <= 520; ++p32) {
+    std::fill_n(above, 8, TerrainHeight(p32));
+
+    for (int p22 = -520; p22 <= 520; p22 += 8) {
+      for (unsigned i = 0; i < 8; ++i)
+        right[i] = TerrainHeight(p22 + i);
+
+      CalculateSlopeRowScalar(a, src, 8, q, stride, stride, p31, dd2, p);
+      CalculateSlopeRow(b, src, 8, q, stride, stride, p31, dd2, p);
+
+      for (unsigned i = 0; i < 8; ++i)
+        if (a[i] != b[i])
+          ++n_different;
+    }
+  }
+
+  return n_different;
+}
+
+int main(int argc, char **argv)
+{
+  static constexpr unsigned quantisations[] = { 1, 2, 3, 4, 8, 16, 32 };
+  static constexpr unsigned all_quantisations[] = { 4, 16, 32 };
+
+  plan_tests(2 * ARRAY_SIZE(quantisations) + ARRAY_SIZE(all_quantisations));
+
+  const auto random = GenerateRandom();
+  const auto cliffs = GenerateCliffs();
+
+  /* the vectorised kernels must be exact, even for steep slopes and
+     a large column_distance */
+  for (unsigned q : quantisations) {
+    ok(Compare(random, q) == 0, "random terrain, q=%u", q);
+    ok(Compare(cliffs, q) == 0, "cliffs, q=%u", q);
+  }
+
+  for (unsigned q : all_quantisations)
+    ok(CompareAll(q, { -255, -250, 10, 255 }) == 0 &&
+       CompareAll(q, { 120, -150, 180, 220 }) == 0,
+       "all slopes, q=%u", q);
+
+  return exit_status();
+}
@@ -0,0 +1,208 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Screen/Memory/TileRasterizer.hpp"
+#include "Screen/Memory/SDLRasterCanvas.hpp"
+#include "Screen/Memory/Optimised.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+#include <string.h>
+
+using Buffer = WritableImageBuffer<ActivePixelTraits>;
+
+static constexpr unsigned WIDTH = 97, HEIGHT = 203;
+
+/**
+ * Extra rows above and below the reference buffer, which is used to
+ * check the clipping of polygons extending beyond the buffer.
+ */
+static constexpr unsigned MARGIN = 128;
+
+struct TestPolygon {
+  Color color;
+  std::vector<BulkPixelPoint> points;
+};
+
+static std::vector<TestPolygon> polygons;
+
+static void
+AddPolygon(Color color, std::initializer_list<BulkPixelPoint> points)
+{
+  polygons.push_back({color, points});
+}
+
+/**
+ * Build a set of overlapping polygons, some of them spanning tile
+ * seams, some partially or completely outside of the buffer.
+ */
+static void
+MakePolygons()
+{
+  /* larger than the buffer in all directions */
+  AddPolygon(Color(0xff, 0, 0), {{-20, -30}, {120, 40}, {10, 250}});
+
+  /* spans several tile seams, translucent */
+  AddPolygon(Color(0, 0xff, 0, 0x80),
+             {{5, 40}, {90, 45}, {80, 120}, {10, 110}});
+
+  /* completely above and completely below the buffer */
+  AddPolygon(Color(0, 0, 0xff), {{0, -50}, {50, -10}, {20, -5}});
+  AddPolygon(Color(0, 0, 0xff), {{0, 210}, {50, 300}, {20, 250}});
+
+  /* clipped both above and below */
+  AddPolygon(Color(0xff, 0xff, 0, 0xc8),
+             {{30, -100}, {70, -100}, {60, 400}, {20, 400}});
+
+  /* a thin vertical sliver crossing all seams */
+  AddPolygon(Color(0, 0, 0), {{48, 0}, {49, 0}, {49, 202}, {48, 202}});
+
+  /* self-intersecting star */
+  AddPolygon(Color(0, 0, 0xff, 0x40),
+             {{50, 90}, {60, 160}, {20, 120}, {80, 120}, {40, 160}});
+
+  /* off to the left and right */
+  AddPolygon(Color(0xff, 0, 0xff), {{-50, 60}, {150, 70}, {100, 80}});
+
+  /* pseudo-random triangles with a fixed seed */
+  unsigned seed = 42;
+  auto random = [&seed](int min, int max){
+    seed = seed * 1103515245 + 12345;
+    return min + int((seed >> 16) % unsigned(max - min + 1));
+  };
+
+  for (unsigned i = 0; i < 64; ++i) {
+    const Color color(random(0, 255), random(0, 255), random(0, 255),
+                      i % 3 == 0 ? random(0, 255) : 0xff);
+
+    std::vector<BulkPixelPoint> points;
+    for (unsigned j = 0; j < 3; ++j)
+      points.emplace_back(random(-60, WIDTH + 60),
+                          random(-100, HEIGHT + 100));
+
+    polygons.push_back({color, std::move(points)});
+  }
+}
+
+static Buffer
+NewBuffer(unsigned height)
+{
+  Buffer buffer;
+  buffer.Allocate(WIDTH, height);
+  memset(buffer.data, 0x55, buffer.pitch * buffer.height);
+  return buffer;
+}
+
+static bool
+Equals(Buffer a, unsigned a_y, Buffer b)
+{
+  const size_t row_size = WIDTH * sizeof(ActivePixelTraits::color_type);
+
+  for (unsigned y = 0; y < b.height; ++y)
+    if (memcmp(a.At(0, a_y + y), b.At(0, y), row_size) != 0)
+      return false;
+
+  return true;
+}
+
+/**
+ * Draw the polygons directly, the same way Canvas::DrawPolygon()
+ * does, shifted down by the given number of rows.
+ */
+static void
+DrawDirect(Buffer buffer, int dy)
+{
+  SDLRasterCanvas canvas(buffer);
+  std::vector<BulkPixelPoint> points;
+
+  for (const auto &polygon : polygons) {
+    points = polygon.points;
+    for (auto &p : points)
+      p.y += dy;
+
+    const auto color = canvas.Import(polygon.color);
+    if (polygon.color.IsOpaque())
+      canvas.FillPolygon(points.data(), points.size(), color);
+    else
+      canvas.FillPolygon(points.data(), points.size(), color,
+                         AlphaPixelOperations<ActivePixelTraits>(polygon.color.Alpha()));
+  }
+}
+
+static void
+Record(TileRasterizer &tiles, unsigned begin, unsigned end)
+{
+  for (unsigned i = begin; i < end; ++i)
+    tiles.AddPolygon(polygons[i].points.data(), polygons[i].points.size(),
+                     polygons[i].color);
+}
+
+static void
+DrawTiled(Buffer buffer, unsigned n_workers)
+{
+  TileRasterizer tiles(n_workers);
+  Record(tiles, 0, polygons.size());
+  tiles.Flush(buffer);
+  ok1(tiles.IsEmpty());
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(1 + 2 * (TileRasterizer::MAX_WORKERS + 1) + 1);
+
+  MakePolygons();
+
+  Buffer direct = NewBuffer(HEIGHT);
+  DrawDirect(direct, 0);
+
+  /* clipping: the same polygons drawn into a taller buffer must
+     produce the same pixels in the visible rows */
+  Buffer reference = NewBuffer(HEIGHT + 2 * MARGIN);
+  DrawDirect(reference, MARGIN);
+  ok1(Equals(reference, MARGIN, direct));
+  reference.Free();
+
+  for (unsigned n_workers = 0; n_workers <= TileRasterizer::MAX_WORKERS;
+       ++n_workers) {
+    Buffer tiled = NewBuffer(HEIGHT);
+    DrawTiled(tiled, n_workers);
+    ok1(Equals(tiled, 0, direct));
+    tiled.Free();
+  }
+
+  /* the workers are reused by subsequent Flush() calls */
+  Buffer tiled = NewBuffer(HEIGHT);
+  TileRasterizer tiles(TileRasterizer::MAX_WORKERS);
+  const unsigned half = polygons.size() / 2;
+  Record(tiles, 0, half);
+  tiles.Flush(tiled);
+  Record(tiles, half, polygons.size());
+  tiles.Flush(tiled);
+  ok1(Equals(tiled, 0, direct));
+  tiled.Free();
+
+  direct.Free();
+
+  return exit_status();
+}
@@ -27,6 +27,10 @@
 #include "OS/ConvertPathName.hpp"
 #include "Engine/Trace/Trace.hpp"
 #include "Engine/Trace/Vector.hpp"
+#include "Computer/TraceComputer.hpp"
+#include "Computer/Settings.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
 #include "Printing.hpp"
 #include "TestUtil.hpp"
 #include "Util/PrintException.hxx"
@@ -83,14 +87,149 @@ TestTrace(Path filename, unsigned ntrace, bool output=false)
   return true;
 }
 
+/**
+ * Generate a trace point; odd points are close to their predecessor,
+ * even points are far away.
+ */
+static GeoPoint
+MakeLocation(unsigned i)
+{
+  return GeoPoint(Angle::Degrees(7 + (i % 7) * 0.001),
+                  Angle::Degrees(51 + (i / 2) * 0.0055 + (i % 2) * 0.0005));
+}
+
+static unsigned
+MakeTime(unsigned i)
+{
+  return 1000 + 2 * i;
+}
+
+static TracePoint
+MakePoint(unsigned i)
+{
+  return TracePoint(MakeLocation(i), MakeTime(i), 1000, 0, 0);
+}
+
+static bool
+Equals(const TracePointVector &a, const TracePointVector &b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (unsigned i = 0; i < a.size(); ++i)
+    if (a[i].GetTime() != b[i].GetTime() ||
+        a[i].GetLocation() != b[i].GetLocation())
+      return false;
+
+  return true;
+}
+
+static void
+TestSyncPoints()
+{
+  Trace trace(0, Trace::null_time, 256);
+  for (unsigned i = 0; i < 50; ++i)
+    trace.push_back(MakePoint(i));
+
+  const unsigned range = trace.ProjectRange(MakeLocation(0), 200);
+
+  TracePointVector v;
+  trace.GetPoints(v, 0, range);
+  ok1(!v.empty() && v.size() < trace.size());
+
+  /* no new points */
+  const TracePointVector old = v;
+  trace.SyncPoints(v, range);
+  ok1(Equals(v, old));
+
+  /* appending must give the same result as a fresh GetPoints() */
+  for (unsigned i = 50; i < 120; ++i)
+    trace.push_back(MakePoint(i));
+
+  trace.SyncPoints(v, range);
+  ok1(v.size() > old.size());
+
+  TracePointVector fresh;
+  trace.GetPoints(fresh, 0, range);
+  ok1(Equals(v, fresh));
+}
+
+static void
+Update(TraceComputer &computer, unsigned time, const GeoPoint &location)
+{
+  static ComputerSettings settings;
+  static MoreData basic;
+  static DerivedInfo calculated;
+
+  basic.time = time;
+  basic.time_available.Update(basic.time);
+  basic.location = location;
+  basic.location_available.Update(basic.time);
+  basic.gps_altitude = 1000;
+  basic.gps_altitude_available.Update(basic.time);
+  basic.nav_altitude = basic.gps_altitude;
+  calculated.flight.flying = true;
+
+  computer.Update(settings, basic, calculated);
+}
+
+static void
+TestLockedSyncTo()
+{
+  TraceComputer computer;
+  for (unsigned i = 0; i < 50; ++i)
+    Update(computer, MakeTime(i), MakeLocation(i));
+
+  const GeoPoint location = MakeLocation(0);
+  TracePointVector v, fresh;
+  Serial serial;
+  unsigned range = 0;
+
+  /* the first call loads everything */
+  ok1(computer.LockedSyncTo(v, 0, location, 200, serial, range));
+  computer.LockedCopyTo(fresh, 0, location, 200);
+  ok1(Equals(v, fresh));
+
+  /* no new points */
+  ok1(!computer.LockedSyncTo(v, 0, location, 200, serial, range));
+  ok1(Equals(v, fresh));
+
+  /* new points are appended */
+  const unsigned old_size = v.size();
+  for (unsigned i = 50; i < 120; ++i)
+    Update(computer, MakeTime(i), MakeLocation(i));
+
+  ok1(!computer.LockedSyncTo(v, 0, location, 200, serial, range));
+  fresh.clear();
+  computer.LockedCopyTo(fresh, 0, location, 200);
+  ok1(v.size() > old_size && Equals(v, fresh));
+
+  /* a different range forces a full reload */
+  ok1(computer.LockedSyncTo(v, 0, location, 1000, serial, range));
+  fresh.clear();
+  computer.LockedCopyTo(fresh, 0, location, 1000);
+  ok1(Equals(v, fresh));
+
+  /* a small time warp erases points and modifies the trace, which
+     forces a full reload as well */
+  const Serial old_serial = serial;
+  Update(computer, MakeTime(100), MakeLocation(100));
+  ok1(computer.LockedSyncTo(v, 0, location, 1000, serial, range));
+  ok1(serial != old_serial);
+  fresh.clear();
+  computer.LockedCopyTo(fresh, 0, location, 1000);
+  ok1(Equals(v, fresh));
+}
 
 int main(int argc, char **argv)
 try {
-  if (argc < 3) {
-    unsigned n = 100;
-    if (argc > 1) {
-      n = atoi(argv[1]);
-    }
+  if (argc == 1) {
+    plan_tests(4 + 11);
+    TestSyncPoints();
+    TestLockedSyncTo();
+    return exit_status();
+  } else if (argc < 3) {
+    unsigned n = atoi(argv[1]);
     TestTrace(Path(_T("test/data/09kc3ov3.igc")), n);
   } else {
     assert(argc >= 3);
@@ -0,0 +1,133 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2016 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "FLARM/List.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static FlarmId
+MakeId(unsigned value)
+{
+  char buffer[16];
+  sprintf(buffer, "%06X", value);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+/**
+ * Verify that every target in the list can be found by its id.
+ */
+static bool
+CheckIndex(const TrafficList &list)
+{
+  for (const auto &traffic : list.list)
+    if (list.FindTraffic(traffic.id) != &traffic)
+      return false;
+
+  return true;
+}
+
+static void
+TestAllocate()
+{
+  TrafficList list;
+  list.Clear();
+  ok1(list.FindTraffic(MakeId(0xDDA5BA)) == nullptr);
+
+  FlarmTraffic *a = list.AllocateTraffic(MakeId(0xDDA5BA));
+  ok1(a != nullptr);
+  ok1(a->id == MakeId(0xDDA5BA));
+  ok1(!a->IsDefined());
+  ok1(!a->HasName());
+  ok1(list.FindTraffic(MakeId(0xDDA5BA)) == a);
+  ok1(list.FindTraffic(MakeId(0xDDA5BB)) == nullptr);
+
+  list.Clear();
+  ok1(list.FindTraffic(MakeId(0xDDA5BA)) == nullptr);
+}
+
+static void
+TestCapacity()
+{
+  TrafficList list;
+  list.Clear();
+
+  /* sequential ids, as typically allocated by ADS-B transponders
+     of one operator */
+  bool allocated = true;
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i) {
+    FlarmTraffic *traffic = list.AllocateTraffic(MakeId(0x400000 + i));
+    if (traffic == nullptr) {
+      allocated = false;
+      break;
+    }
+
+    traffic->valid.Update(i < TrafficList::MAX_COUNT / 2 ? 0 : 100);
+  }
+
+  ok1(allocated);
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(list.AllocateTraffic(MakeId(0x123456)) == nullptr);
+  ok1(CheckIndex(list));
+  ok1(list.FindTraffic(MakeId(0x123456)) == nullptr);
+
+  /* the first half expires; quick_remove() reorders the survivors */
+  list.Expire(101);
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT / 2);
+  ok1(CheckIndex(list));
+  ok1(list.FindTraffic(MakeId(0x400000)) == nullptr);
+  ok1(list.FindTraffic(MakeId(0x400000 + TrafficList::MAX_COUNT - 1)) !=
+      nullptr);
+
+  /* freed slots can be reused */
+  ok1(list.AllocateTraffic(MakeId(0x123456)) != nullptr);
+  ok1(CheckIndex(list));
+}
+
+static void
+TestCopy()
+{
+  TrafficList a;
+  a.Clear();
+  a.AllocateTraffic(MakeId(0x000001));
+  a.AllocateTraffic(MakeId(0x000201));
+
+  TrafficList b;
+  b.Clear();
+  b.Complement(a);
+  ok1(b.GetActiveTrafficCount() == 2);
+  ok1(CheckIndex(b));
+  ok1(b.FindTraffic(MakeId(0x000201)) == &b.list[1]);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(22);
+
+  TestAllocate();
+  TestCapacity();
+  TestCopy();
+
+  return exit_status();
+}